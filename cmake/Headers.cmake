@@ -115,6 +115,8 @@ macro(dune_probe_headers)
   dune_test_header(pthread.h)
   dune_test_header(signal.h)
   dune_test_header(stdint.h)
+  dune_test_header(sys/epoll.h)
+  dune_test_header(sys/eventfd.h)
   dune_test_header(sys/io.h)
   dune_test_header(sys/ioctl.h)
   dune_test_header(sys/procfs.h)
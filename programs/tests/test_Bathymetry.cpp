@@ -0,0 +1,121 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for Simulators::Environment bathymetry cache.               *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Time/Delay.hpp>
+#include <Simulators/Environment/Bathymetry.hpp>
+#include "Test.hpp"
+
+using Simulators::Environment::Bathymetry;
+using Simulators::Environment::QuadTree;
+
+//! Cache file used by the tests.
+static const char c_cache[] = "test_Bathymetry.bin";
+//! Source file used by the tests.
+static const char c_source[] = "test_Bathymetry.ini";
+
+//! Write a source file.
+static void
+touch(const char* path)
+{
+  std::ofstream ofs(path);
+  ofs << "[Bathymetry]" << std::endl;
+}
+
+int
+main(void)
+{
+  Test test("Simulators::Environment::Bathymetry");
+
+  std::vector<QuadTree::Item> items;
+  for (int i = 0; i <= 20; ++i)
+  {
+    for (int j = 0; j <= 20; ++j)
+    {
+      QuadTree::Item item;
+      item.x = i * 5.0;
+      item.y = j * 5.0;
+      item.value = 10.0 + 0.1 * item.x + 0.05 * item.y;
+      items.push_back(item);
+    }
+  }
+
+  std::remove(c_cache);
+  std::remove(c_source);
+
+  touch(c_source);
+  Bathymetry bathy(items, 0.7, -0.15, 2.0, 6.0);
+  test.boolean("missing cache", Bathymetry::loadCache(c_cache, c_source, 2.0, 6.0) == NULL);
+
+  bathy.save(c_cache);
+  Bathymetry* cached = Bathymetry::loadCache(c_cache, c_source, 2.0, 6.0);
+  test.boolean("cache is loaded", cached != NULL);
+
+  if (cached != NULL)
+  {
+    bool same = cached->getLatitude() == 0.7 && cached->getLongitude() == -0.15;
+    for (double n = 0; n <= 100; n += 3.7)
+    {
+      for (double e = 0; e <= 100; e += 4.1)
+      {
+        double a = bathy.depth(n, e, Bathymetry::INTERP_BICUBIC);
+        double b = cached->depth(n, e, Bathymetry::INTERP_BICUBIC);
+        same = same && ((std::isnan(a) && std::isnan(b)) || a == b);
+      }
+    }
+
+    test.boolean("round trip keeps the grid", same);
+    delete cached;
+  }
+
+  test.boolean("resolution change invalidates",
+               Bathymetry::loadCache(c_cache, c_source, 1.0, 6.0) == NULL);
+  test.boolean("radius change invalidates",
+               Bathymetry::loadCache(c_cache, c_source, 2.0, 8.0) == NULL);
+
+  cached = Bathymetry::loadCache(c_cache, "nonexistent.ini", 2.0, 6.0);
+  test.boolean("cache is used without source", cached != NULL);
+  delete cached;
+
+  DUNE::Time::Delay::wait(1.1);
+  touch(c_source);
+  test.boolean("newer source invalidates",
+               Bathymetry::loadCache(c_cache, c_source, 2.0, 6.0) == NULL);
+
+  std::remove(c_cache);
+  std::remove(c_source);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,86 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Compression parallel block compression.           *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Compression.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Compression;
+
+static bool
+roundTrip(Methods method, unsigned workers, const std::vector<char>& data)
+{
+  const char* fname = "test_Compression.tmp";
+
+  {
+    FileOutput os(fname, method, workers);
+    // Write in odd-sized pieces to cross block boundaries.
+    for (size_t i = 0; i < data.size(); i += 1021)
+    {
+      size_t len = (data.size() - i) < 1021 ? (data.size() - i) : 1021;
+      os.write(&data[i], len);
+    }
+  }
+
+  std::vector<char> result;
+  {
+    FileInput is(fname, method);
+    char bfr[4096];
+    while (is)
+    {
+      is.read(bfr, sizeof(bfr));
+      result.insert(result.end(), bfr, bfr + is.gcount());
+    }
+  }
+
+  std::remove(fname);
+  return result == data;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Compression::ParallelStreamBuffer");
+
+  std::vector<char> data;
+  for (unsigned i = 0; i < 1000000; ++i)
+    data.push_back((char)((i * 7) ^ (i >> 5)));
+
+  test.boolean("gzip, serial", roundTrip(METHOD_GZIP, 0, data));
+  test.boolean("gzip, 1 thread", roundTrip(METHOD_GZIP, 1, data));
+  test.boolean("gzip, 4 threads", roundTrip(METHOD_GZIP, 4, data));
+  test.boolean("bzip2, 3 threads", roundTrip(METHOD_BZIP2, 3, data));
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,215 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for Transports::DataStore storage file.                     *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// DUNE headers
+#include <Transports/DataStore/Storage.hpp>
+#include "Test.hpp"
+
+using Transports::DataStore::Storage;
+
+//! Storage file used by the tests.
+static const char c_file[] = "test_DataStoreStorage.bin";
+
+//! Append a record whose data is its priority as text.
+static bool
+add(Storage& st, int32_t priority, double timestamp)
+{
+  std::string data = DUNE::Utils::String::str("record-%d-%0.1f", priority, timestamp);
+  return st.add(priority, timestamp, 1, (const uint8_t*)data.c_str(), data.size());
+}
+
+//! Check if a record holds the data written by add().
+static bool
+check(Storage& st, Storage::const_iterator itr)
+{
+  std::string data = DUNE::Utils::String::str("record-%d-%0.1f", itr->priority, itr->timestamp);
+  return itr->length == data.size()
+  && std::memcmp(st.getData(itr), data.c_str(), data.size()) == 0;
+}
+
+//! Check if records are sorted by priority (highest first) and
+//! timestamp (newest first), with valid data.
+static bool
+checkAll(Storage& st)
+{
+  Storage::const_iterator prev = st.end();
+  for (Storage::const_iterator itr = st.begin(); itr != st.end(); ++itr)
+  {
+    if (!check(st, itr))
+      return false;
+
+    if (prev != st.end())
+    {
+      if (prev->priority < itr->priority)
+        return false;
+      if (prev->priority == itr->priority && prev->timestamp < itr->timestamp)
+        return false;
+    }
+
+    prev = itr;
+  }
+
+  return true;
+}
+
+//! Read a whole file.
+static std::vector<char>
+readFile(const char* file)
+{
+  std::vector<char> data;
+  std::FILE* fd = std::fopen(file, "rb");
+  char bfr[4096];
+  size_t rv;
+  while ((rv = std::fread(bfr, 1, sizeof(bfr), fd)) > 0)
+    data.insert(data.end(), bfr, bfr + rv);
+  std::fclose(fd);
+  return data;
+}
+
+//! Replace a file with the first bytes of its contents.
+static void
+truncateFile(const char* file, size_t size)
+{
+  std::vector<char> data = readFile(file);
+  std::FILE* fd = std::fopen(file, "wb");
+  std::fwrite(&data[0], 1, size, fd);
+  std::fclose(fd);
+}
+
+int
+main(void)
+{
+  Test test("Transports::DataStore::Storage");
+
+  {
+    std::remove(c_file);
+    Storage st;
+    test.boolean("create", st.open(c_file) == 0 && st.isOpen());
+    add(st, 1, 10.0);
+    add(st, 3, 11.0);
+    add(st, 1, 12.0);
+    add(st, 2, 13.0);
+    st.close();
+
+    test.boolean("reopen after append", st.open(c_file) == 4);
+    test.boolean("order and data", checkAll(st) && st.begin()->priority == 3);
+
+    Storage::const_iterator itr = st.begin();
+    ++itr;
+    st.remove(itr);
+    st.close();
+    test.boolean("removal survives reopen", st.open(c_file) == 3 && checkAll(st));
+  }
+
+  {
+    std::remove(c_file);
+    Storage st;
+    st.open(c_file);
+    add(st, 1, 1.0);
+    add(st, 1, 2.0);
+
+    // The newest record is the last one in the file.
+    uint64_t offset = st.begin()->offset;
+    uint64_t length = st.begin()->length;
+    st.close();
+
+    truncateFile(c_file, offset + Transports::DataStore::c_record_header_size + length / 2);
+    test.boolean("truncated tail record", st.open(c_file) == 1 && st.begin()->timestamp == 1.0);
+
+    add(st, 1, 3.0);
+    st.close();
+    test.boolean("append after truncation", st.open(c_file) == 2 && checkAll(st));
+  }
+
+  {
+    std::remove(c_file);
+    Storage st;
+    st.open(c_file);
+    for (unsigned i = 0; i < 2000; ++i)
+      add(st, i % 4, i);
+
+    Storage::const_iterator itr = st.begin();
+    while (itr != st.end())
+    {
+      if ((int)itr->timestamp % 2)
+        itr = st.remove(itr);
+      else
+        ++itr;
+    }
+
+    uint64_t live = st.getLiveBytes();
+    test.boolean("compaction", st.compact(true) && st.getDeadBytes() == 0);
+    test.boolean("compaction keeps records", st.size() == 1000 && st.getLiveBytes() == live && checkAll(st));
+    st.close();
+
+    test.boolean("reopen after compaction", st.open(c_file) == 1000 && checkAll(st));
+  }
+
+  {
+    std::remove(c_file);
+    Storage st;
+    st.open(c_file);
+
+    // Room for exactly four records of equal size.
+    std::string data = DUNE::Utils::String::str("record-%d-%0.1f", 1, 1.0);
+    st.setMaxSize(4 * (Transports::DataStore::c_record_header_size + data.size()));
+
+    add(st, 1, 1.0);
+    add(st, 2, 2.0);
+    add(st, 1, 3.0);
+    add(st, 2, 4.0);
+    test.boolean("fill", st.size() == 4);
+
+    // Lowest priority, oldest first.
+    add(st, 3, 5.0);
+    bool first = true;
+    for (Storage::const_iterator itr = st.begin(); itr != st.end(); ++itr)
+      first = first && itr->timestamp != 1.0;
+    test.boolean("evict lowest and oldest", st.size() == 4 && first);
+
+    add(st, 2, 6.0);
+    bool second = true;
+    for (Storage::const_iterator itr = st.begin(); itr != st.end(); ++itr)
+      second = second && itr->priority >= 2;
+    test.boolean("evict lowest priority next", st.size() == 4 && second);
+
+    test.boolean("reject lowest ranked", !add(st, 1, 7.0) && st.size() == 4);
+    test.boolean("keep newer equal priority", add(st, 2, 8.0) && (--st.end())->timestamp == 4.0);
+  }
+
+  std::remove(c_file);
+
+  return test.getReturnValue();
+}
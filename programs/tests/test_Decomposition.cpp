@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math Cholesky, LDLT and QR decompositions.        *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers
+#include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/Cholesky.hpp>
+#include <DUNE/Math/LDLT.hpp>
+#include <DUNE/Math/QR.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+static Matrix
+sample(size_t r, size_t c, double seed)
+{
+  Matrix m(r, c);
+  for (size_t i = 0; i < r; ++i)
+    for (size_t j = 0; j < c; ++j)
+      m(i, j) = std::sin(seed * (i + 1) * (j + 1) + 0.37 * j);
+  return m;
+}
+
+static bool
+near(const Matrix& a, const Matrix& b, double tol = 1e-9)
+{
+  if (a.rows() != b.rows() || a.columns() != b.columns())
+    return false;
+
+  return max(abs(a - b)) < tol;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math (Cholesky, LDLT, QR)");
+
+  Matrix g = sample(6, 6, 0.7);
+  Matrix spd = g * transpose(g) + Matrix(6) * 0.5;
+  Matrix b = sample(6, 3, 1.9);
+
+  {
+    Cholesky chol(spd);
+    test.boolean("cholesky of SPD matrix", chol.isValid());
+    test.boolean("cholesky factor", near(chol.getL() * transpose(chol.getL()), spd));
+    test.boolean("cholesky solve", near(spd * chol.solve(b), b));
+
+    Matrix x(b);
+    chol.solve(x, x);
+    test.boolean("cholesky solve in place", near(spd * x, b));
+
+    Matrix v = sample(6, 1, 2.7);
+    Matrix spd_v = spd + v * transpose(v);
+    chol.update(v);
+    test.boolean("cholesky rank-1 update", near(chol.getL() * transpose(chol.getL()), spd_v));
+
+    test.boolean("cholesky rank-1 downdate", chol.downdate(v));
+    test.boolean("cholesky after downdate", near(chol.getL() * transpose(chol.getL()), spd));
+
+    Matrix before = chol.getL();
+    test.boolean("cholesky downdate to indefinite",
+                 !chol.downdate(sample(6, 1, 0.2) * 100.0));
+    test.boolean("cholesky failed downdate is undone", near(chol.getL(), before, 1e-15));
+  }
+
+  {
+    Matrix indef(2, 2, 0.0);
+    indef(0, 0) = 1.0;
+    indef(1, 1) = -2.0;
+    Cholesky chol;
+    test.boolean("cholesky of indefinite matrix", !chol.compute(indef));
+
+    LDLT ldlt(indef);
+    test.boolean("ldlt of indefinite matrix", ldlt.isValid());
+    test.boolean("ldlt diagonal", ldlt.getD()(1) == -2.0);
+  }
+
+  {
+    LDLT ldlt(spd);
+    Matrix d(6, 6, 0.0);
+    for (int i = 0; i < 6; ++i)
+      d(i, i) = ldlt.getD()(i);
+    test.boolean("ldlt factors", near(ldlt.getL() * d * transpose(ldlt.getL()), spd));
+    test.boolean("ldlt solve", near(spd * ldlt.solve(b), b));
+  }
+
+  {
+    Matrix a = sample(6, 6, 0.45);
+    QR qr(a);
+    test.boolean("qr rank", qr.rank() == 6);
+    test.boolean("qr square solve", near(a * qr.solve(b), b));
+
+    // Least squares: residual must be orthogonal to the range of A.
+    Matrix t = sample(10, 4, 1.3);
+    Matrix y = sample(10, 1, 0.9);
+    qr.compute(t);
+    Matrix r = t * qr.solve(y) - y;
+    test.boolean("qr least squares", near(transpose(t) * r, Matrix(4, 1, 0.0)));
+    test.boolean("qr factor", near(transpose(qr.getR()) * qr.getR(), transpose(t) * t));
+
+    Matrix deficient = sample(5, 3, 0.8);
+    for (int i = 0; i < 5; ++i)
+      deficient(i, 2) = deficient(i, 0) + deficient(i, 1);
+    qr.compute(deficient);
+    test.boolean("qr rank deficient", qr.rank() == 2);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,143 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math FIR filter and filter bank.                 *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Math/FIRFilter.hpp>
+#include <DUNE/Math/FilterBank.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+//! Number of channels.
+static const unsigned c_channels = 5;
+
+static double
+input(unsigned channel, size_t k)
+{
+  return std::sin(0.1 * k * (channel + 1)) + 0.2 * channel;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math (FIRFilter, FilterBank)");
+
+  std::vector<double> w;
+  w.push_back(0.1);
+  w.push_back(0.2);
+  w.push_back(0.3);
+  w.push_back(0.4);
+
+  {
+    // Reference: y(k) = sum w(i) x(k - n + 1 + i).
+    FIRFilter<double> fir(w);
+    std::vector<double> x;
+    bool same = true;
+
+    for (size_t k = 0; k < 100; ++k)
+    {
+      x.push_back(input(0, k));
+      double y = fir.update(x.back());
+
+      double r = 0;
+      for (size_t i = 0; i < w.size(); ++i)
+      {
+        long idx = (long)k - (long)w.size() + 1 + (long)i;
+        if (idx >= 0)
+          r += w[i] * x[idx];
+      }
+
+      same = same && std::fabs(y - r) < 1e-12 && y == fir.get();
+    }
+
+    test.boolean("FIR output", same);
+
+    fir.clear();
+    test.boolean("FIR clear", fir.update(1.0) == w.back());
+  }
+
+  {
+    // FIR bank: numerator is the reversed FIR impulse response.
+    std::vector<double> b(w.rbegin(), w.rend());
+    std::vector<double> a(1, 1.0);
+    FilterBank<double> bank(b, a, c_channels);
+    std::vector<FIRFilter<double> > firs(c_channels, FIRFilter<double>(w));
+
+    bool same = true;
+    std::vector<double> in(c_channels), out;
+    for (size_t k = 0; k < 100; ++k)
+    {
+      for (unsigned j = 0; j < c_channels; ++j)
+        in[j] = input(j, k);
+
+      bank.update(in, out);
+
+      for (unsigned j = 0; j < c_channels; ++j)
+        same = same && std::fabs(out[j] - firs[j].update(in[j])) < 1e-12;
+    }
+
+    test.boolean("FIR bank matches FIR filters", same);
+  }
+
+  {
+    // First order low-pass: y(k) = 0.8 y(k - 1) + 0.2 x(k).
+    std::vector<double> b(1, 0.2);
+    std::vector<double> a;
+    a.push_back(1.0);
+    a.push_back(-0.8);
+    FilterBank<double> bank(b, a, c_channels);
+
+    std::vector<double> prev(c_channels, 0.0);
+    std::vector<double> in(c_channels);
+    bool same = true;
+    for (size_t k = 0; k < 100; ++k)
+    {
+      for (unsigned j = 0; j < c_channels; ++j)
+        in[j] = input(j, k);
+
+      const double* y = bank.update(&in[0]);
+
+      for (unsigned j = 0; j < c_channels; ++j)
+      {
+        double r = 0.8 * prev[j] + 0.2 * in[j];
+        same = same && std::fabs(y[j] - r) < 1e-12 && bank.get(j) == y[j];
+        prev[j] = r;
+      }
+    }
+
+    test.boolean("IIR bank", same);
+    test.boolean("IIR order", bank.getOrder() == 1 && bank.getChannels() == c_channels);
+  }
+
+  return test.getReturnValue();
+}
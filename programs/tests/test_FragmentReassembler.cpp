@@ -0,0 +1,144 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Network::FragmentReassembler class.               *
+//***************************************************************************
+
+// ISO C++ headers
+#include <vector>
+
+// DUNE headers
+#include <DUNE/IMC.hpp>
+#include <DUNE/Network/Fragments.hpp>
+#include <DUNE/Network/FragmentReassembler.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Create a message that needs several fragments.
+static IMC::PlanSpecification
+createPlan(const std::string& id)
+{
+  IMC::PlanSpecification plan;
+  plan.plan_id = id;
+  plan.description = std::string(1000, 'x');
+  plan.setSource(0x22);
+  return plan;
+}
+
+//! Add fragment 'n' of 'frags', as sent by system 0x22.
+static IMC::Message*
+add(Network::FragmentReassembler& ra, Network::Fragments& frags, int n, double now)
+{
+  IMC::MessagePart* part = frags.getFragment(n);
+  part->setSource(0x22);
+  return ra.add(part, now);
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Network::FragmentReassembler");
+
+  IMC::PlanSpecification plan = createPlan("plan");
+  Network::Fragments frags(&plan, 128);
+  int count = frags.getNumberOfFragments();
+  uint8_t uid = frags.getUid();
+  test.boolean("message is fragmented", count > 4);
+
+  {
+    Network::FragmentReassembler ra;
+    IMC::Message* msg = NULL;
+    for (int i = count - 1; i >= 0 && msg == NULL; --i)
+      msg = add(ra, frags, i, 0);
+
+    IMC::PlanSpecification* res = dynamic_cast<IMC::PlanSpecification*>(msg);
+    test.boolean("out of order reassembly", res != NULL && res->plan_id == "plan"
+                 && res->description == plan.description);
+    test.boolean("memory released", ra.size() == 0 && ra.getMemoryUsage() == 0);
+    delete msg;
+  }
+
+  {
+    Network::FragmentReassembler ra;
+    add(ra, frags, 0, 0);
+    add(ra, frags, 0, 1);
+    add(ra, frags, 2, 2);
+    test.boolean("duplicates counted", ra.getStatistics().duplicates == 1);
+    test.boolean("missing fragments", ra.getFragmentsMissing(0x22, uid) == count - 2);
+
+    std::vector<Network::FragmentReassembler::Nack> nacks;
+    ra.getNacks(5, 10, nacks);
+    test.boolean("no NACK before delay", nacks.empty());
+    ra.getNacks(12, 10, nacks);
+    test.boolean("NACK lists missing fragments", nacks.size() == 1
+                 && nacks[0].src == 0x22 && nacks[0].uid == uid
+                 && (int)nacks[0].missing.size() == count - 2
+                 && nacks[0].missing[0] == 1 && nacks[0].missing[1] == 3);
+    std::vector<Network::FragmentReassembler::Nack> again;
+    ra.getNacks(15, 10, again);
+    test.boolean("NACK not repeated before delay", again.empty());
+
+    IMC::MessagePart* part = Network::FragmentReassembler::createNack(nacks[0]);
+    Network::FragmentReassembler::Nack parsed;
+    test.boolean("NACK encoding", Network::FragmentReassembler::parseNack(part, parsed)
+                 && parsed.src == 0x22 && parsed.uid == uid
+                 && parsed.missing == nacks[0].missing);
+    test.boolean("NACK is not a fragment", ra.add(part, 16) == NULL
+                 && ra.getStatistics().invalid == 1);
+    test.boolean("fragments are not NACKs",
+                 !Network::FragmentReassembler::parseNack(frags.getFragment(0), parsed));
+    delete part;
+
+    IMC::Message* msg = NULL;
+    for (size_t i = 0; i < nacks[0].missing.size(); ++i)
+      msg = add(ra, frags, nacks[0].missing[i], 20);
+    test.boolean("selective repeat completes message", msg != NULL
+                 && ra.getStatistics().completed == 1);
+    delete msg;
+  }
+
+  {
+    Network::FragmentReassembler ra(600, 100);
+    IMC::PlanSpecification plan2 = createPlan("other");
+    Network::Fragments frags2(&plan2, 128);
+
+    for (int i = 0; i < 4; ++i)
+      add(ra, frags, i, 0);
+    for (int i = 0; i < 4; ++i)
+      add(ra, frags2, i, 1);
+    test.boolean("memory is bounded", ra.getMemoryUsage() <= 600);
+    test.boolean("oldest message evicted", ra.getStatistics().evicted == 1
+                 && ra.getFragmentsMissing(0x22, uid) == -1
+                 && ra.getFragmentsMissing(0x22, frags2.getUid()) > 0);
+
+    test.boolean("young messages kept", ra.expire(50) == 0 && ra.size() == 1);
+    test.boolean("old messages expired", ra.expire(200) == 1 && ra.size() == 0
+                 && ra.getMemoryUsage() == 0);
+  }
+
+  return test.getReturnValue();
+}
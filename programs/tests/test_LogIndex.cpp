@@ -0,0 +1,126 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::IMC::LogIndex class.                              *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// DUNE headers
+#include <DUNE/Compression.hpp>
+#include <DUNE/IMC.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Number of messages per log.
+static const unsigned c_count = 50000;
+
+//! Write a log with one message per 10 ms.
+static void
+writeLog(const char* file, Compression::Methods method)
+{
+  std::remove(IMC::LogIndex::getIndexPath(file).c_str());
+  std::remove(IMC::LogSegment::getIndexPath(file).c_str());
+
+  std::ostream* os = NULL;
+  if (method == Compression::METHOD_UNKNOWN)
+    os = new std::ofstream(file, std::ios::binary);
+  else
+    os = new Compression::FileOutput(file, method, 2);
+
+  Utils::ByteBuffer bfr;
+  IMC::Temperature msg;
+  for (unsigned i = 0; i < c_count; ++i)
+  {
+    msg.value = i;
+    msg.setTimeStamp(i * 0.01);
+    IMC::Packet::serialize(&msg, bfr);
+    os->write(bfr.getBufferSigned(), bfr.getSize());
+  }
+
+  delete os;
+}
+
+//! Seek to a given time and check the first message read.
+static bool
+seek(const char* file, Compression::Methods method, const IMC::LogIndex& index, double time)
+{
+  uint64_t offset = index.find(time);
+  std::istream* is = NULL;
+  if (method == Compression::METHOD_UNKNOWN)
+  {
+    std::ifstream* ifs = new std::ifstream(file, std::ios::binary);
+    ifs->seekg(offset);
+    is = ifs;
+  }
+  else
+  {
+    is = new Compression::FileInput(file, method, offset);
+  }
+
+  IMC::Message* msg = IMC::Packet::deserialize(*is);
+  bool rv = msg != NULL && msg->getTimeStamp() <= time && msg->getTimeStamp() > time - 100.0;
+  delete msg;
+  delete is;
+  return rv;
+}
+
+static void
+testLog(Test& test, const char* file, Compression::Methods method)
+{
+  writeLog(file, method);
+
+  IMC::LogIndex index;
+  index.open(file, 1.0);
+  std::string name(file);
+  test.boolean((name + ": index has entries").c_str(), index.getEntries().size() > 1);
+  test.boolean((name + ": seek to start").c_str(), seek(file, method, index, 0.0));
+  test.boolean((name + ": seek to middle").c_str(), seek(file, method, index, c_count * 0.005));
+  test.boolean((name + ": seek to end").c_str(), seek(file, method, index, (c_count - 1) * 0.01));
+
+  IMC::LogIndex cached;
+  test.boolean((name + ": cached index loaded").c_str(), cached.load(file));
+  test.boolean((name + ": cached index matches").c_str(), cached.getEntries().size() == index.getEntries().size());
+
+  std::remove(file);
+  std::remove(IMC::LogIndex::getIndexPath(file).c_str());
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::LogIndex");
+
+  testLog(test, "test_LogIndex.lsf", Compression::METHOD_UNKNOWN);
+  testLog(test, "test_LogIndex.lsf.gz", Compression::METHOD_GZIP);
+  testLog(test, "test_LogIndex.lsf.bz2", Compression::METHOD_BZIP2);
+
+  return test.getReturnValue();
+}
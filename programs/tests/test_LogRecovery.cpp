@@ -0,0 +1,172 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::IMC::LogRecovery class.                           *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Compression.hpp>
+#include <DUNE/FileSystem.hpp>
+#include <DUNE/IMC.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+
+static const char* c_lsf = "test_LogRecovery.lsf.gz";
+static const char* c_damaged = "test_LogRecovery.damaged.lsf.gz";
+static const char* c_recovered = "test_LogRecovery.recovered.lsf.gz";
+
+//! Write a segmented log with 'segments' indexed segments plus an
+//! unindexed tail of 'tail' messages.
+static void
+writeLog(unsigned segments, unsigned per_segment, unsigned tail)
+{
+  std::string index = IMC::LogSegment::getIndexPath(c_lsf);
+  std::remove(index.c_str());
+
+  Compression::FileOutput os(c_lsf, Compression::METHOD_GZIP);
+  IMC::LogSegment segment;
+  Utils::ByteBuffer bfr;
+  IMC::Temperature msg;
+
+  for (unsigned i = 0; i < segments * per_segment + tail; ++i)
+  {
+    msg.value = i;
+    msg.setTimeStamp(i);
+    IMC::Packet::serialize(&msg, bfr);
+    os.write(bfr.getBufferSigned(), bfr.getSize());
+    segment.update(bfr.getBuffer(), bfr.getSize());
+
+    if (i < segments * per_segment && (i + 1) % per_segment == 0)
+    {
+      os.flush();
+      uint64_t end = FileSystem::Path(c_lsf).size();
+      segment.size = end - segment.offset;
+      IMC::LogSegment::append(index, segment);
+      segment.offset = end;
+      segment.clear();
+    }
+  }
+}
+
+//! Copy a file dropping its last bytes.
+static void
+truncateCopy(const char* src, const char* dst, unsigned drop)
+{
+  std::ifstream ifs(src, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  data.resize(data.size() - drop);
+  std::ofstream ofs(dst, std::ios::binary);
+  ofs.write(&data[0], data.size());
+
+  std::string src_index = IMC::LogSegment::getIndexPath(src);
+  std::string dst_index = IMC::LogSegment::getIndexPath(dst);
+  std::ifstream iifs(src_index.c_str(), std::ios::binary);
+  std::ofstream iofs(dst_index.c_str(), std::ios::binary);
+  iofs << iifs.rdbuf();
+}
+
+//! Count messages of a log, stopping at the first error.
+static unsigned
+countMessages(const char* file, bool& ok)
+{
+  Compression::FileInput is(file, Compression::METHOD_GZIP);
+  unsigned count = 0;
+  ok = true;
+
+  try
+  {
+    IMC::Message* msg = NULL;
+    while ((msg = IMC::Packet::deserialize(is)) != NULL)
+    {
+      if (msg->getTimeStamp() != count)
+        ok = false;
+
+      delete msg;
+      ++count;
+    }
+  }
+  catch (std::exception&)
+  {
+    ok = false;
+  }
+
+  return count;
+}
+
+static void
+cleanup(const char* file)
+{
+  std::remove(file);
+  std::remove(IMC::LogSegment::getIndexPath(file).c_str());
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::LogRecovery");
+
+  writeLog(4, 100, 1000);
+
+  std::vector<IMC::LogSegment> segments;
+  IMC::LogSegment::load(IMC::LogSegment::getIndexPath(c_lsf), segments);
+  test.boolean("index has 4 segments", segments.size() == 4);
+  test.boolean("segment time range", segments.size() == 4 && segments[1].begin == 100 && segments[1].end == 199);
+
+  // Damage the compressed tail.
+  truncateCopy(c_lsf, c_damaged, 100);
+
+  bool ok = false;
+  countMessages(c_damaged, ok);
+  test.boolean("damaged log fails to read", !ok);
+
+  IMC::LogRecovery::Result result = IMC::LogRecovery::recover(c_damaged, c_recovered);
+  test.boolean("indexed segments kept", result.segments == 4);
+  test.boolean("tail messages salvaged", result.salvaged > 0 && result.salvaged < 1000);
+
+  unsigned count = countMessages(c_recovered, ok);
+  test.boolean("recovered log is readable", ok);
+  test.boolean("recovered message count", count == 400 + result.salvaged);
+
+  IMC::LogSegment::load(IMC::LogSegment::getIndexPath(c_recovered), segments);
+  test.boolean("recovered index", segments.size() == 5);
+
+  // Recover an intact log.
+  result = IMC::LogRecovery::recover(c_lsf, c_recovered);
+  test.boolean("intact log fully recovered", result.salvaged == 1000 && result.discarded == 0);
+
+  cleanup(c_lsf);
+  cleanup(c_damaged);
+  cleanup(c_recovered);
+
+  return test.getReturnValue();
+}
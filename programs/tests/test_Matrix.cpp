@@ -0,0 +1,139 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math::Matrix in-place products.                   *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers
+#include <DUNE/Math/Matrix.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+static Matrix
+sample(size_t r, size_t c, double seed)
+{
+  Matrix m(r, c);
+  for (size_t i = 0; i < r; ++i)
+    for (size_t j = 0; j < c; ++j)
+      m(i, j) = std::sin(seed * (i + 1) + 0.37 * j);
+  return m;
+}
+
+static bool
+near(const Matrix& a, const Matrix& b)
+{
+  if (a.rows() != b.rows() || a.columns() != b.columns())
+    return false;
+
+  return max(abs(a - b)) < 1e-9;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::Matrix (gemm)");
+
+  Matrix a = sample(7, 5, 0.3);
+  Matrix b = sample(5, 9, 1.1);
+  Matrix bt = transpose(b);
+  Matrix at = transpose(a);
+  Matrix c = sample(7, 9, 2.3);
+
+  {
+    Matrix d;
+    gemm(1.0, a, Matrix::OP_NONE, b, Matrix::OP_NONE, 0.0, d);
+    test.boolean("plain product", near(d, a * b));
+
+    gemm(1.0, a, Matrix::OP_NONE, bt, Matrix::OP_TRANSPOSE, 0.0, d);
+    test.boolean("right operand transposed", near(d, a * b));
+
+    gemm(1.0, at, Matrix::OP_TRANSPOSE, b, Matrix::OP_NONE, 0.0, d);
+    test.boolean("left operand transposed", near(d, a * b));
+
+    gemm(1.0, at, Matrix::OP_TRANSPOSE, bt, Matrix::OP_TRANSPOSE, 0.0, d);
+    test.boolean("both operands transposed", near(d, a * b));
+
+    const double* storage = d.cbegin();
+    gemm(1.0, a, Matrix::OP_NONE, b, Matrix::OP_NONE, 0.0, d);
+    test.boolean("destination storage is reused", d.cbegin() == storage);
+  }
+
+  {
+    Matrix d;
+    d.assign(c);
+    gemm(-2.0, a, Matrix::OP_NONE, b, Matrix::OP_NONE, 0.5, d);
+    test.boolean("scaled accumulation", near(d, 0.5 * c - 2.0 * (a * b)));
+    test.boolean("assign does not share data", near(c, sample(7, 9, 2.3)));
+
+    Matrix e = c;
+    axpy(3.0, c, e);
+    test.boolean("axpy", near(e, 4.0 * c));
+    test.boolean("axpy splits shared data", near(c, sample(7, 9, 2.3)));
+  }
+
+  {
+    Matrix s = sample(6, 6, 0.7);
+    Matrix ref = s * s;
+    gemm(1.0, s, Matrix::OP_NONE, s, Matrix::OP_NONE, 0.0, s);
+    test.boolean("aliased destination", near(s, ref));
+
+    Matrix big_a = sample(130, 70, 0.11);
+    Matrix big_b = sample(70, 300, 0.05);
+    Matrix big;
+    gemm(1.0, big_a, Matrix::OP_NONE, big_b, Matrix::OP_NONE, 0.0, big);
+
+    double err = 0.0;
+    for (int i = 0; i < 130; i += 7)
+    {
+      for (int j = 0; j < 300; j += 11)
+      {
+        double v = 0.0;
+        for (int k = 0; k < 70; ++k)
+          v += big_a(i, k) * big_b(k, j);
+        err = std::max(err, std::fabs(v - big(i, j)));
+      }
+    }
+    test.boolean("blocked product", err < 1e-9);
+
+    bool thrown = false;
+    try
+    {
+      Matrix d(2, 2, 0.0);
+      gemm(1.0, a, Matrix::OP_NONE, b, Matrix::OP_NONE, 1.0, d);
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("accumulating into wrong size throws", thrown);
+  }
+
+  return test.getReturnValue();
+}
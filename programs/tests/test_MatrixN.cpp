@@ -0,0 +1,130 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math::MatrixN class.                              *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers
+#include <DUNE/Math/MatrixN.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+template <size_t R, size_t C>
+static bool
+near(const MatrixN<R, C>& a, const Matrix& b)
+{
+  if ((size_t)b.rows() != R || (size_t)b.columns() != C)
+    return false;
+
+  for (size_t i = 0; i < R * C; ++i)
+  {
+    if (std::fabs(a(i) - b.element(i / C, i % C)) > 1e-9)
+      return false;
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::MatrixN");
+
+  double da[12] = {1, 2, 3, 4, -1, 0.5, 2, 7, 3, 1, -2, 5};
+  double db[12] = {0.5, -1, 2, 3, 1, 4, -2, 1, 0.25, 6, 1, -3};
+  double dc[9] = {4, -2, 1, 3, 6, -4, 2, 1, 8};
+
+  {
+    MatrixN<3, 4> a(da);
+    MatrixN<4, 3> b(db);
+    Matrix ma(da, 3, 4);
+    Matrix mb(db, 4, 3);
+
+    test.boolean("zero initialized", MatrixN<2, 2>() == MatrixN<2, 2>(0.0));
+    test.boolean("product matches Matrix", near(a * b, ma * mb));
+    test.boolean("transpose matches Matrix", near(transpose(a), transpose(ma)));
+    test.boolean("sum matches Matrix", near(a + a * 2.0, ma + ma * 2.0));
+    test.boolean("round trip through Matrix", MatrixN<3, 4>(a.toMatrix()) == a);
+  }
+
+  {
+    Matrix3 c(dc);
+    test.boolean("inverse matches Matrix", near(inverse(c), inverse(Matrix(dc, 3, 3))));
+    test.boolean("inverse times matrix is identity",
+                 norm(inverse(c) * c - Matrix3::identity()) < 1e-12);
+
+    bool thrown = false;
+    try
+    {
+      inverse(Matrix3());
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("singular inverse throws", thrown);
+
+    thrown = false;
+    try
+    {
+      Matrix3 bad(Matrix(2, 3, 0.0));
+    }
+    catch (Matrix::Error&)
+    {
+      thrown = true;
+    }
+    test.boolean("dimension mismatch throws", thrown);
+  }
+
+  {
+    double dv[3] = {1, 2, 3};
+    double dw[3] = {-2, 0.5, 4};
+    Vector3 v(dv);
+    Vector3 w(dw);
+
+    test.boolean("cross product matches skew", norm(cross(v, w) - skew(v) * w) < 1e-12);
+    test.boolean("dot product", dot(v, w) == 11.0);
+
+    Matrix3 r = rotationZyx(0.3, -0.2, 1.1);
+    test.boolean("rotation is orthonormal",
+                 norm(r * transpose(r) - Matrix3::identity()) < 1e-12);
+
+    double h = 0.5 * 1.1;
+    double dq[4] = {std::cos(h), 0, 0, std::sin(h)};
+    test.boolean("quaternion yaw matches Euler yaw",
+                 norm(rotationQuaternion(MatrixN<4, 1>(dq)) - rotationZyx(0, 0, 1.1)) < 1e-12);
+
+    MatrixN<6, 6> m;
+    m.set(3, 3, Matrix3::identity());
+    test.boolean("block set and get", m.get<3, 3>(3, 3) == Matrix3::identity());
+  }
+
+  return test.getReturnValue();
+}
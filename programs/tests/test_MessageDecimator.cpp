@@ -0,0 +1,138 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Tasks::MessageDecimator class.                    *
+//***************************************************************************
+
+// ISO C++ headers
+#include <string>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/IMC.hpp>
+#include <DUNE/Tasks/MessageDecimator.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Feed a temperature sample, returning true if it passed.
+static bool
+feed(Tasks::MessageDecimator& dec, double time, double value, unsigned eid = 1)
+{
+  IMC::Temperature msg;
+  msg.setSourceEntity(eid);
+  msg.value = value;
+  return !dec.filter(&msg, time);
+}
+
+//! Servo position with a sub identification number wider than the
+//! IMC field, to exercise the full 16-bit range.
+class WideServoPosition: public IMC::ServoPosition
+{
+public:
+  uint16_t sub_id;
+
+  uint16_t
+  getSubId(void) const
+  {
+    return sub_id;
+  }
+};
+
+int
+main(void)
+{
+  Test test("DUNE::Tasks::MessageDecimator");
+
+  std::vector<std::string> spec;
+  spec.push_back("Temperature:Rate:1.0");
+  Tasks::MessageDecimator dec;
+  dec.setup(spec);
+
+  unsigned passed = 0;
+  for (unsigned i = 0; i < 100; ++i)
+    passed += feed(dec, i * 0.1, i) ? 1 : 0;
+  test.boolean("rate limiting", passed == 10);
+
+  IMC::Depth depth;
+  test.boolean("unmatched messages pass", !dec.matches(&depth) && !dec.filter(&depth, 0));
+
+  spec[0] = "ServoPosition:Rate:1.0";
+  dec.setup(spec);
+  WideServoPosition servo;
+  servo.sub_id = 1;
+  bool first = !dec.filter(&servo, 0);
+  servo.sub_id = 257;
+  test.boolean("sub-ids 256 apart are distinct streams", first && !dec.filter(&servo, 0.1));
+  test.boolean("sub-id stream rate limited", dec.filter(&servo, 0.2));
+
+  spec[0] = "Temperature:Mean:1.0";
+  dec.setup(spec);
+  IMC::Temperature stale;
+  stale.setTimeStamp(0);
+  dec.filter(&stale, 100.0);
+  test.boolean("window uses reception time", dec.pop(100.5) == NULL);
+  IMC::Message* aggregate = dec.pop(101.0);
+  test.boolean("window closes after period", aggregate != NULL);
+  delete aggregate;
+
+  spec[0] = "Temperature:Deadband:0:0.5";
+  dec.setup(spec);
+  test.boolean("deadband: first passes", feed(dec, 0, 10.0));
+  test.boolean("deadband: small change dropped", !feed(dec, 1, 10.4));
+  test.boolean("deadband: large change passes", feed(dec, 2, 10.6));
+  test.boolean("deadband: relative to last passed", !feed(dec, 3, 10.2));
+
+  spec[0] = "Temperature:Mean:1.0";
+  dec.setup(spec);
+  bool dropped = true;
+  for (unsigned i = 0; i < 10; ++i)
+    dropped = dropped && !feed(dec, i * 0.1, i);
+  test.boolean("mean: samples dropped", dropped);
+  test.boolean("mean: window still open", dec.pop(0.95) == NULL);
+
+  IMC::Message* msg = dec.pop(1.0);
+  test.boolean("mean: aggregate", msg != NULL && msg->getValueFP() == 4.5);
+  delete msg;
+
+  spec[0] = "Temperature:Maximum:1.0";
+  dec.setup(spec);
+  for (unsigned i = 0; i < 25; ++i)
+    feed(dec, i * 0.1, i % 10);
+  msg = dec.pop(2.4);
+  bool ok = msg != NULL && msg->getValueFP() == 9;
+  delete msg;
+  msg = dec.pop(2.4);
+  ok = ok && msg != NULL && msg->getValueFP() == 9;
+  delete msg;
+  test.boolean("maximum: completed windows", ok && dec.pop(2.4) == NULL);
+
+  msg = dec.pop(3.0);
+  test.boolean("maximum: partial window", msg != NULL && msg->getValueFP() == 4);
+  delete msg;
+
+  return test.getReturnValue();
+}
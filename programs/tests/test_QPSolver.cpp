@@ -0,0 +1,139 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math::QPSolver.                                   *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers
+#include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/QPSolver.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+//! Number of actuators.
+static const int c_vars = 4;
+//! Actuator limit.
+static const double c_limit = 1.0;
+
+//! Build a control allocation problem:
+//!   min |B x - tau|^2 + 0.01 |x|^2 subject to |x(i)| <= c_limit.
+static void
+build(const Matrix& B, const Matrix& tau, Matrix& H, Matrix& f, Matrix& A, Matrix& b)
+{
+  H = transpose(B) * B * 2.0 + Matrix(c_vars) * 0.02;
+  f = transpose(B) * tau * -2.0;
+
+  A = Matrix(2 * c_vars, c_vars, 0.0);
+  b = Matrix(2 * c_vars, 1, c_limit);
+  for (int i = 0; i < c_vars; ++i)
+  {
+    A(i, i) = 1.0;
+    A(c_vars + i, i) = -1.0;
+  }
+}
+
+static bool
+near(const Matrix& a, const Matrix& b)
+{
+  return max(abs(a - b)) < 1e-8;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::QPSolver");
+
+  double bd[] = {1.0, 1.0, 0.0, 0.0,
+                 0.0, 0.0, 1.0, 1.0,
+                 0.5, -0.5, 0.5, -0.5};
+  Matrix B(bd, 3, c_vars);
+  Matrix H, f, A, b;
+
+  {
+    double td[] = {0.5, -0.3, 0.1};
+    Matrix tau(td, 3, 1);
+    build(B, tau, H, f, A, b);
+
+    Matrix x;
+    QPSolver::solve(H, f, A, b, x);
+    test.boolean("unconstrained optimum", near(H * x + f, Matrix(c_vars, 1, 0.0)));
+  }
+
+  {
+    QPSolver qp(c_vars, 0, 2 * c_vars);
+    Matrix x_warm;
+    Matrix x_cold;
+    bool same = true;
+    bool feasible = true;
+    unsigned warm = 0;
+    unsigned cold = 0;
+
+    for (int k = 0; k < 200; ++k)
+    {
+      double td[] = {3.0 * std::sin(0.05 * k), 2.5 * std::cos(0.03 * k), 1.5 * std::sin(0.07 * k)};
+      Matrix tau(td, 3, 1);
+      build(B, tau, H, f, A, b);
+
+      double v_warm = qp.minimize(H, f, A, b, x_warm);
+      warm += qp.getIterations();
+
+      QPSolver cold_qp;
+      double v_cold = cold_qp.minimize(H, f, A, b, x_cold);
+      cold += cold_qp.getIterations();
+
+      same = same && qp.hasConverged() && near(x_warm, x_cold) && std::fabs(v_warm - v_cold) < 1e-8;
+      for (int i = 0; i < c_vars; ++i)
+        feasible = feasible && std::fabs(x_warm(i)) <= c_limit + 1e-9;
+    }
+
+    test.boolean("warm start matches cold start", same);
+    test.boolean("warm start solutions are feasible", feasible);
+    test.boolean("warm start uses fewer iterations", warm < cold);
+  }
+
+  {
+    double td[] = {10.0, -10.0, 10.0};
+    Matrix tau(td, 3, 1);
+    build(B, tau, H, f, A, b);
+
+    QPSolver qp;
+    Matrix x;
+    qp.minimize(H, f, A, b, x);
+    test.boolean("saturated problem converges", qp.hasConverged());
+    test.boolean("saturated problem has active constraints", qp.getActiveCount() > 0);
+
+    qp.reset();
+    qp.setMaximumIterations(1);
+    qp.minimize(H, f, A, b, x);
+    test.boolean("iteration limit", !qp.hasConverged() && qp.getIterations() == 1);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,184 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for Simulators::Environment quadtree.                       *
+//***************************************************************************
+
+// ISO C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers
+#include <Simulators/Environment/QuadTree.hpp>
+#include "Test.hpp"
+
+using Simulators::Environment::Bounds;
+using Simulators::Environment::Point;
+using Simulators::Environment::QuadTree;
+
+//! Collect the values of iterated items.
+class Collector: public QuadTree::Iteration
+{
+public:
+  std::vector<double> values;
+
+  void
+  process(const QuadTree::Item& item)
+  {
+    values.push_back(item.value);
+  }
+};
+
+//! Random number in [0, max[.
+static double
+uniform(double max)
+{
+  return max * std::rand() / ((double)RAND_MAX + 1.0);
+}
+
+//! Distance from an item to a point.
+static double
+distance(const QuadTree::Item& item, const Point& p)
+{
+  return std::sqrt((item.x - p.x) * (item.x - p.x) + (item.y - p.y) * (item.y - p.y));
+}
+
+//! Check k nearest neighbours against brute force.
+static bool
+checkNearest(const QuadTree& tree, const std::vector<QuadTree::Item>& items,
+             const Point& p, size_t k)
+{
+  std::vector<double> expected;
+  for (size_t i = 0; i < items.size(); ++i)
+    expected.push_back(distance(items[i], p));
+  std::sort(expected.begin(), expected.end());
+  expected.resize(std::min(k, expected.size()));
+
+  std::vector<QuadTree::Item> found(k);
+  std::vector<double> distances(k);
+  size_t n = tree.nearest(p, k, &found[0], &distances[0]);
+  if (n != expected.size())
+    return false;
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (std::fabs(distances[i] - expected[i]) > 1e-9
+        || std::fabs(distance(found[i], p) - expected[i]) > 1e-9)
+      return false;
+  }
+
+  return true;
+}
+
+//! Check a radius query against brute force.
+static bool
+checkRadius(const QuadTree& tree, const std::vector<QuadTree::Item>& items,
+            const Point& p, double radius)
+{
+  std::vector<double> expected;
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    if (distance(items[i], p) <= radius)
+      expected.push_back(items[i].value);
+  }
+
+  Collector c;
+  tree.iterate(c, p, radius);
+
+  std::sort(expected.begin(), expected.end());
+  std::sort(c.values.begin(), c.values.end());
+  return c.values == expected;
+}
+
+int
+main(void)
+{
+  Test test("Simulators::Environment::QuadTree");
+
+  std::srand(1);
+  Bounds bounds(Point(500, 500), 500);
+
+  std::vector<QuadTree::Item> items;
+  for (unsigned i = 0; i < 5000; ++i)
+  {
+    QuadTree::Item item;
+    item.x = uniform(1000);
+    item.y = uniform(1000);
+    item.value = i;
+    items.push_back(item);
+  }
+
+  QuadTree bulk(bounds, items);
+  QuadTree incremental(bounds);
+  for (size_t i = 0; i < items.size(); ++i)
+    incremental.insert(items[i]);
+
+  test.boolean("all items loaded", bulk.size() == items.size() && incremental.size() == items.size());
+
+  std::vector<Point> queries;
+  for (unsigned i = 0; i < 50; ++i)
+    queries.push_back(Point(uniform(1000), uniform(1000)));
+  queries.push_back(Point(0, 0));
+  queries.push_back(Point(-100, 1200));
+
+  bool knn = true;
+  bool radius = true;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    knn = knn && checkNearest(bulk, items, queries[i], 1);
+    knn = knn && checkNearest(bulk, items, queries[i], 16);
+    radius = radius && checkRadius(bulk, items, queries[i], 0.0);
+    radius = radius && checkRadius(bulk, items, queries[i], 25.0);
+    radius = radius && checkRadius(bulk, items, queries[i], 150.0);
+  }
+
+  test.boolean("k nearest match brute force", knn);
+  test.boolean("radius search matches brute force", radius);
+
+  std::vector<QuadTree::Item> few(items.begin(), items.begin() + 3);
+  QuadTree small(bounds, few);
+  test.boolean("k larger than the tree", checkNearest(small, few, Point(500, 500), 8));
+
+  bool same = true;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    same = same && checkNearest(incremental, items, queries[i], 16);
+    same = same && checkRadius(incremental, items, queries[i], 60.0);
+  }
+
+  std::vector<QuadTree::Item> a;
+  std::vector<QuadTree::Item> b;
+  Bounds area(Point(300, 700), 120);
+  bulk.search(area, a);
+  incremental.search(area, b);
+  same = same && a.size() == b.size() && a.size() == bulk.size(area);
+
+  test.boolean("bulk load matches incremental insert", same);
+
+  return test.getReturnValue();
+}
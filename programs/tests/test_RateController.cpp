@@ -0,0 +1,123 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Network::RateController class.                    *
+//***************************************************************************
+
+// DUNE headers
+#include <DUNE/Network/RateController.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+
+int
+main(void)
+{
+  Test test("DUNE::Network::RateController");
+
+  {
+    Network::RateController rc(1.0);
+    test.boolean("starts at full rate", rc.getScale() == 1.0);
+    test.boolean("first update only starts the period", !rc.update(0.0));
+
+    rc.outcome(10, 0);
+    test.boolean("no change before period", !rc.update(0.5));
+    test.boolean("no change on a healthy link", !rc.update(1.0));
+    test.boolean("still at full rate", rc.getScale() == 1.0);
+  }
+
+  {
+    Network::RateController rc(1.0);
+    rc.setMinimumScale(0.2);
+    rc.update(0.0);
+
+    double t = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+      rc.outcome(5, 5);
+      rc.update(t += 1.0);
+    }
+
+    test.boolean("loss reduces the rate", rc.getScale() < 1.0);
+    test.boolean("rate is bounded by the minimum", rc.getScale() == 0.2);
+    test.boolean("loss is estimated", rc.getLoss() > 0.4 && rc.getLoss() <= 0.5);
+
+    for (int i = 0; i < 40; ++i)
+    {
+      rc.outcome(10, 0);
+      rc.update(t += 1.0);
+    }
+
+    test.boolean("rate recovers when loss stops", rc.getScale() == 1.0);
+  }
+
+  {
+    Network::RateController rc(1.0);
+    rc.update(0.0);
+    rc.setQuality(5, 10, 30);
+    test.boolean("quality from low margin", rc.getQuality() == 0.0);
+    test.boolean("weak signal reduces the rate", rc.update(1.0) && rc.getScale() == 0.5);
+
+    rc.setQuality(20, 10, 30);
+    test.boolean("quality from margin", rc.getQuality() == 0.5);
+    rc.update(2.0);
+    test.boolean("fair signal increases the rate", rc.getScale() > 0.5);
+
+    rc.reset();
+    test.boolean("reset restores full rate", rc.getScale() == 1.0 && rc.getQuality() == 1.0);
+  }
+
+  {
+    Network::RateController rc(1.0);
+    rc.update(0.0);
+    for (int i = 1; i <= 20; ++i)
+    {
+      rc.sent(1000);
+      rc.update(i);
+    }
+
+    test.boolean("goodput converges to sent rate", rc.getGoodput() > 990 && rc.getGoodput() <= 1000);
+  }
+
+  {
+    Network::RateController rc(1.0);
+    rc.update(0.0);
+    double t = 0;
+    while (rc.getScale() == 1.0 && t < 10)
+    {
+      rc.sent(1000);
+      rc.outcome(7, 3);
+      rc.update(t += 1.0);
+    }
+
+    double delivered = 1.0 - rc.getLoss();
+    test.boolean("loss cuts the rate to the goodput share",
+                 rc.getScale() > 0.5 && rc.getScale() < 1.0
+                 && rc.getScale() > delivered - 0.1 && rc.getScale() < delivered + 0.1);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,119 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for Transports::Logging ring buffer.                        *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstring>
+
+// DUNE headers
+#include <DUNE/Utils/ByteBuffer.hpp>
+#include <Transports/Logging/RingBuffer.hpp>
+#include "Test.hpp"
+
+using Transports::Logging::RingBuffer;
+
+//! Store a packet of the given size filled with a byte value.
+static void
+push(RingBuffer& ring, double time, char value, size_t size)
+{
+  char data[128];
+  std::memset(data, value, size);
+  ring.push(time, data, size);
+}
+
+//! Retrieve the oldest packet and check its contents.
+static bool
+pop(RingBuffer& ring, char value, size_t size)
+{
+  DUNE::Utils::ByteBuffer bfr;
+  if (!ring.pop(bfr) || bfr.getSize() != size)
+    return false;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (bfr.getBufferSigned()[i] != value)
+      return false;
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Transports::Logging::RingBuffer");
+
+  {
+    RingBuffer ring(100, 60);
+    push(ring, 0, 'a', 10);
+    push(ring, 1, 'b', 20);
+    push(ring, 2, 'c', 30);
+    test.boolean("stored packets", ring.size() == 3 && ring.used() == 60);
+    bool ok = pop(ring, 'a', 10) && pop(ring, 'b', 20) && pop(ring, 'c', 30);
+    test.boolean("drain order is oldest first", ok && ring.size() == 0 && ring.used() == 0);
+    DUNE::Utils::ByteBuffer bfr;
+    test.boolean("pop on empty ring", !ring.pop(bfr));
+  }
+
+  {
+    RingBuffer ring(100, 60);
+    push(ring, 0, 'a', 40);
+    push(ring, 1, 'b', 40);
+    push(ring, 2, 'c', 40);
+    test.boolean("overwrite oldest when full", ring.size() == 2 && ring.used() == 80);
+    test.boolean("wrapped packet is intact", pop(ring, 'b', 40) && pop(ring, 'c', 40));
+  }
+
+  {
+    RingBuffer ring(100, 60);
+    for (unsigned i = 0; i < 20; ++i)
+      push(ring, i, 'a' + i, 30);
+    bool ok = ring.size() == 3;
+    for (unsigned i = 17; i < 20; ++i)
+      ok = ok && pop(ring, 'a' + i, 30);
+    test.boolean("repeated wrap-around", ok);
+  }
+
+  {
+    RingBuffer ring(100, 60);
+    push(ring, 0, 'a', 101);
+    test.boolean("packet larger than capacity is dropped", ring.size() == 0);
+  }
+
+  {
+    RingBuffer ring(1000, 5);
+    push(ring, 0, 'a', 10);
+    push(ring, 3, 'b', 10);
+    push(ring, 7, 'c', 10);
+    test.boolean("old packets expire", ring.size() == 2 && pop(ring, 'b', 10));
+    ring.expire(20);
+    test.boolean("expire without push", ring.size() == 0);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,132 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Math sliding-window statistics.                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Math/SlidingWindow.hpp>
+#include <DUNE/Math/MovingAverage.hpp>
+#include <DUNE/Math/MultiMovingAverage.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+//! Reference statistics computed from scratch.
+struct Reference
+{
+  double mean;
+  double stdev;
+  double min;
+  double max;
+};
+
+static Reference
+reference(const std::vector<double>& s, size_t end, size_t window)
+{
+  size_t begin = end > window ? end - window : 0;
+  Reference r;
+  r.mean = 0;
+  r.min = s[begin];
+  r.max = s[begin];
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    r.mean += s[i];
+    r.min = std::min(r.min, s[i]);
+    r.max = std::max(r.max, s[i]);
+  }
+  r.mean /= (end - begin);
+
+  double v = 0;
+  for (size_t i = begin; i < end; ++i)
+    v += (s[i] - r.mean) * (s[i] - r.mean);
+  r.stdev = std::sqrt(v / (end - begin));
+
+  return r;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math (SlidingWindow, MovingAverage, MultiMovingAverage)");
+
+  std::vector<double> s(5000);
+  for (size_t i = 0; i < s.size(); ++i)
+    s[i] = 24.0 + std::sin(0.013 * i) + 0.01 * std::sin(7.1 * i) + ((i % 97) == 0 ? 3.0 : 0.0);
+
+  {
+    SlidingWindow<double> w(37);
+    MovingAverage<double> avg(37);
+    bool stats = true;
+    bool extrema = true;
+    bool average = true;
+
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+      w.update(s[i]);
+      avg.update(s[i]);
+      Reference r = reference(s, i + 1, 37);
+
+      stats = stats && std::fabs(w.mean() - r.mean) < 1e-9 && std::fabs(w.stdev() - r.stdev) < 1e-6;
+      extrema = extrema && w.minimum() == r.min && w.maximum() == r.max;
+      average = average && std::fabs(avg.mean() - r.mean) < 1e-9 && std::fabs(avg.stdev() - r.stdev) < 1e-6;
+    }
+
+    test.boolean("mean and standard deviation", stats);
+    test.boolean("minimum and maximum", extrema);
+    test.boolean("moving average", average);
+    test.boolean("window is full", w.isFull() && w.sampleSize() == 37);
+    test.boolean("newest sample", w.newest() == s.back());
+
+    w.clear();
+    test.boolean("clear", w.sampleSize() == 0 && w.mean() == 0);
+  }
+
+  {
+    std::vector<unsigned> sizes;
+    sizes.push_back(5);
+    sizes.push_back(20);
+    MultiMovingAverage<double> mma(sizes);
+
+    bool same = true;
+    for (size_t i = 0; i < 200; ++i)
+    {
+      mma.update(s[i]);
+      same = same && std::fabs(mma.mean(0) - reference(s, i + 1, 5).mean) < 1e-9
+             && std::fabs(mma.mean(1) - reference(s, i + 1, 20).mean) < 1e-9;
+    }
+
+    test.boolean("multi moving average", same);
+  }
+
+  return test.getReturnValue();
+}
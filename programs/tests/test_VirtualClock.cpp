@@ -0,0 +1,235 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Time virtual clock.                               *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Concurrency/Barrier.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Delay.hpp>
+#include <DUNE/Time/PeriodicDelay.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::Time;
+
+static const uint64_t c_sec = 1000000000ULL;
+
+//! Thread that sleeps periodically and records wake up times.
+class Sleeper: public Concurrency::Thread
+{
+public:
+  Sleeper(Concurrency::Barrier& barrier, uint64_t base, double period, unsigned count):
+    m_barrier(barrier),
+    m_base(base),
+    m_period(period),
+    m_count(count)
+  { }
+
+  std::vector<uint64_t> stamps;
+
+private:
+  Concurrency::Barrier& m_barrier;
+  uint64_t m_base;
+  double m_period;
+  unsigned m_count;
+
+  void
+  run(void)
+  {
+    VirtualClock::Participant participant;
+    m_barrier.wait();
+
+    for (unsigned i = 0; i < m_count; ++i)
+    {
+      Delay::wait(m_period);
+      stamps.push_back(Clock::getNsec() - m_base);
+    }
+  }
+};
+
+//! Thread that signals a condition after a delay.
+class Signaler: public Concurrency::Thread
+{
+public:
+  Signaler(Concurrency::Barrier& barrier, Concurrency::Condition& cond, double delay):
+    m_barrier(barrier),
+    m_cond(cond),
+    m_delay(delay)
+  { }
+
+private:
+  Concurrency::Barrier& m_barrier;
+  Concurrency::Condition& m_cond;
+  double m_delay;
+
+  void
+  run(void)
+  {
+    VirtualClock::Participant participant;
+    m_barrier.wait();
+
+    Delay::wait(m_delay);
+    m_cond.lock();
+    m_cond.signal();
+    m_cond.unlock();
+  }
+};
+
+//! Thread that waits on a condition.
+class Waiter: public Concurrency::Thread
+{
+public:
+  Waiter(Concurrency::Barrier& barrier, Concurrency::Condition& cond, double timeout):
+    notified(false),
+    elapsed(0),
+    m_barrier(barrier),
+    m_cond(cond),
+    m_timeout(timeout)
+  { }
+
+  bool notified;
+  uint64_t elapsed;
+
+private:
+  Concurrency::Barrier& m_barrier;
+  Concurrency::Condition& m_cond;
+  double m_timeout;
+
+  void
+  run(void)
+  {
+    VirtualClock::Participant participant;
+    m_barrier.wait();
+
+    uint64_t start = Clock::getNsec();
+    m_cond.lock();
+    notified = m_cond.wait(m_timeout);
+    m_cond.unlock();
+    elapsed = Clock::getNsec() - start;
+  }
+};
+
+static std::vector<std::vector<uint64_t> >
+runSleepers(void)
+{
+  static const double c_periods[] = {0.1, 0.25, 0.7};
+  static const unsigned c_count = sizeof(c_periods) / sizeof(c_periods[0]);
+
+  Concurrency::Barrier barrier(c_count);
+  uint64_t base = Clock::getNsec();
+
+  std::vector<Sleeper*> sleepers;
+  for (unsigned i = 0; i < c_count; ++i)
+    sleepers.push_back(new Sleeper(barrier, base, c_periods[i], 50));
+
+  for (unsigned i = 0; i < c_count; ++i)
+    sleepers[i]->start();
+
+  std::vector<std::vector<uint64_t> > stamps;
+  for (unsigned i = 0; i < c_count; ++i)
+  {
+    sleepers[i]->join();
+    stamps.push_back(sleepers[i]->stamps);
+    delete sleepers[i];
+  }
+
+  return stamps;
+}
+
+int
+main(void)
+{
+  Test test("Time::VirtualClock");
+
+  VirtualClock::enable();
+  test.boolean("enabled", VirtualClock::isEnabled());
+
+  uint64_t real = Clock::getNsecRT();
+
+  {
+    uint64_t mono = Clock::getNsec();
+    uint64_t epoch = Clock::getSinceEpochNsec();
+    Delay::wait(3600.0);
+    test.boolean("one hour delay", Clock::getNsec() - mono == 3600 * c_sec);
+    test.boolean("epoch follows", Clock::getSinceEpochNsec() - epoch == 3600 * c_sec);
+  }
+
+  {
+    uint64_t mono = Clock::getNsec();
+    PeriodicDelay delay(100000);
+    for (unsigned i = 0; i < 100; ++i)
+      delay.wait();
+    test.boolean("periodic delay", Clock::getNsec() - mono == 10 * c_sec);
+  }
+
+  {
+    Concurrency::Condition cond;
+    uint64_t mono = Clock::getNsec();
+    cond.lock();
+    bool notified = cond.wait(2.5);
+    cond.unlock();
+    test.boolean("condition timeout", !notified && Clock::getNsec() - mono == 2500000000ULL);
+  }
+
+  {
+    Concurrency::Barrier barrier(2);
+    Concurrency::Condition cond;
+    Waiter waiter(barrier, cond, 1.0);
+    Signaler signaler(barrier, cond, 0.3);
+    waiter.start();
+    signaler.start();
+    waiter.join();
+    signaler.join();
+    test.boolean("condition signal", waiter.notified && waiter.elapsed == 300000000ULL);
+  }
+
+  {
+    std::vector<std::vector<uint64_t> > first = runSleepers();
+    std::vector<std::vector<uint64_t> > second = runSleepers();
+    test.boolean("deterministic", first == second);
+
+    bool exact = true;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+      exact = exact && first[0][i] == (i + 1) * 100000000ULL;
+      exact = exact && first[1][i] == (i + 1) * 250000000ULL;
+      exact = exact && first[2][i] == (i + 1) * 700000000ULL;
+    }
+    test.boolean("exact wake up times", exact);
+  }
+
+  test.boolean("faster than real-time", Clock::getNsecRT() - real < 5 * c_sec);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,133 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Test program for DUNE::Coordinates batch WGS-84 conversions.             *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers
+#include <DUNE/Coordinates/WGS84.hpp>
+#include <DUNE/Coordinates/LocalTangentPlane.hpp>
+#include "Test.hpp"
+
+using namespace DUNE::Coordinates;
+
+//! Number of sample points.
+static const size_t c_count = 256;
+
+int
+main(void)
+{
+  Test test("DUNE::Coordinates (WGS84 batch, LocalTangentPlane)");
+
+  double rlat = 0.7193;
+  double rlon = -0.1529;
+  double rhae = 12.0;
+
+  std::vector<double> lat(c_count), lon(c_count), hae(c_count);
+  std::vector<double> n(c_count), e(c_count), d(c_count);
+  for (size_t i = 0; i < c_count; ++i)
+  {
+    lat[i] = rlat + 1e-3 * std::sin(0.37 * i);
+    lon[i] = rlon + 1e-3 * std::cos(0.23 * i);
+    hae[i] = 5.0 * std::sin(0.11 * i);
+    n[i] = 400.0 * std::sin(0.05 * i);
+    e[i] = -300.0 * std::cos(0.07 * i);
+    d[i] = 2.0 * std::sin(0.3 * i);
+  }
+
+  {
+    bool round_trip = true;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double x, y, z, olat, olon, ohae;
+      WGS84::toECEF(lat[i], lon[i], hae[i], &x, &y, &z);
+      WGS84::fromECEF(x, y, z, &olat, &olon, &ohae);
+      round_trip = round_trip
+        && std::fabs(olat - lat[i]) < 1e-12
+        && std::fabs(olon - lon[i]) < 1e-12
+        && std::fabs(ohae - hae[i]) < 1e-6;
+    }
+
+    test.boolean("ECEF round trip", round_trip);
+  }
+
+  {
+    std::vector<double> bn(c_count), be(c_count), bd(c_count);
+    WGS84::displacement(rlat, rlon, rhae, &lat[0], &lon[0], &hae[0],
+                        &bn[0], &be[0], &bd[0], c_count);
+
+    LocalTangentPlane ltp(rlat, rlon, rhae);
+    bool same = true;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double sn, se, sd;
+      WGS84::displacement(rlat, rlon, rhae, lat[i], lon[i], hae[i], &sn, &se, &sd);
+
+      double ln, le;
+      ltp.toNED(lat[i], lon[i], hae[i], &ln, &le);
+
+      same = same
+        && std::fabs(sn - bn[i]) < 1e-6 && std::fabs(se - be[i]) < 1e-6
+        && std::fabs(sd - bd[i]) < 1e-6 && ln == bn[i] && le == be[i];
+    }
+
+    test.boolean("batch displacement matches scalar", same);
+  }
+
+  {
+    std::vector<double> blat(c_count), blon(c_count), bhae(c_count);
+    WGS84::displace(rlat, rlon, rhae, &n[0], &e[0], &d[0],
+                    &blat[0], &blon[0], &bhae[0], c_count);
+
+    LocalTangentPlane ltp(rlat, rlon, rhae);
+    bool same = true;
+    bool inverse = true;
+    for (size_t i = 0; i < c_count; ++i)
+    {
+      double slat = rlat;
+      double slon = rlon;
+      double shae = rhae;
+      WGS84::displace(n[i], e[i], d[i], &slat, &slon, &shae);
+
+      same = same
+        && std::fabs(slat - blat[i]) < 1e-13 && std::fabs(slon - blon[i]) < 1e-13
+        && std::fabs(shae - bhae[i]) < 1e-6;
+
+      double rn, re, rd;
+      ltp.toNED(blat[i], blon[i], bhae[i], &rn, &re, &rd);
+      inverse = inverse && std::fabs(rn - n[i]) < 0.05 && std::fabs(re - e[i]) < 0.05;
+    }
+
+    test.boolean("batch displace matches scalar", same);
+    test.boolean("displace and displacement agree", inverse);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,107 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Utility to compress LSF files using multiple threads.                    *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+using DUNE_NAMESPACES;
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 4 || argc > 5)
+  {
+    std::cerr << "Usage: " << argv[0] << " <gzip|bzip2> <threads> <input> [output]" << std::endl;
+    return 1;
+  }
+
+  Compression::Methods method = Compression::Factory::method(argv[1]);
+  if (method == METHOD_UNKNOWN)
+  {
+    std::cerr << "ERROR: unknown compression method '" << argv[1] << "'" << std::endl;
+    return 1;
+  }
+
+  unsigned threads = std::atoi(argv[2]);
+
+  std::string output;
+  if (argc == 5)
+    output = argv[4];
+  else
+    output = std::string(argv[3]) + Compression::Factory::extension(method);
+
+  if (output == argv[3])
+  {
+    std::cerr << "ERROR: input and output files must be different" << std::endl;
+    return 1;
+  }
+
+  std::istream* is = 0;
+
+  try
+  {
+    Compression::Methods input_method = Compression::Factory::detect(argv[3]);
+    if (input_method == METHOD_UNKNOWN)
+      is = new std::ifstream(argv[3], std::ios::binary);
+    else
+      is = new Compression::FileInput(argv[3], input_method);
+
+    if (!*is)
+    {
+      std::cerr << "ERROR: unable to read '" << argv[3] << "'" << std::endl;
+      delete is;
+      return 1;
+    }
+
+    Compression::FileOutput os(output.c_str(), method, threads);
+
+    char bfr[64 * 1024];
+    while (*is)
+    {
+      is->read(bfr, sizeof(bfr));
+      os.write(bfr, is->gcount());
+    }
+
+    os.flush();
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    delete is;
+    return 1;
+  }
+
+  delete is;
+
+  return 0;
+}
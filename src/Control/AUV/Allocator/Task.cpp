@@ -81,6 +81,12 @@ namespace Control
         double k_yaw;
         //!  
         bool roll_not_velocity_dependent;
+        //! Use constrained allocation.
+        bool qp;
+        //! Weight of fin deflection in constrained allocation.
+        double qp_weight;
+        //! Maximum solver iterations per allocation.
+        unsigned qp_iterations;
       };
 
       struct Task: public DUNE::Tasks::Task
@@ -109,13 +115,34 @@ namespace Control
         Arguments m_args;
         Math::MovingAverage<double>* m_avg_ms ;
         Math::MovingAverage<double>* m_avg_rpm; 
+        //! Fin allocation solver.
+        Math::QPSolver m_qp;
+        //! Torque produced per fin deflection.
+        Math::Matrix m_qp_b;
+        //! Allocation cost Hessian.
+        Math::Matrix m_qp_h;
+        //! Allocation cost gradient.
+        Math::Matrix m_qp_f;
+        //! Fin deflection limit constraints.
+        Math::Matrix m_qp_a;
+        //! Fin deflection limit bounds.
+        Math::Matrix m_qp_c;
+        //! Fin deflections.
+        Math::Matrix m_qp_x;
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::Task(name, ctx),
           m_last_estimated_state(NULL),
           m_last_rpm(NULL),
           m_braking(false),
-          m_scope_ref(0)
+          m_scope_ref(0),
+          m_qp(c_fins, 0, 2 * c_fins),
+          m_qp_b(3, c_fins, 0.0),
+          m_qp_h(c_fins, c_fins, 0.0),
+          m_qp_f(c_fins, 1, 0.0),
+          m_qp_a(2 * c_fins, c_fins, 0.0),
+          m_qp_c(2 * c_fins, 1, 0.0),
+          m_qp_x(c_fins, 1, 0.0)
         {
           param(DTR_RT("Maximum Fin Rotation"), m_args.max_fin_rot)
           .defaultValue("25.0")
@@ -192,6 +219,20 @@ namespace Control
 
 
 
+          param("Constrained Allocation", m_args.qp)
+          .defaultValue("false")
+          .description("Allocate torques solving a constrained least squares"
+                       " problem instead of distributing fin margins");
+
+          param("Constrained Allocation -- Fin Weight", m_args.qp_weight)
+          .defaultValue("0.001")
+          .minimumValue("0.000001")
+          .description("Weight of fin deflection in constrained allocation");
+
+          param("Constrained Allocation -- Maximum Iterations", m_args.qp_iterations)
+          .defaultValue("20")
+          .description("Maximum number of solver iterations per allocation");
+
           param("Entity Label - Servo Position", m_args.spos_label)
           .defaultValue("")
           .description("Label of the servo position message to compute produced torque");
@@ -220,6 +261,18 @@ namespace Control
 
           if (paramChanged(m_args.max_fin_rate))
             m_args.max_fin_rate = Angles::radians(m_args.max_fin_rate);
+
+          // Fin deflection limits: |fin(i)| <= max_fin_rot.
+          for (int i = 0; i < c_fins; ++i)
+          {
+            m_qp_a(i, i) = 1.0;
+            m_qp_a(c_fins + i, i) = -1.0;
+            m_qp_c(i) = m_args.max_fin_rot;
+            m_qp_c(c_fins + i) = m_args.max_fin_rot;
+          }
+
+          m_qp.setMaximumIterations(m_args.qp_iterations);
+          m_qp.reset();
         }
 
         void
@@ -422,6 +475,9 @@ namespace Control
             m_s = m_avg_ms->mean();   
           }
 
+          if (m_args.qp && allocateQP(k, m, n, rpm, m_s))
+            return;
+
           // Allocate N
           if(!m_args.velocity_dependent)
           {
@@ -616,6 +672,96 @@ namespace Control
           dispatch(m_allocated);
         }
 
+        //! Allocate desired control torques on the fins by solving
+        //!   min |B fins - tau|^2 + w |fins|^2
+        //! subject to the fin deflection limits, where B maps fin
+        //! deflections to roll, pitch and yaw torques.
+        //! @param[in] k desired control torque in roll
+        //! @param[in] m desired control torque in pitch
+        //! @param[in] n desired control torque in yaw
+        //! @param[in] rpm filtered propeller speed (thousands of RPM)
+        //! @param[in] speed filtered surge speed
+        //! @return true if successful, false otherwise.
+        bool
+        allocateQP(float k, float m, float n, double rpm, double speed)
+        {
+          // Effective fin effect for each axis.
+          double conv[3] = {m_args.conv[0], m_args.conv[1], m_args.conv[2]};
+          if (m_args.velocity_dependent)
+          {
+            double v = (m_args.velocity_dependent_unit == "RPM") ? rpm : speed;
+            double k_axis[3] = {m_args.k_roll, m_args.k_pitch, m_args.k_yaw};
+
+            for (int i = 0; i < 3; ++i)
+            {
+              if (i == 0 && m_args.roll_not_velocity_dependent)
+                continue;
+
+              conv[i] *= v * v / k_axis[i];
+            }
+          }
+
+          // Fin signs as used by the margin distribution scheme.
+          m_qp_b(0, 0) = -conv[0];
+          m_qp_b(0, 1) = conv[0];
+          m_qp_b(0, 2) = -conv[0];
+          m_qp_b(0, 3) = conv[0];
+          m_qp_b(1, 1) = -conv[1];
+          m_qp_b(1, 2) = -conv[1];
+          m_qp_b(2, 0) = -conv[2];
+          m_qp_b(2, 3) = -conv[2];
+
+          double tau[3] = {k, m, n};
+
+          // H = 2 (B' B + w I), f = -2 B' tau.
+          for (int i = 0; i < c_fins; ++i)
+          {
+            double v = 0.0;
+            for (int r = 0; r < 3; ++r)
+              v += m_qp_b(r, i) * tau[r];
+            m_qp_f(i) = -2.0 * v;
+
+            for (int j = 0; j < c_fins; ++j)
+            {
+              double h = (i == j) ? m_args.qp_weight : 0.0;
+              for (int r = 0; r < 3; ++r)
+                h += m_qp_b(r, i) * m_qp_b(r, j);
+              m_qp_h(i, j) = 2.0 * h;
+            }
+          }
+
+          try
+          {
+            m_qp.minimize(m_qp_h, m_qp_f, m_qp_a, m_qp_c, m_qp_x);
+          }
+          catch (std::exception& e)
+          {
+            err(DTR("fin allocation failed: %s"), e.what());
+            m_qp.reset();
+            return false;
+          }
+
+          if (!m_qp.hasConverged())
+            debug("fin allocation stopped after %u iterations", m_qp.getIterations());
+
+          for (int i = 0; i < c_fins; ++i)
+            m_fins[i].value = trimValue(m_qp_x(i), -m_args.max_fin_rot, m_args.max_fin_rot);
+
+          m_allocated.k = 0.0;
+          m_allocated.m = 0.0;
+          m_allocated.n = 0.0;
+          for (int i = 0; i < c_fins; ++i)
+          {
+            m_allocated.k += m_qp_b(0, i) * m_fins[i].value;
+            m_allocated.m += m_qp_b(1, i) * m_fins[i].value;
+            m_allocated.n += m_qp_b(2, i) * m_fins[i].value;
+          }
+
+          dispatchAllFins();
+          dispatch(m_allocated);
+          return true;
+        }
+
         // Position the fins in a braking position (neutral or pitching up)
         //! @param[in] k torque about x to apply
         //! @param[in] m torque about y to apply
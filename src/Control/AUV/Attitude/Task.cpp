@@ -528,13 +528,13 @@ namespace Control
             double elements_J2[9] = {1, sin(msg->phi)*tan(msg->theta), cos(msg->phi)*tan(msg->theta),
                                      0, cos(msg->phi), -sin(msg->phi),
                                      0, sin(msg->phi)/cos(msg->theta), cos(msg->phi)*cos(msg->theta)};
-            Matrix J2(elements_J2, 3, 3);
+            Matrix3 J2(elements_J2);
 
             double elements_comdot[3] = {-msg->phi,
                                          depthControl(timestep, msg),
                                          headingControl(timestep, msg)};
 
-            Matrix v = inverse(J2) * Matrix(elements_comdot, 3, 1);
+            Vector3 v = inverse(J2) * Vector3(elements_comdot);
 
             if (m_args.roll_control_enabled)
               torques.k = trimValue(v(0), -m_args.max_fin_rot, m_args.max_fin_rot);
@@ -83,6 +83,9 @@ namespace Control
         float max_sway;
         float max_thrust;
         Matrix tmat;
+        std::string alloc_method;
+        double alloc_weight;
+        unsigned alloc_iterations;
         bool stabilize_ground;
         bool log_parcels;
       };
@@ -95,9 +98,26 @@ namespace Control
         IMC::ControlParcel m_parcels[LP_MAX_LOOPS];
         //! Task Arguments
         Arguments m_args;
+        //! Use constrained thrust allocation.
+        bool m_qp_alloc;
+        //! Thrust allocation solver.
+        Math::QPSolver m_qp;
+        //! Thrust configuration matrix (forces from thruster actuations).
+        Matrix m_qp_b;
+        //! Thrust allocation cost Hessian.
+        Matrix m_qp_h;
+        //! Thrust allocation cost gradient.
+        Matrix m_qp_f;
+        //! Thrust limit constraints.
+        Matrix m_qp_a;
+        //! Thrust limit constraint bounds.
+        Matrix m_qp_c;
+        //! Thruster actuations.
+        Matrix m_thrust;
 
         Task(const std::string& name, Tasks::Context& ctx):
-          DUNE::Control::BasicAutopilot(name, ctx, c_controllable, c_required)
+          DUNE::Control::BasicAutopilot(name, ctx, c_controllable, c_required),
+          m_qp_alloc(false)
         {
           // Load controller gains and integral limits
           for (unsigned i = 0; i < LP_MAX_LOOPS; ++i)
@@ -150,6 +170,21 @@ namespace Control
           .size(12)
           .description("Thrust allocation pseudo inverse matrix");
 
+          param("Thrust Allocation Method", m_args.alloc_method)
+          .defaultValue("Pseudo Inverse")
+          .values("Pseudo Inverse, Quadratic Programming")
+          .description("Pseudo inverse with saturation or constrained least squares"
+                       " allocation that respects the thrust limits");
+
+          param("Thrust Allocation Weight", m_args.alloc_weight)
+          .defaultValue("0.001")
+          .minimumValue("0.000001")
+          .description("Weight of the thrust magnitude in constrained allocation");
+
+          param("Thrust Allocation Maximum Iterations", m_args.alloc_iterations)
+          .defaultValue("20")
+          .description("Maximum number of solver iterations per control cycle");
+
           param("Stabilize Ground Speeds", m_args.stabilize_ground)
           .defaultValue("false")
           .description("If speed reference is zero, control thrusters to keep it zero");
@@ -179,6 +214,7 @@ namespace Control
         void
         onUpdateParameters(void)
         {
+          m_qp_alloc = false;
           reset();
 
           if (paramChanged(m_args.int_heading_limit))
@@ -213,6 +249,88 @@ namespace Control
 
           // Heading rate control parameters.
           m_pid[LP_HRATE].setIntegralLimits(m_args.int_hrate_limit);
+
+          setupAllocation();
+        }
+
+        //! Prepare the constrained thrust allocation problem:
+        //!   min |B u - tau|^2 + w |u|^2 subject to |u(i)| <= max thrust,
+        //! where B is the pseudo inverse of the configured allocation matrix.
+        void
+        setupAllocation(void)
+        {
+          m_qp_alloc = false;
+
+          if (m_args.alloc_method != "Quadratic Programming")
+            return;
+
+          unsigned n = m_args.n_thrusters;
+          if (m_args.tmat.rows() != (int)n || m_args.tmat.columns() != 3)
+          {
+            war(DTR("invalid thrust allocation matrix, using pseudo inverse"));
+            return;
+          }
+
+          try
+          {
+            Matrix tt = transpose(m_args.tmat);
+            m_qp_b = inverse(tt * m_args.tmat) * tt;
+          }
+          catch (std::exception& e)
+          {
+            war(DTR("invalid thrust allocation matrix, using pseudo inverse: %s"), e.what());
+            return;
+          }
+
+          m_qp_h = transpose(m_qp_b) * m_qp_b + Matrix(n) * m_args.alloc_weight;
+          m_qp_h *= 2.0;
+          m_qp_f.resizeAndFill(n, 1, 0.0);
+          m_thrust.resizeAndFill(n, 1, 0.0);
+          m_qp_a.resizeAndFill(2 * n, n, 0.0);
+          m_qp_c.resizeAndFill(2 * n, 1, m_args.max_thrust);
+          for (unsigned i = 0; i < n; ++i)
+          {
+            m_qp_a(i, i) = 1.0;
+            m_qp_a(n + i, i) = -1.0;
+          }
+
+          m_qp = Math::QPSolver(n, 0, 2 * n);
+          m_qp.setMaximumIterations(m_args.alloc_iterations);
+          m_qp_alloc = true;
+        }
+
+        //! Allocate thrust solving the constrained allocation problem.
+        //! @param[in] tau desired surge, sway and yaw forces.
+        //! @return true if successful, false otherwise.
+        bool
+        allocateQP(const double* tau)
+        {
+          unsigned n = m_args.n_thrusters;
+
+          // f = -2 B' tau.
+          for (unsigned i = 0; i < n; ++i)
+          {
+            double v = 0.0;
+            for (unsigned j = 0; j < 3; ++j)
+              v += m_qp_b(j, i) * tau[j];
+            m_qp_f(i) = -2.0 * v;
+          }
+
+          try
+          {
+            m_qp.minimize(m_qp_h, m_qp_f, m_qp_a, m_qp_c, m_thrust);
+          }
+          catch (std::exception& e)
+          {
+            err(DTR("thrust allocation failed: %s"), e.what());
+            m_qp.reset();
+            return false;
+          }
+
+          if (!m_qp.hasConverged())
+            debug("thrust allocation stopped after %u iterations", m_qp.getIterations());
+
+          return true;
         }
 
         void
@@ -313,15 +431,18 @@ namespace Control
         tal(double X, double Y, double N)
         {
           double p[3] = {X, Y, N};
-          Matrix tau(p, 3, 1);
 
-          Matrix F = m_args.tmat * tau;
+          if (!m_qp_alloc || !allocateQP(p))
+          {
+            Matrix tau(p, 3, 1);
+            m_thrust = m_args.tmat * tau;
+          }
 
           for (unsigned i = 0; i < m_args.n_thrusters; ++i)
           {
             IMC::SetThrusterActuation msg;
             msg.id = i;
-            msg.value = trimValue(F(i), -m_args.max_thrust, m_args.max_thrust);
+            msg.value = trimValue(m_thrust(i), -m_args.max_thrust, m_args.max_thrust);
             dispatch(msg);
           }
 
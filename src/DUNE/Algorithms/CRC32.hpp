@@ -31,6 +31,9 @@
 #ifndef DUNE_ALGORITHMS_CRC32_HPP_INCLUDED_
 #define DUNE_ALGORITHMS_CRC32_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstddef>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -75,7 +78,7 @@ namespace DUNE
       //! @param crc CRC-32 value to update.
       //! @return computed CRC-32.
       static inline uint32_t 
-      compute(const uint8_t *buf, const uint8_t len, bool do_reflect, uint32_t crc=0)
+      compute(const uint8_t *buf, size_t len, bool do_reflect, uint32_t crc=0)
       {
 
         const uint8_t *end;
@@ -48,6 +48,7 @@ namespace DUNE
 #include <DUNE/Compression/Bzip2Decompressor.hpp>
 #include <DUNE/Compression/ZlibDecompressor.hpp>
 #include <DUNE/Compression/StreamBuffer.hpp>
+#include <DUNE/Compression/ParallelStreamBuffer.hpp>
 #include <DUNE/Compression/FilterInput.hpp>
 #include <DUNE/Compression/FilterOutput.hpp>
 #include <DUNE/Compression/FileInput.hpp>
@@ -48,6 +48,12 @@ namespace DUNE
 
       ~Bzip2Decompressor(void);
 
+      bool
+      streamEnded(void) const
+      {
+        return m_clear;
+      }
+
     protected:
       virtual unsigned long
       decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len);
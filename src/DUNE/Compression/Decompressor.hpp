@@ -95,6 +95,15 @@ namespace DUNE
         return m_unprocessed;
       }
 
+      //! Check if the last call to decompress() reached the end of a
+      //! compressed stream (e.g., the end of a gzip member).
+      //! @return true if a stream ended, false otherwise.
+      virtual bool
+      streamEnded(void) const
+      {
+        return false;
+      }
+
     protected:
       virtual unsigned long
       decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len) = 0;
@@ -45,12 +45,20 @@ namespace DUNE
     class FileInput: public std::istream
     {
     public:
-      FileInput(const char* filename, Methods method):
+      //! Constructor.
+      //! @param[in] filename input file.
+      //! @param[in] method compression method.
+      //! @param[in] offset offset of the first byte to read. Must be
+      //! the start of a compressed stream (e.g., a gzip member).
+      FileInput(const char* filename, Methods method, uint64_t offset = 0):
         std::istream(0),
         m_method(method),
         m_stream(filename, std::ios::binary | std::ios::in),
         m_buffer(0)
       {
+        if (offset > 0)
+          m_stream.seekg(offset);
+
         attach(m_stream);
       }
 
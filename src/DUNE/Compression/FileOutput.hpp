@@ -36,6 +36,7 @@
 
 // DUNE headers.
 #include <DUNE/Compression/StreamBuffer.hpp>
+#include <DUNE/Compression/ParallelStreamBuffer.hpp>
 #include <DUNE/Compression/Methods.hpp>
 
 namespace DUNE
@@ -45,9 +46,15 @@ namespace DUNE
     class FileOutput: public std::ostream
     {
     public:
-      FileOutput(const char* filename, Methods method):
+      //! Constructor.
+      //! @param[in] filename output file.
+      //! @param[in] method compression method.
+      //! @param[in] workers number of compression threads, zero to
+      //! compress in the calling thread.
+      FileOutput(const char* filename, Methods method, unsigned workers = 0):
         std::ostream(0),
         m_method(method),
+        m_workers(workers),
         m_stream(filename, std::ios::binary | std::ios::out),
         m_buffer(0)
       {
@@ -65,14 +72,19 @@ namespace DUNE
         if (m_buffer)
           delete m_buffer;
 
-        m_buffer = new StreamBuffer(&stream, m_method);
+        if (m_workers > 0)
+          m_buffer = new ParallelStreamBuffer(&stream, m_method, m_workers);
+        else
+          m_buffer = new StreamBuffer(&stream, m_method);
+
         rdbuf(m_buffer);
       }
 
     protected:
       Methods m_method;
+      unsigned m_workers;
       std::ofstream m_stream;
-      StreamBuffer* m_buffer;
+      std::streambuf* m_buffer;
     };
   }
 }
@@ -0,0 +1,263 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+
+// DUNE headers.
+#include <DUNE/Compression/ParallelStreamBuffer.hpp>
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/Compression/Compressor.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Compression thread.
+    class ParallelStreamBuffer::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(ParallelStreamBuffer& parent):
+        m_parent(parent),
+        m_com(Factory::compressor(parent.m_method))
+      { }
+
+      ~Worker(void)
+      {
+        delete m_com;
+      }
+
+    private:
+      //! Parent stream buffer.
+      ParallelStreamBuffer& m_parent;
+      //! Compressor.
+      Compressor* m_com;
+
+      void
+      run(void)
+      {
+        Job* job = NULL;
+        while ((job = m_parent.take()) != NULL)
+        {
+          try
+          {
+            m_com->compress(job->output, job->input);
+          }
+          catch (...)
+          {
+            job->failed = true;
+          }
+
+          m_parent.complete(job);
+        }
+      }
+    };
+
+    ParallelStreamBuffer::ParallelStreamBuffer(std::ostream* stream, Methods method, unsigned workers,
+                                               unsigned block_size):
+      m_method(method),
+      m_ostream(stream),
+      m_block_size(block_size),
+      m_stop(false)
+    {
+      if (workers == 0)
+        workers = 1;
+
+      // Bound memory usage while keeping all workers busy.
+      m_max_jobs = workers * 2;
+
+      m_job = new Job;
+      m_job->input.setSize(0);
+
+      for (unsigned i = 0; i < workers; ++i)
+      {
+        Worker* worker = new Worker(*this);
+        worker->start();
+        m_workers.push_back(worker);
+      }
+    }
+
+    ParallelStreamBuffer::~ParallelStreamBuffer(void)
+    {
+      try
+      {
+        sync();
+      }
+      catch (...)
+      { }
+
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        m_stop = true;
+        m_cond.broadcast();
+      }
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+      {
+        m_workers[i]->stopAndJoin();
+        delete m_workers[i];
+      }
+
+      for (unsigned i = 0; i < m_queue.size(); ++i)
+        delete m_queue[i];
+
+      for (unsigned i = 0; i < m_free.size(); ++i)
+        delete m_free[i];
+
+      delete m_job;
+    }
+
+    int
+    ParallelStreamBuffer::sync(void)
+    {
+      submit();
+      drain(m_queue.size());
+      m_ostream->flush();
+      return 0;
+    }
+
+    ParallelStreamBuffer::int_type
+    ParallelStreamBuffer::overflow(int_type c)
+    {
+      if (c != EOF)
+      {
+        char ch = traits_type::to_char_type(c);
+        xsputn(&ch, 1);
+      }
+
+      return c;
+    }
+
+    std::streamsize
+    ParallelStreamBuffer::xsputn(const char* bfr, std::streamsize length)
+    {
+      // Blocks are only split between writes, keeping records written
+      // with a single call (e.g., IMC packets) inside one block.
+      m_job->input.appendSigned(bfr, length);
+
+      if (m_job->input.getSize() >= m_block_size)
+        submit();
+
+      return length;
+    }
+
+    void
+    ParallelStreamBuffer::submit(void)
+    {
+      if (m_job->input.getSize() == 0)
+        return;
+
+      m_job->done = false;
+      m_job->failed = false;
+
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        m_pending.push_back(m_job);
+        m_queue.push_back(m_job);
+        m_cond.broadcast();
+      }
+
+      if (m_free.empty())
+      {
+        m_job = new Job;
+      }
+      else
+      {
+        m_job = m_free.back();
+        m_free.pop_back();
+      }
+
+      m_job->input.setSize(0);
+
+      if (m_queue.size() > m_max_jobs)
+        drain(m_queue.size() - m_max_jobs);
+      else
+        drain(0);
+    }
+
+    void
+    ParallelStreamBuffer::drain(unsigned count)
+    {
+      while (!m_queue.empty())
+      {
+        Job* job = NULL;
+
+        {
+          Concurrency::ScopedCondition l(m_cond);
+          job = m_queue.front();
+
+          while (!job->done)
+          {
+            if (count == 0)
+              return;
+
+            m_cond.wait();
+          }
+
+          m_queue.pop_front();
+        }
+
+        m_free.push_back(job);
+
+        if (count > 0)
+          --count;
+
+        if (job->failed)
+          throw Error("failed to compress block");
+
+        m_ostream->write(job->output.getBufferSigned(), job->output.getSize());
+      }
+    }
+
+    ParallelStreamBuffer::Job*
+    ParallelStreamBuffer::take(void)
+    {
+      Concurrency::ScopedCondition l(m_cond);
+
+      while (m_pending.empty() && !m_stop)
+        m_cond.wait();
+
+      if (m_pending.empty())
+        return NULL;
+
+      Job* job = m_pending.front();
+      m_pending.pop_front();
+      return job;
+    }
+
+    void
+    ParallelStreamBuffer::complete(Job* job)
+    {
+      Concurrency::ScopedCondition l(m_cond);
+      job->done = true;
+      m_cond.broadcast();
+    }
+  }
+}
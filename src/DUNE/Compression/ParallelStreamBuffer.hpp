@@ -0,0 +1,154 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_PARALLEL_STREAM_BUFFER_HPP_INCLUDED_
+#define DUNE_COMPRESSION_PARALLEL_STREAM_BUFFER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <streambuf>
+#include <ostream>
+#include <deque>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Methods.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM ParallelStreamBuffer;
+
+    //! Output stream buffer that splits data in independent blocks
+    //! and compresses them on a pool of worker threads. Compressed
+    //! blocks are written to the associated stream in submission
+    //! order, producing a sequence of concatenated streams
+    //! (pigz/pbzip2 compatible) that can be read by the standard
+    //! tools and by Compression::FileInput.
+    class ParallelStreamBuffer: public std::streambuf
+    {
+    public:
+      //! Default block size.
+      static const unsigned c_block_size = 128 * 1024;
+
+      //! Constructor.
+      //! @param[in] stream output stream.
+      //! @param[in] method compression method.
+      //! @param[in] workers number of compression threads.
+      //! @param[in] block_size minimum size of uncompressed blocks.
+      ParallelStreamBuffer(std::ostream* stream, Methods method, unsigned workers,
+                           unsigned block_size = c_block_size);
+
+      //! Destructor. Flushes all pending blocks.
+      virtual
+      ~ParallelStreamBuffer(void);
+
+    protected:
+      virtual int_type
+      overflow(int_type c);
+
+      virtual int
+      sync(void);
+
+      virtual std::streamsize
+      xsputn(const char* bfr, std::streamsize bfr_len);
+
+    private:
+      // Forward declarations.
+      class Worker;
+
+      //! Compression job.
+      struct Job
+      {
+        //! Uncompressed data.
+        Utils::ByteBuffer input;
+        //! Compressed data.
+        Utils::ByteBuffer output;
+        //! True if the job was processed.
+        bool done;
+        //! True if compression failed.
+        bool failed;
+      };
+
+      //! Compression method.
+      Methods m_method;
+      //! Associated output stream.
+      std::ostream* m_ostream;
+      //! Minimum size of uncompressed blocks.
+      unsigned m_block_size;
+      //! Maximum number of blocks in flight.
+      unsigned m_max_jobs;
+      //! Block being filled.
+      Job* m_job;
+      //! Jobs waiting for a worker.
+      std::deque<Job*> m_pending;
+      //! Jobs submitted but not yet written, in submission order.
+      std::deque<Job*> m_queue;
+      //! Unused jobs.
+      std::vector<Job*> m_free;
+      //! Compression threads.
+      std::vector<Worker*> m_workers;
+      //! Condition protecting job queues.
+      Concurrency::Condition m_cond;
+      //! True if workers must terminate.
+      bool m_stop;
+
+      //! Hand the current block to the worker pool.
+      void
+      submit(void);
+
+      //! Write completed blocks at the head of the queue.
+      //! @param[in] count number of blocks that must be written,
+      //! waiting for their completion if necessary.
+      void
+      drain(unsigned count);
+
+      //! Retrieve the next job for a worker thread.
+      //! @return job or NULL if the worker must terminate.
+      Job*
+      take(void);
+
+      //! Mark a job as processed.
+      //! @param[in] job processed job.
+      void
+      complete(Job* job);
+
+      //! Non - copyable.
+      ParallelStreamBuffer(const ParallelStreamBuffer&);
+
+      //! Non - assignable.
+      ParallelStreamBuffer&
+      operator=(const ParallelStreamBuffer&);
+    };
+  }
+}
+
+#endif
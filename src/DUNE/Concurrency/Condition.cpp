@@ -35,6 +35,7 @@
 #include <DUNE/Concurrency/Condition.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 
 namespace DUNE
 {
@@ -92,6 +93,9 @@ namespace DUNE
     Condition::wait(double t)
     {
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      if (Time::VirtualClock::isEnabled())
+        return Time::VirtualClock::wait(*this, t);
+
       int rv = 0;
 
       if (t > 0)
@@ -143,6 +147,12 @@ namespace DUNE
     Condition::broadcast(void)
     {
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      if (Time::VirtualClock::isEnabled())
+      {
+        Time::VirtualClock::notify(this, true);
+        return;
+      }
+
       int rv = pthread_cond_broadcast(&m_cond);
 
       if (rv != 0)
@@ -154,6 +164,12 @@ namespace DUNE
     Condition::signal(void)
     {
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      if (Time::VirtualClock::isEnabled())
+      {
+        Time::VirtualClock::notify(this, false);
+        return;
+      }
+
       int rv = pthread_cond_signal(&m_cond);
 
       if (rv != 0)
@@ -41,6 +41,17 @@ namespace DUNE
     using std::sin;
     using std::cos;
 
+    //! Copy a vector of coefficients into a fixed-size vector.
+    template <size_t N>
+    static MatrixN<N, 1>
+    toVector(const Matrix& m)
+    {
+      if (m.size() != (int)N)
+        throw Matrix::Error("Invalid dimensions!");
+
+      return MatrixN<N, 1>(m.cbegin());
+    }
+
     //! Constructor.
     AUVModel::AUVModel(const ModelParameters& param):
       m_mass(param.mass),
@@ -48,16 +59,17 @@ namespace DUNE
       m_volume(param.volume),
       m_motor_friction(param.motor_friction),
       m_max_thrust(param.max_thrust),
-      m_cog(param.cog),
-      m_addedmass(param.addedmass),
-      m_inertia(param.inertia),
-      m_ldrag(param.linear_drag),
-      m_qdrag(param.quadratic_drag),
-      m_lift(param.lift),
-      m_fin_lift(param.fin_lift)
+      m_cog(toVector<3>(param.cog)),
+      m_addedmass(toVector<6>(param.addedmass)),
+      m_inertia(toVector<3>(param.inertia)),
+      m_ldrag(toVector<10>(param.linear_drag)),
+      m_qdrag(toVector<10>(param.quadratic_drag)),
+      m_lift(toVector<8>(param.lift)),
+      m_fin_lift(toVector<5>(param.fin_lift))
     {
       // compute matrix M which does not change with time
       m_matrix_mass = computeM();
+      m_matrix_mass_inv = inverse(m_matrix_mass);
     }
 
     //! Destructor.
@@ -67,89 +79,115 @@ namespace DUNE
     Matrix
     AUVModel::step(const Matrix& nu_dot, const Matrix& nu, const Matrix& eta)
     {
-      return m_matrix_mass * nu_dot + computeC(nu) * nu + computeD(nu) * nu + computeL(nu) * nu + computeG(eta);
+      return step(toVector<6>(nu_dot), toVector<6>(nu), toVector<6>(eta)).toMatrix();
+    }
+
+    Vector6
+    AUVModel::step(const Vector6& nu_dot, const Vector6& nu, const Vector6& eta) const
+    {
+      return m_matrix_mass * nu_dot + (computeC(nu) + computeD(nu) + computeL(nu)) * nu + computeG(eta);
     }
 
     Matrix
     AUVModel::stepInv(const Matrix& tau, const Matrix& nu, const Matrix& eta)
     {
-      return inverse(m_matrix_mass) * (tau - computeC(nu) * nu - computeD(nu) * nu - computeL(nu) * nu - computeG(eta));
+      return stepInv(toVector<6>(tau), toVector<6>(nu), toVector<6>(eta)).toMatrix();
+    }
+
+    Vector6
+    AUVModel::stepInv(const Vector6& tau, const Vector6& nu, const Vector6& eta) const
+    {
+      return m_matrix_mass_inv * (tau - (computeC(nu) + computeD(nu) + computeL(nu)) * nu - computeG(eta));
     }
 
     Matrix
     AUVModel::stepInv(const Matrix& xyz, const Matrix& deflections, const Matrix& nu, const Matrix& eta)
     {
-      Matrix tau(6, 1, 0.0);
+      Vector6 v = toVector<6>(nu);
+      Vector6 tau;
 
       tau(0) = xyz(0);
-      tau(1) = xyz(1) + m_fin_lift(0) * nu(0) * nu(0) * deflections(2);
-      tau(2) = xyz(2) + m_fin_lift(1) * nu(0) * nu(0) * deflections(1);
+      tau(1) = xyz(1) + m_fin_lift(0) * v(0) * v(0) * deflections(2);
+      tau(2) = xyz(2) + m_fin_lift(1) * v(0) * v(0) * deflections(1);
 
-      tau(3) = m_fin_lift(2) * nu(0) * nu(0) * deflections(0);
-      tau(4) = m_fin_lift(3) * nu(0) * nu(0) * deflections(1);
-      tau(5) = m_fin_lift(4) * nu(0) * nu(0) * deflections(2);
+      tau(3) = m_fin_lift(2) * v(0) * v(0) * deflections(0);
+      tau(4) = m_fin_lift(3) * v(0) * v(0) * deflections(1);
+      tau(5) = m_fin_lift(4) * v(0) * v(0) * deflections(2);
 
-      return stepInv(tau, nu, eta);
+      return stepInv(tau, v, toVector<6>(eta)).toMatrix();
     }
 
     Matrix
     AUVModel::stepInv(double thruster_act, const Matrix& servo_pos, const Matrix& nu, const Matrix& eta)
     {
-      Matrix tau = computeTau(nu(0), thruster_act, servo_pos);
-      return stepInv(tau, nu, eta);
+      Vector6 v = toVector<6>(nu);
+      Vector6 tau = computeTau(v(0), thruster_act, servo_pos);
+      return stepInv(tau, v, toVector<6>(eta)).toMatrix();
     }
 
     //! Computes matrix of added mass and inertia
-    Matrix
-    AUVModel::computeM(void)
+    Matrix6
+    AUVModel::computeM(void) const
     {
       // added mass matrix
-      Matrix Ma = -Matrix(&m_addedmass(0), 6);
+      Matrix6 Ma = -Matrix6::diagonal(m_addedmass.begin());
 
       // mass and cog submatrix
-      Matrix cog = -skew(m_cog) * m_mass;
+      Matrix3 cog = -skew(m_cog) * m_mass;
 
       // inertia submatrix
-      Matrix I(&m_inertia(0), 3);
+      Matrix3 I = Matrix3::diagonal(m_inertia.begin());
 
-      Matrix Mrb = Matrix(3) * m_mass;
-      Mrb.vertCat(-cog);
-      Mrb.horzCat(cog.vertCat(I));
+      Matrix6 Mrb;
+      Mrb.set(0, 0, Matrix3::identity() * m_mass);
+      Mrb.set(3, 0, -cog);
+      Mrb.set(0, 3, cog);
+      Mrb.set(3, 3, I);
 
       return Mrb + Ma;
     }
 
     //! Computes coriolis and centripetal matrix in the skew symmetric form
-    Matrix
-    AUVModel::computeC(const Matrix& nu)
+    Matrix6
+    AUVModel::computeC(const Vector6& nu) const
     {
       // CA
-      Matrix a = (m_addedmass & nu).get(0, 2, 0, 0);
-      Matrix b = (m_addedmass & nu).get(3, 5, 0, 0);
+      Vector3 a;
+      Vector3 b;
+      for (size_t i = 0; i < 3; ++i)
+      {
+        a(i) = m_addedmass(i) * nu(i);
+        b(i) = m_addedmass(i + 3) * nu(i + 3);
+      }
 
-      Matrix ca = Matrix(3, 3, 0.0).horzCat(skew(a));
-      ca.vertCat(skew(a).horzCat(skew(b)));
+      Matrix6 ca;
+      ca.set(0, 3, skew(a));
+      ca.set(3, 0, skew(a));
+      ca.set(3, 3, skew(b));
 
       // CRB
-      Matrix skew_cog = skew(m_cog);
-
-      Matrix skew_v1 = skew(nu.get(0, 2, 0, 0));
-      Matrix skew_v2 = skew(nu.get(3, 5, 0, 0));
+      Matrix3 skew_cog = skew(m_cog);
 
-      Matrix crb(3, 3, 0.0);
-      crb.vertCat(-m_mass * skew_v1 + m_mass * skew_cog * skew_v2);
+      Vector3 v1 = nu.get<3, 1>(0, 0);
+      Vector3 v2 = nu.get<3, 1>(3, 0);
+      Matrix3 skew_v1 = skew(v1);
+      Matrix3 skew_v2 = skew(v2);
 
-      Matrix crb2 = -m_mass * skew_v1 - m_mass * skew_v2 * skew_cog;
-      crb2.vertCat(-skew(Matrix(&m_inertia(0), 3) * nu.get(3, 5, 0, 0)));
+      Vector3 iv2;
+      for (size_t i = 0; i < 3; ++i)
+        iv2(i) = m_inertia(i) * v2(i);
 
-      crb.horzCat(crb2);
+      Matrix6 crb;
+      crb.set(3, 0, -m_mass * skew_v1 + m_mass * skew_cog * skew_v2);
+      crb.set(0, 3, -m_mass * skew_v1 - m_mass * skew_v2 * skew_cog);
+      crb.set(3, 3, -skew(iv2));
 
       return ca + crb;
     }
 
     //! Routine to compute matrix D using state nu
-    Matrix
-    AUVModel::computeD(const Matrix& nu)
+    Matrix6
+    AUVModel::computeD(const Vector6& nu) const
     {
       double u = nu(0);
       double v = nu(1);
@@ -159,9 +197,9 @@ namespace DUNE
       double r = nu(5);
 
       // initialize linear drag matrix with diagonal terms
-      Matrix dl = Matrix(&m_ldrag(0), 6);
+      Matrix6 dl = Matrix6::diagonal(m_ldrag.begin());
       // initialize quadratic drag matrix
-      Matrix dq = Matrix(6);
+      Matrix6 dq;
 
       // linear drag coupling terms
       dl(1, 5) = m_ldrag(6);
@@ -186,10 +224,10 @@ namespace DUNE
     }
 
     //! Routine to compute lift forces matrix
-    Matrix
-    AUVModel::computeL(const Matrix& nu)
+    Matrix6
+    AUVModel::computeL(const Vector6& nu) const
     {
-      Matrix lift(6, 6, 0.0);
+      Matrix6 lift;
 
       lift(1, 1) = m_lift(0);
       lift(2, 2) = m_lift(1);
@@ -204,8 +242,8 @@ namespace DUNE
     }
 
     //! Routine to compute vector of restoring forces g
-    Matrix
-    AUVModel::computeG(const Matrix& eta)
+    Vector6
+    AUVModel::computeG(const Vector6& eta) const
     {
       double phi = eta(3);
       double theta = eta(4);
@@ -221,14 +259,14 @@ namespace DUNE
         -m_cog(0) * W * cos(theta) * sin(phi) - m_cog(1) * W * sin(theta)
       };
 
-      return Matrix(g, 6, 1);
+      return Vector6(g);
     }
 
-    Matrix
-    AUVModel::computeTau(double speed_u, double thruster_act, const Matrix& servo_pos)
+    Vector6
+    AUVModel::computeTau(double speed_u, double thruster_act, const Matrix& servo_pos) const
     {
-      Matrix tau(6, 1, 0.0);
-      Matrix deflections(3, 1, 0.0);
+      Vector6 tau;
+      Vector3 deflections;
 
       deflections(0) = servo_pos(3) - servo_pos(0) + servo_pos(1) - servo_pos(2);
       deflections(1) = servo_pos(1) + servo_pos(2);
@@ -73,10 +73,18 @@ namespace DUNE
       Math::Matrix
       step(const Math::Matrix& nu_dot, const Math::Matrix& nu, const Math::Matrix& eta);
 
+      //! Routine to compute the next step
+      Math::Vector6
+      step(const Math::Vector6& nu_dot, const Math::Vector6& nu, const Math::Vector6& eta) const;
+
       //! Routine to compute the next step, yet compute the acceleration instead of forces
       Math::Matrix
       stepInv(const Math::Matrix& tau, const Math::Matrix& nu, const Math::Matrix& eta);
 
+      //! Routine to compute the next step, yet compute the acceleration instead of forces
+      Math::Vector6
+      stepInv(const Math::Vector6& tau, const Math::Vector6& nu, const Math::Vector6& eta) const;
+
       //! Routine to compute the next step, yet compute the acceleration instead of forces
       //! this time using fin deflections and xyz forces
       Math::Matrix
@@ -110,28 +118,28 @@ namespace DUNE
 
     private:
       //! Computes added mass and inertia
-      Math::Matrix
-      computeM(void);
+      Math::Matrix6
+      computeM(void) const;
 
       //! Computes quadratic damping matrix
-      Math::Matrix
-      computeD(const Math::Matrix& nu);
+      Math::Matrix6
+      computeD(const Math::Vector6& nu) const;
 
       //! Computes lift matrix
-      Math::Matrix
-      computeL(const Math::Matrix& nu);
+      Math::Matrix6
+      computeL(const Math::Vector6& nu) const;
 
       //! Computes vector of restoring forces g
-      Math::Matrix
-      computeG(const Math::Matrix& eta);
+      Math::Vector6
+      computeG(const Math::Vector6& eta) const;
 
       //! Computes rigid body coriolis and centripetal matrix
-      Math::Matrix
-      computeC(const Math::Matrix& nu);
+      Math::Matrix6
+      computeC(const Math::Vector6& nu) const;
 
       //! Compute the resulting tau using thruster actuation and servo positions
-      Math::Matrix
-      computeTau(double speed_u, double thruster_act, const Math::Matrix& servo_pos);
+      Math::Vector6
+      computeTau(double speed_u, double thruster_act, const Math::Matrix& servo_pos) const;
 
       //! Members
       //! Model's mass
@@ -145,21 +153,23 @@ namespace DUNE
       //! Model's max thrust force
       double m_max_thrust;
       //! Center of gravity's coordinates
-      Math::Matrix m_cog;
+      Math::Vector3 m_cog;
       //! Added mass coeficients
-      Math::Matrix m_addedmass;
+      Math::Vector6 m_addedmass;
       //! Intertia coeficients
-      Math::Matrix m_inertia;
+      Math::Vector3 m_inertia;
       //! Model's matrix of mass moments and added inertia
-      Math::Matrix m_matrix_mass;
+      Math::Matrix6 m_matrix_mass;
+      //! Inverse of the matrix of mass moments and added inertia
+      Math::Matrix6 m_matrix_mass_inv;
       //! Model's linear damping coefficients
-      Math::Matrix m_ldrag;
+      Math::MatrixN<10, 1> m_ldrag;
       //! Model's quadratic drag
-      Math::Matrix m_qdrag;
+      Math::MatrixN<10, 1> m_qdrag;
       //! Model's lift coefficients
-      Math::Matrix m_lift;
+      Math::MatrixN<8, 1> m_lift;
       //! Model's fin lift coefficients
-      Math::Matrix m_fin_lift;
+      Math::MatrixN<5, 1> m_fin_lift;
     };
   }
 }
@@ -38,6 +38,7 @@
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Math/MatrixN.hpp>
 
 namespace DUNE
 {
@@ -121,6 +122,34 @@ namespace DUNE
         *vy = spsi * ctheta * u + t6 * t4 + t3 * cphi + t11 * t9 - t8 * sphi;
         *vz = -stheta * u + ctheta * sphi * v + ctheta * cphi * w;
       }
+
+      //! Inertial to body frame conversion of a vector.
+      //! @param phi roll angle
+      //! @param theta pitch angle
+      //! @param psi yaw angle
+      //! @param in vector in the inertial frame
+      //! @return vector in the body-fixed frame
+      static Math::Vector3
+      toBodyFrame(double phi, double theta, double psi, const Math::Vector3& in)
+      {
+        Math::Vector3 out;
+        toBodyFrame(phi, theta, psi, in(0), in(1), in(2), &out(0), &out(1), &out(2));
+        return out;
+      }
+
+      //! Body to inertial frame conversion of a vector.
+      //! @param phi roll angle
+      //! @param theta pitch angle
+      //! @param psi yaw angle
+      //! @param in vector in the body-fixed frame
+      //! @return vector in the inertial frame
+      static Math::Vector3
+      toInertialFrame(double phi, double theta, double psi, const Math::Vector3& in)
+      {
+        Math::Vector3 out;
+        toInertialFrame(phi, theta, psi, in(0), in(1), in(2), &out(0), &out(1), &out(2));
+        return out;
+      }
     };
   }
 }
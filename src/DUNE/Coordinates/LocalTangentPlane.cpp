@@ -0,0 +1,160 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Coordinates/LocalTangentPlane.hpp>
+#include <DUNE/Coordinates/WGS84.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    LocalTangentPlane::LocalTangentPlane(void)
+    {
+      setOrigin(0.0, 0.0, 0.0);
+    }
+
+    LocalTangentPlane::LocalTangentPlane(double lat, double lon, double hae)
+    {
+      setOrigin(lat, lon, hae);
+    }
+
+    void
+    LocalTangentPlane::setOrigin(double lat, double lon, double hae)
+    {
+      m_lat = lat;
+      m_lon = lon;
+      m_hae = hae;
+
+      WGS84::toECEF(lat, lon, hae, &m_ecef[0], &m_ecef[1], &m_ecef[2]);
+
+      double slat = std::sin(lat);
+      double clat = std::cos(lat);
+      double slon = std::sin(lon);
+      double clon = std::cos(lon);
+
+      // North.
+      m_to_ned[0] = -slat * clon;
+      m_to_ned[1] = -slat * slon;
+      m_to_ned[2] = clat;
+      // East.
+      m_to_ned[3] = -slon;
+      m_to_ned[4] = clon;
+      m_to_ned[5] = 0.0;
+      // Down.
+      m_to_ned[6] = -clat * clon;
+      m_to_ned[7] = -clat * slon;
+      m_to_ned[8] = -slat;
+
+      // Displacements are applied along the geocentric (or
+      // ellipsoidal) normal, as in WGS84::displace().
+      double p = std::sqrt(m_ecef[0] * m_ecef[0] + m_ecef[1] * m_ecef[1]);
+#if defined(DUNE_ELLIPSOIDAL_DISPLACE)
+      double N = c_wgs84_a / std::sqrt(1 - c_wgs84_e2 * slat * slat);
+      double phi = std::atan2(m_ecef[2], p * (1 - c_wgs84_e2 * N / (N + hae)));
+#else
+      double phi = std::atan2(m_ecef[2], p);
+#endif
+      double sphi = std::sin(phi);
+      double cphi = std::cos(phi);
+
+      m_from_ned[0] = -clon * sphi;
+      m_from_ned[1] = -slon;
+      m_from_ned[2] = -clon * cphi;
+      m_from_ned[3] = -slon * sphi;
+      m_from_ned[4] = clon;
+      m_from_ned[5] = -slon * cphi;
+      m_from_ned[6] = cphi;
+      m_from_ned[7] = 0.0;
+      m_from_ned[8] = -sphi;
+    }
+
+    void
+    LocalTangentPlane::toNED(double lat, double lon, double hae, double* n, double* e, double* d) const
+    {
+      toNED(&lat, &lon, &hae, n, e, d, 1);
+    }
+
+    void
+    LocalTangentPlane::toNED(const double* lat, const double* lon, const double* hae,
+                             double* n, double* e, double* d, size_t count) const
+    {
+      const double* r = m_to_ned;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        double x;
+        double y;
+        double z;
+        WGS84::toECEF(lat[i], lon[i], (hae == NULL) ? 0.0 : hae[i], &x, &y, &z);
+
+        x -= m_ecef[0];
+        y -= m_ecef[1];
+        z -= m_ecef[2];
+
+        n[i] = r[0] * x + r[1] * y + r[2] * z;
+        e[i] = r[3] * x + r[4] * y;
+
+        if (d != NULL)
+          d[i] = r[6] * x + r[7] * y + r[8] * z;
+      }
+    }
+
+    void
+    LocalTangentPlane::fromNED(double n, double e, double d, double* lat, double* lon, double* hae) const
+    {
+      fromNED(&n, &e, &d, lat, lon, hae, 1);
+    }
+
+    void
+    LocalTangentPlane::fromNED(const double* n, const double* e, const double* d,
+                               double* lat, double* lon, double* hae, size_t count) const
+    {
+      const double* r = m_from_ned;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        double dn = n[i];
+        double de = e[i];
+        double dd = (d == NULL) ? 0.0 : d[i];
+
+        double x = m_ecef[0] + r[0] * dn + r[1] * de + r[2] * dd;
+        double y = m_ecef[1] + r[3] * dn + r[4] * de + r[5] * dd;
+        double z = m_ecef[2] + r[6] * dn + r[8] * dd;
+
+        double h;
+        WGS84::fromECEF(x, y, z, &lat[i], &lon[i], &h);
+
+        if (hae != NULL)
+          hae[i] = h;
+      }
+    }
+  }
+}
@@ -0,0 +1,159 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_COORDINATES_LOCAL_TANGENT_PLANE_HPP_INCLUDED_
+#define DUNE_COORDINATES_LOCAL_TANGENT_PLANE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LocalTangentPlane;
+
+    //! North-East-Down frame anchored at a fixed WGS-84 origin. The
+    //! origin's ECEF position and rotation are computed once, making
+    //! repeated conversions around the same origin cheaper than
+    //! calling WGS84::displacement() and WGS84::displace() with the
+    //! same reference. Results are the same as those routines.
+    class LocalTangentPlane
+    {
+    public:
+      //! Constructor.
+      LocalTangentPlane(void);
+
+      //! Constructor.
+      //! @param[in] lat origin WGS-84 latitude (rad).
+      //! @param[in] lon origin WGS-84 longitude (rad).
+      //! @param[in] hae origin height above WGS-84 ellipsoid (m).
+      LocalTangentPlane(double lat, double lon, double hae = 0.0);
+
+      //! Set the origin.
+      //! @param[in] lat origin WGS-84 latitude (rad).
+      //! @param[in] lon origin WGS-84 longitude (rad).
+      //! @param[in] hae origin height above WGS-84 ellipsoid (m).
+      void
+      setOrigin(double lat, double lon, double hae = 0.0);
+
+      //! Get origin latitude.
+      //! @return WGS-84 latitude (rad).
+      double
+      getLatitude(void) const
+      {
+        return m_lat;
+      }
+
+      //! Get origin longitude.
+      //! @return WGS-84 longitude (rad).
+      double
+      getLongitude(void) const
+      {
+        return m_lon;
+      }
+
+      //! Get origin height.
+      //! @return height above WGS-84 ellipsoid (m).
+      double
+      getHeight(void) const
+      {
+        return m_hae;
+      }
+
+      //! Compute the North-East-Down displacement of a WGS-84
+      //! coordinate relative to the origin.
+      //! @param[in] lat WGS-84 latitude (rad).
+      //! @param[in] lon WGS-84 longitude (rad).
+      //! @param[in] hae height above WGS-84 ellipsoid (m).
+      //! @param[out] n North offset (m).
+      //! @param[out] e East offset (m).
+      //! @param[out] d Down offset (m), may be NULL.
+      void
+      toNED(double lat, double lon, double hae, double* n, double* e, double* d = NULL) const;
+
+      //! Compute the North-East-Down displacement of several WGS-84
+      //! coordinates relative to the origin.
+      //! @param[in] lat WGS-84 latitudes (rad).
+      //! @param[in] lon WGS-84 longitudes (rad).
+      //! @param[in] hae heights above WGS-84 ellipsoid (m), may be NULL
+      //!            for zero height.
+      //! @param[out] n North offsets (m).
+      //! @param[out] e East offsets (m).
+      //! @param[out] d Down offsets (m), may be NULL.
+      //! @param[in] count number of coordinates.
+      void
+      toNED(const double* lat, const double* lon, const double* hae,
+            double* n, double* e, double* d, size_t count) const;
+
+      //! Displace the origin in the NED frame.
+      //! @param[in] n North offset (m).
+      //! @param[in] e East offset (m).
+      //! @param[in] d Down offset (m).
+      //! @param[out] lat displaced WGS-84 latitude (rad).
+      //! @param[out] lon displaced WGS-84 longitude (rad).
+      //! @param[out] hae displaced height above WGS-84 ellipsoid (m),
+      //!             may be NULL.
+      void
+      fromNED(double n, double e, double d, double* lat, double* lon, double* hae = NULL) const;
+
+      //! Displace the origin in the NED frame by several offsets.
+      //! @param[in] n North offsets (m).
+      //! @param[in] e East offsets (m).
+      //! @param[in] d Down offsets (m), may be NULL for zero offset.
+      //! @param[out] lat displaced WGS-84 latitudes (rad).
+      //! @param[out] lon displaced WGS-84 longitudes (rad).
+      //! @param[out] hae displaced heights above WGS-84 ellipsoid (m),
+      //!             may be NULL.
+      //! @param[in] count number of offsets.
+      void
+      fromNED(const double* n, const double* e, const double* d,
+              double* lat, double* lon, double* hae, size_t count) const;
+
+    private:
+      //! Origin latitude.
+      double m_lat;
+      //! Origin longitude.
+      double m_lon;
+      //! Origin height.
+      double m_hae;
+      //! Origin ECEF coordinates.
+      double m_ecef[3];
+      //! ECEF to NED rotation (rows are North, East and Down).
+      double m_to_ned[9];
+      //! NED to ECEF rotation used for displacements (columns are
+      //! North, East and Down).
+      double m_from_ned[9];
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,54 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Coordinates/WGS84.hpp>
+#include <DUNE/Coordinates/LocalTangentPlane.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    void
+    WGS84::displacement(double rlat, double rlon, double rhae,
+                        const double* lat, const double* lon, const double* hae,
+                        double* n, double* e, double* d, size_t count)
+    {
+      LocalTangentPlane ltp(rlat, rlon, rhae);
+      ltp.toNED(lat, lon, hae, n, e, d, count);
+    }
+
+    void
+    WGS84::displace(double rlat, double rlon, double rhae,
+                    const double* n, const double* e, const double* d,
+                    double* lat, double* lon, double* hae, size_t count)
+    {
+      LocalTangentPlane ltp(rlat, rlon, rhae);
+      ltp.fromNED(n, e, d, lat, lon, hae, count);
+    }
+  }
+}
@@ -339,12 +339,51 @@ namespace DUNE
         double p = std::sqrt(x * x + y * y);
         *lon = std::atan2(y, x);
         double theta = std::atan2(c_wgs84_a * z, p * c_wgs84_b);
-        double num = z + c_wgs84_ep2 * c_wgs84_b * std::pow(std::sin(theta), 3.0);
-        double den = p - c_wgs84_e2 * c_wgs84_a * std::pow(std::cos(theta), 3.0);
+        double st = std::sin(theta);
+        double ct = std::cos(theta);
+        double num = z + c_wgs84_ep2 * c_wgs84_b * st * st * st;
+        double den = p - c_wgs84_e2 * c_wgs84_a * ct * ct * ct;
         *lat = std::atan2(num, den);
         *hae = p / std::cos(*lat) - computeRn(*lat);
       }
 
+      //! Compute North-East-Down displacements of several WGS-84
+      //! coordinates relative to one reference. See
+      //! LocalTangentPlane for repeated calls with the same reference.
+      //!
+      //! @param[in] rlat reference WGS-84 latitude (rad).
+      //! @param[in] rlon reference WGS-84 longitude (rad).
+      //! @param[in] rhae reference WGS-84 coordinate height (m).
+      //! @param[in] lat WGS-84 latitudes (rad).
+      //! @param[in] lon WGS-84 longitudes (rad).
+      //! @param[in] hae heights (m), may be NULL for zero height.
+      //! @param[out] n North offsets (m).
+      //! @param[out] e East offsets (m).
+      //! @param[out] d Down offsets (m), may be NULL.
+      //! @param[in] count number of coordinates.
+      static void
+      displacement(double rlat, double rlon, double rhae,
+                   const double* lat, const double* lon, const double* hae,
+                   double* n, double* e, double* d, size_t count);
+
+      //! Displace one WGS-84 coordinate by several NED offsets. See
+      //! LocalTangentPlane for repeated calls with the same reference.
+      //!
+      //! @param[in] rlat reference WGS-84 latitude (rad).
+      //! @param[in] rlon reference WGS-84 longitude (rad).
+      //! @param[in] rhae reference WGS-84 coordinate height (m).
+      //! @param[in] n North offsets (m).
+      //! @param[in] e East offsets (m).
+      //! @param[in] d Down offsets (m), may be NULL for zero offset.
+      //! @param[out] lat displaced WGS-84 latitudes (rad).
+      //! @param[out] lon displaced WGS-84 longitudes (rad).
+      //! @param[out] hae displaced heights (m), may be NULL.
+      //! @param[in] count number of offsets.
+      static void
+      displace(double rlat, double rlon, double rhae,
+               const double* n, const double* e, const double* d,
+               double* lat, double* lon, double* hae, size_t count);
+
     private:
       //! Compute the radius of curvature in the prime vertical (Rn).
       //!
@@ -50,6 +50,9 @@ namespace DUNE
 #include <DUNE/IMC/Exceptions.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 #include <DUNE/IMC/Blob.hpp>
+#include <DUNE/IMC/LogSegment.hpp>
+#include <DUNE/IMC/LogRecovery.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
 #include <DUNE/IMC/IridiumMessageDefinitions.hpp>
 
 #endif
@@ -122,6 +122,29 @@ namespace DUNE
       }
     }
 
+    unsigned
+    Bus::getBacklog(uint16_t id, Tasks::AbstractTask* task)
+    {
+      unsigned backlog = 0;
+
+      Concurrency::ScopedRWLock l(m_lock);
+      std::map<uint16_t, TransportList>::iterator itr = m_recipients.find(id);
+      if (itr == m_recipients.end())
+        return 0;
+
+      for (TransportList::iterator t = itr->second.begin(); t != itr->second.end(); ++t)
+      {
+        if (*t == task)
+          continue;
+
+        unsigned size = (*t)->getQueueSize();
+        if (size > backlog)
+          backlog = size;
+      }
+
+      return backlog;
+    }
+
     void
     Bus::resume(void)
     {
@@ -85,6 +85,15 @@ namespace DUNE
       void
       dispatch(const Message* msg, Tasks::AbstractTask* task = NULL);
 
+      //! Retrieve the largest number of messages waiting to be
+      //! consumed by the recipients of a given message identification
+      //! number. This can be used by producers to pace themselves.
+      //! @param id message identification number.
+      //! @param task ignore the queue of this task.
+      //! @return largest number of queued messages.
+      unsigned
+      getBacklog(uint16_t id, Tasks::AbstractTask* task = NULL);
+
       inline void
       pause(void)
       {
@@ -0,0 +1,296 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Compression/Decompressor.hpp>
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/LogSegment.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/Serialization.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Index file magic.
+    static const char c_magic[] = {'L', 'I', 'D', 'X'};
+    //! Size of index file header.
+    static const unsigned c_header_size = 16;
+    //! Size of serialized entries.
+    static const unsigned c_entry_size = 16;
+    //! Size of read/decompression chunks.
+    static const size_t c_chunk_size = 256 * 1024;
+
+    //! Retrieve the size of a file.
+    static uint64_t
+    getFileSize(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      if (!ifs.is_open())
+        return 0;
+
+      ifs.seekg(0, std::ios::end);
+      return ifs.tellg();
+    }
+
+    //! Compare entry time.
+    static bool
+    compareTime(double time, const LogIndex::Entry& entry)
+    {
+      return time < entry.time;
+    }
+
+    std::string
+    LogIndex::getIndexPath(const std::string& lsf)
+    {
+      return lsf + ".idx";
+    }
+
+    void
+    LogIndex::open(const std::string& lsf, double interval)
+    {
+      if (load(lsf))
+        return;
+
+      build(lsf, interval);
+
+      try
+      {
+        save(lsf);
+      }
+      catch (...)
+      {
+        // Read-only media: keep the index in memory only.
+      }
+    }
+
+    bool
+    LogIndex::load(const std::string& lsf)
+    {
+      m_entries.clear();
+
+      uint64_t fsize = getFileSize(lsf);
+
+      std::ifstream ifs(getIndexPath(lsf).c_str(), std::ios::binary);
+      if (ifs.is_open())
+      {
+        uint8_t hdr[c_header_size];
+        if (ifs.read((char*)hdr, c_header_size) && std::memcmp(hdr, c_magic, sizeof(c_magic)) == 0)
+        {
+          uint64_t size = 0;
+          uint32_t count = 0;
+          Utils::ByteCopy::copy(size, hdr + 4);
+          Utils::ByteCopy::copy(count, hdr + 12);
+
+          if (size == fsize)
+          {
+            uint8_t bfr[c_entry_size];
+            for (uint32_t i = 0; i < count && ifs.read((char*)bfr, c_entry_size); ++i)
+            {
+              Entry entry;
+              Utils::ByteCopy::copy(entry.time, bfr);
+              Utils::ByteCopy::copy(entry.offset, bfr + 8);
+              m_entries.push_back(entry);
+            }
+
+            if (m_entries.size() == count)
+              return true;
+          }
+        }
+      }
+
+      m_entries.clear();
+
+      // Fall back to the segment index written by the logger.
+      std::vector<LogSegment> segments;
+      LogSegment::load(LogSegment::getIndexPath(lsf), segments);
+
+      for (size_t i = 0; i < segments.size(); ++i)
+      {
+        if (segments[i].count == 0 || segments[i].offset + segments[i].size > fsize)
+          break;
+
+        if (!m_entries.empty() && segments[i].begin < m_entries.back().time)
+          continue;
+
+        Entry entry;
+        entry.time = segments[i].begin;
+        entry.offset = segments[i].offset;
+        m_entries.push_back(entry);
+      }
+
+      return !m_entries.empty();
+    }
+
+    void
+    LogIndex::build(const std::string& lsf, double interval)
+    {
+      m_entries.clear();
+
+      std::ifstream ifs(lsf.c_str(), std::ios::binary);
+      if (!ifs.is_open())
+        return;
+
+      Compression::Methods method = Compression::Factory::detect(lsf.c_str());
+      std::unique_ptr<Compression::Decompressor> dec;
+      if (method != Compression::METHOD_UNKNOWN)
+        dec.reset(Compression::Factory::decompressor(method));
+
+      std::vector<char> in(c_chunk_size);
+      std::vector<char> out(c_chunk_size);
+      // Decoded data not yet parsed.
+      std::vector<char> raw;
+      // Offset of the first byte of 'raw' in the decoded stream.
+      uint64_t raw_offset = 0;
+      // Offset of the next byte to decode.
+      uint64_t src_offset = 0;
+      // Start of compressed streams: decoded offset -> file offset.
+      std::vector<std::pair<uint64_t, uint64_t> > starts;
+      starts.push_back(std::make_pair(0, 0));
+      size_t next_start = 0;
+      double last = 0;
+
+      try
+      {
+        while (ifs)
+        {
+          ifs.read(&in[0], in.size());
+          size_t len = ifs.gcount();
+          size_t idx = 0;
+
+          if (!dec)
+          {
+            raw.insert(raw.end(), in.begin(), in.begin() + len);
+          }
+
+          while (dec && idx < len)
+          {
+            dec->decompress(&out[0], out.size(), &in[idx], len - idx);
+            raw.insert(raw.end(), out.begin(), out.begin() + dec->decompressed());
+            idx += dec->processed();
+
+            if (dec->streamEnded())
+              starts.push_back(std::make_pair(raw_offset + raw.size(), src_offset + idx));
+
+            if (dec->processed() == 0 && dec->decompressed() == 0)
+              break;
+          }
+
+          src_offset += len;
+
+          // Parse complete packets.
+          size_t pos = 0;
+          while (raw.size() - pos >= DUNE_IMC_CONST_HEADER_SIZE)
+          {
+            Header hdr;
+            Packet::deserializeHeader(hdr, (uint8_t*)&raw[pos], DUNE_IMC_CONST_HEADER_SIZE);
+
+            size_t total = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+            if (raw.size() - pos < total)
+              break;
+
+            uint64_t packet = raw_offset + pos;
+            bool seekable = !dec;
+            uint64_t offset = packet;
+
+            while (dec && next_start < starts.size() && starts[next_start].first < packet)
+              ++next_start;
+
+            if (dec && next_start < starts.size() && starts[next_start].first == packet)
+            {
+              seekable = true;
+              offset = starts[next_start].second;
+            }
+
+            if (seekable && (m_entries.empty() || hdr.timestamp >= last + interval))
+            {
+              Entry entry;
+              entry.time = hdr.timestamp;
+              entry.offset = offset;
+              m_entries.push_back(entry);
+              last = hdr.timestamp;
+            }
+
+            pos += total;
+          }
+
+          raw.erase(raw.begin(), raw.begin() + pos);
+          raw_offset += pos;
+        }
+      }
+      catch (std::exception&)
+      {
+        // Damaged data: keep entries found so far.
+      }
+    }
+
+    void
+    LogIndex::save(const std::string& lsf) const
+    {
+      std::string path = getIndexPath(lsf);
+      std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+      if (!ofs.is_open())
+        throw std::runtime_error("unable to create " + path);
+
+      uint8_t hdr[c_header_size];
+      std::memcpy(hdr, c_magic, sizeof(c_magic));
+      IMC::serialize(getFileSize(lsf), hdr + 4);
+      IMC::serialize((uint32_t)m_entries.size(), hdr + 12);
+      ofs.write((char*)hdr, c_header_size);
+
+      uint8_t bfr[c_entry_size];
+      for (size_t i = 0; i < m_entries.size(); ++i)
+      {
+        IMC::serialize(m_entries[i].time, bfr);
+        IMC::serialize(m_entries[i].offset, bfr + 8);
+        ofs.write((char*)bfr, c_entry_size);
+      }
+    }
+
+    uint64_t
+    LogIndex::find(double time) const
+    {
+      std::vector<Entry>::const_iterator itr = std::upper_bound(m_entries.begin(), m_entries.end(),
+                                                                time, compareTime);
+      if (itr == m_entries.begin())
+        return 0;
+
+      return (itr - 1)->offset;
+    }
+  }
+}
@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+#define DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogIndex;
+
+    //! Time index of an LSF file. Each entry maps a timestamp to the
+    //! offset of a packet in the (possibly compressed) file from
+    //! which reading can start, allowing readers to seek without
+    //! decoding all preceding data. For compressed files, entries
+    //! are only placed at the start of compressed streams that begin
+    //! with a complete packet.
+    class LogIndex
+    {
+    public:
+      //! Index entry.
+      struct Entry
+      {
+        //! Timestamp of the first packet.
+        fp64_t time;
+        //! Offset in the LSF file.
+        uint64_t offset;
+      };
+
+      //! Constructor.
+      LogIndex(void)
+      { }
+
+      //! Load the cached index of an LSF file, building and caching
+      //! it if it does not exist or is outdated. Segment indexes
+      //! written by the logger are used when available.
+      //! @param[in] lsf path to LSF file.
+      //! @param[in] interval minimum time between index entries.
+      void
+      open(const std::string& lsf, double interval = 1.0);
+
+      //! Load the cached index of an LSF file.
+      //! @param[in] lsf path to LSF file.
+      //! @return true if a valid index was loaded, false otherwise.
+      bool
+      load(const std::string& lsf);
+
+      //! Build the index of an LSF file by decoding it.
+      //! @param[in] lsf path to LSF file.
+      //! @param[in] interval minimum time between index entries.
+      void
+      build(const std::string& lsf, double interval);
+
+      //! Write the index next to the LSF file.
+      //! @param[in] lsf path to LSF file.
+      void
+      save(const std::string& lsf) const;
+
+      //! Find the offset from which to read in order to obtain all
+      //! packets with timestamps greater or equal to a given time.
+      //! @param[in] time timestamp.
+      //! @return offset in the LSF file.
+      uint64_t
+      find(double time) const;
+
+      //! Retrieve index entries.
+      //! @return index entries, sorted by offset.
+      const std::vector<Entry>&
+      getEntries(void) const
+      {
+        return m_entries;
+      }
+
+      //! Retrieve the path of the cached index of a given LSF file.
+      //! @param[in] lsf path to LSF file.
+      //! @return path to index file.
+      static std::string
+      getIndexPath(const std::string& lsf);
+
+    private:
+      //! Index entries.
+      std::vector<Entry> m_entries;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,244 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Algorithms/CRC32.hpp>
+#include <DUNE/Compression/Compressor.hpp>
+#include <DUNE/Compression/Decompressor.hpp>
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/LogRecovery.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/Packet.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Size of decompression chunks.
+    static const size_t c_chunk_size = 256 * 1024;
+
+    //! Read a region of a file.
+    static void
+    readRegion(std::ifstream& ifs, uint64_t offset, uint64_t size, std::vector<char>& data)
+    {
+      data.resize(size);
+      ifs.clear();
+      ifs.seekg(offset);
+
+      if (size > 0)
+      {
+        ifs.read(&data[0], size);
+        data.resize(ifs.gcount());
+      }
+    }
+
+    //! Decode (possibly compressed) LSF data, stopping at the first
+    //! decompression error.
+    //! @return true if all data was decoded, false otherwise.
+    static bool
+    decode(Compression::Methods method, std::vector<char>& src, std::vector<char>& dst)
+    {
+      dst.clear();
+
+      if (method == Compression::METHOD_UNKNOWN)
+      {
+        dst = src;
+        return true;
+      }
+
+      std::unique_ptr<Compression::Decompressor> dec(Compression::Factory::decompressor(method));
+      std::vector<char> chunk(c_chunk_size);
+      size_t idx = 0;
+
+      try
+      {
+        while (idx < src.size())
+        {
+          dec->decompress(&chunk[0], chunk.size(), &src[idx], src.size() - idx);
+          dst.insert(dst.end(), chunk.begin(), chunk.begin() + dec->decompressed());
+          idx += dec->processed();
+
+          if (dec->processed() == 0 && dec->decompressed() == 0)
+            return false;
+        }
+      }
+      catch (std::exception&)
+      {
+        return false;
+      }
+
+      return true;
+    }
+
+    size_t
+    LogRecovery::salvage(const uint8_t* data, size_t size, LogSegment& segment)
+    {
+      size_t idx = 0;
+
+      while (size - idx >= DUNE_IMC_CONST_HEADER_SIZE)
+      {
+        try
+        {
+          Header hdr;
+          Packet::deserializeHeader(hdr, data + idx, DUNE_IMC_CONST_HEADER_SIZE);
+
+          size_t total = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+          if (total > DUNE_IMC_CONST_MAX_SIZE || idx + total > size)
+            break;
+
+          delete Packet::deserialize(data + idx, total);
+          segment.update(data + idx, total);
+          idx += total;
+        }
+        catch (std::exception&)
+        {
+          break;
+        }
+      }
+
+      return idx;
+    }
+
+    LogRecovery::Result
+    LogRecovery::recover(const std::string& input, const std::string& output)
+    {
+      Result result;
+      result.segments = 0;
+      result.verified = 0;
+      result.salvaged = 0;
+      result.discarded = 0;
+
+      Compression::Methods method = Compression::Factory::detect(input.c_str());
+
+      std::ifstream ifs(input.c_str(), std::ios::binary);
+      if (!ifs.is_open())
+        throw std::runtime_error("unable to open " + input);
+
+      ifs.seekg(0, std::ios::end);
+      uint64_t fsize = ifs.tellg();
+
+      // Trust indexed segments that are present on disk, verifying
+      // the CRC of the last one since the index may have reached the
+      // disk before the data.
+      std::vector<LogSegment> segments;
+      LogSegment::load(LogSegment::getIndexPath(input), segments);
+
+      while (!segments.empty() && segments.back().offset + segments.back().size > fsize)
+        segments.pop_back();
+
+      std::vector<char> src;
+      std::vector<char> raw;
+      while (!segments.empty())
+      {
+        const LogSegment& last = segments.back();
+        readRegion(ifs, last.offset, last.size, src);
+
+        if (decode(method, src, raw))
+        {
+          uint32_t crc = Algorithms::CRC32::compute((uint8_t*)raw.data(), raw.size(), false);
+          if (crc == last.crc)
+            break;
+        }
+
+        segments.pop_back();
+      }
+
+      if (!segments.empty())
+        result.verified = segments.back().offset + segments.back().size;
+      result.segments = segments.size();
+
+      std::ofstream ofs(output.c_str(), std::ios::binary | std::ios::trunc);
+      if (!ofs.is_open())
+        throw std::runtime_error("unable to open " + output);
+
+      // Copy verified segments.
+      ifs.clear();
+      ifs.seekg(0);
+      uint64_t remaining = result.verified;
+      std::vector<char> chunk(c_chunk_size);
+      while (remaining > 0)
+      {
+        size_t len = remaining < chunk.size() ? remaining : chunk.size();
+        ifs.read(&chunk[0], len);
+        ofs.write(&chunk[0], ifs.gcount());
+        remaining -= ifs.gcount();
+
+        if (ifs.gcount() == 0)
+          break;
+      }
+
+      // Salvage complete packets from the damaged tail.
+      readRegion(ifs, result.verified, fsize - result.verified, src);
+      decode(method, src, raw);
+
+      LogSegment tail;
+      tail.offset = result.verified;
+      size_t valid = salvage((uint8_t*)raw.data(), raw.size(), tail);
+      result.salvaged = tail.count;
+      result.discarded = raw.size() - valid;
+
+      if (valid > 0)
+      {
+        if (method == Compression::METHOD_UNKNOWN)
+        {
+          ofs.write(&raw[0], valid);
+          tail.size = valid;
+        }
+        else
+        {
+          std::unique_ptr<Compression::Compressor> com(Compression::Factory::compressor(method));
+          Utils::ByteBuffer bfr;
+          com->compress(bfr, &raw[0], valid);
+          ofs.write(bfr.getBufferSigned(), bfr.getSize());
+          tail.size = bfr.getSize();
+        }
+      }
+
+      ofs.close();
+
+      // Write index of recovered file.
+      std::string index = LogSegment::getIndexPath(output);
+      std::remove(index.c_str());
+
+      for (size_t i = 0; i < segments.size(); ++i)
+        LogSegment::append(index, segments[i]);
+
+      if (tail.count > 0)
+        LogSegment::append(index, tail);
+
+      return result;
+    }
+  }
+}
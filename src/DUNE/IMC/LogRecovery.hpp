@@ -0,0 +1,87 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_RECOVERY_HPP_INCLUDED_
+#define DUNE_IMC_LOG_RECOVERY_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/LogSegment.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogRecovery;
+
+    //! Recovery of damaged (e.g., truncated by a power failure) LSF
+    //! files. Segments listed in the index file are trusted and
+    //! copied verbatim, only the data after the last indexed segment
+    //! is decoded and scanned for complete packets.
+    class LogRecovery
+    {
+    public:
+      //! Recovery results.
+      struct Result
+      {
+        //! Number of indexed segments copied verbatim.
+        unsigned segments;
+        //! Number of bytes copied verbatim.
+        uint64_t verified;
+        //! Number of messages salvaged from the damaged tail.
+        unsigned salvaged;
+        //! Number of bytes of the damaged tail that were discarded.
+        uint64_t discarded;
+      };
+
+      //! Recover an LSF file. A new index file is written next to the
+      //! output file.
+      //! @param[in] input damaged LSF file (compressed or not).
+      //! @param[in] output recovered LSF file.
+      //! @return recovery results.
+      static Result
+      recover(const std::string& input, const std::string& output);
+
+      //! Find the longest prefix of raw LSF data made of complete and
+      //! valid packets.
+      //! @param[in] data raw LSF data.
+      //! @param[in] size size of raw LSF data.
+      //! @param[out] segment accounts for the valid packets.
+      //! @return size of the valid prefix.
+      static size_t
+      salvage(const uint8_t* data, size_t size, LogSegment& segment);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,154 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <fstream>
+
+// DUNE headers.
+#include <DUNE/Algorithms/CRC32.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/LogSegment.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/Serialization.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Footer magic.
+    static const uint8_t c_magic[] = {'L', 'S', 'E', 'G'};
+    //! Size of footer data protected by the footer CRC.
+    static const unsigned c_data_size = LogSegment::c_size - sizeof(uint32_t);
+
+    LogSegment::LogSegment(void):
+      offset(0),
+      size(0)
+    {
+      clear();
+    }
+
+    void
+    LogSegment::clear(void)
+    {
+      count = 0;
+      begin = 0;
+      end = 0;
+      crc = 0;
+    }
+
+    void
+    LogSegment::update(const uint8_t* bfr, size_t bfr_len)
+    {
+      Header hdr;
+      Packet::deserializeHeader(hdr, bfr, bfr_len);
+
+      if (count == 0)
+        begin = hdr.timestamp;
+
+      end = hdr.timestamp;
+      crc = Algorithms::CRC32::compute(bfr, bfr_len, false, crc);
+      ++count;
+    }
+
+    void
+    LogSegment::serialize(uint8_t* bfr) const
+    {
+      std::memcpy(bfr, c_magic, sizeof(c_magic));
+      IMC::serialize(count, bfr + 4);
+      IMC::serialize(begin, bfr + 8);
+      IMC::serialize(end, bfr + 16);
+      IMC::serialize(offset, bfr + 24);
+      IMC::serialize(size, bfr + 32);
+      IMC::serialize(crc, bfr + 40);
+
+      uint32_t fcrc = Algorithms::CRC32::compute(bfr, c_data_size, false);
+      IMC::serialize(fcrc, bfr + c_data_size);
+    }
+
+    bool
+    LogSegment::deserialize(const uint8_t* bfr)
+    {
+      if (std::memcmp(bfr, c_magic, sizeof(c_magic)) != 0)
+        return false;
+
+      uint32_t fcrc = 0;
+      Utils::ByteCopy::copy(fcrc, bfr + c_data_size);
+      if (fcrc != Algorithms::CRC32::compute(bfr, c_data_size, false))
+        return false;
+
+      Utils::ByteCopy::copy(count, bfr + 4);
+      Utils::ByteCopy::copy(begin, bfr + 8);
+      Utils::ByteCopy::copy(end, bfr + 16);
+      Utils::ByteCopy::copy(offset, bfr + 24);
+      Utils::ByteCopy::copy(size, bfr + 32);
+      Utils::ByteCopy::copy(crc, bfr + 40);
+      return true;
+    }
+
+    std::string
+    LogSegment::getIndexPath(const std::string& lsf)
+    {
+      return lsf + ".seg";
+    }
+
+    void
+    LogSegment::append(const std::string& index, const LogSegment& segment)
+    {
+      uint8_t bfr[c_size];
+      segment.serialize(bfr);
+
+      std::ofstream ofs(index.c_str(), std::ios::binary | std::ios::app);
+      ofs.write((char*)bfr, c_size);
+    }
+
+    void
+    LogSegment::load(const std::string& index, std::vector<LogSegment>& segments)
+    {
+      segments.clear();
+
+      std::ifstream ifs(index.c_str(), std::ios::binary);
+      uint8_t bfr[c_size];
+      uint64_t next = 0;
+
+      while (ifs.read((char*)bfr, c_size))
+      {
+        LogSegment segment;
+        if (!segment.deserialize(bfr))
+          break;
+
+        if (segment.offset != next)
+          break;
+
+        next = segment.offset + segment.size;
+        segments.push_back(segment);
+      }
+    }
+  }
+}
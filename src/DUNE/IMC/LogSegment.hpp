@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_SEGMENT_HPP_INCLUDED_
+#define DUNE_IMC_LOG_SEGMENT_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogSegment;
+
+    //! Footer describing a complete segment of an LSF file. Footers
+    //! are appended to an index file stored next to the LSF file
+    //! every time a segment is closed, allowing readers to locate
+    //! the last valid record without decoding the whole log.
+    class LogSegment
+    {
+    public:
+      //! Size of a serialized footer.
+      static const unsigned c_size = 48;
+      //! Number of messages.
+      uint32_t count;
+      //! Timestamp of the first message.
+      fp64_t begin;
+      //! Timestamp of the last message.
+      fp64_t end;
+      //! Offset of the segment in the (possibly compressed) LSF file.
+      uint64_t offset;
+      //! Size of the segment in the (possibly compressed) LSF file.
+      uint64_t size;
+      //! CRC-32 of the uncompressed segment data.
+      uint32_t crc;
+
+      //! Constructor.
+      LogSegment(void);
+
+      //! Reset message count, time range and CRC.
+      void
+      clear(void);
+
+      //! Account for a serialized packet written to the segment.
+      //! @param[in] bfr packet data.
+      //! @param[in] size packet size.
+      void
+      update(const uint8_t* bfr, size_t size);
+
+      //! Serialize footer.
+      //! @param[out] bfr destination buffer (at least c_size bytes).
+      void
+      serialize(uint8_t* bfr) const;
+
+      //! Deserialize footer.
+      //! @param[in] bfr source buffer (at least c_size bytes).
+      //! @return true if the footer is valid, false otherwise.
+      bool
+      deserialize(const uint8_t* bfr);
+
+      //! Retrieve the path of the index file of a given LSF file.
+      //! @param[in] lsf path to LSF file.
+      //! @return path to index file.
+      static std::string
+      getIndexPath(const std::string& lsf);
+
+      //! Append a footer to an index file.
+      //! @param[in] index path to index file.
+      //! @param[in] segment segment footer.
+      static void
+      append(const std::string& index, const LogSegment& segment);
+
+      //! Load all valid and contiguous footers of an index file.
+      //! Loading stops at the first incomplete or corrupted footer.
+      //! @param[in] index path to index file.
+      //! @param[out] segments segment footers.
+      static void
+      load(const std::string& index, std::vector<LogSegment>& segments);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,131 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/EventHandle.hpp>
+#include <DUNE/System/Error.hpp>
+
+// POSIX headers.
+#if defined(DUNE_OS_POSIX)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+// Linux headers.
+#if defined(DUNE_SYS_HAS_SYS_EVENTFD_H)
+#  include <sys/eventfd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IO
+  {
+    using System::Error;
+
+    EventHandle::EventHandle(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_EVENTFD_H)
+      m_handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (m_handle == -1)
+        throw Error("creating event handle", Error::getLastMessage());
+
+#elif defined(DUNE_OS_POSIX)
+      int fds[2];
+      if (pipe(fds) == -1)
+        throw Error("creating event handle", Error::getLastMessage());
+
+      for (unsigned i = 0; i < 2; ++i)
+      {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+      }
+
+      m_handle = fds[0];
+      m_write = fds[1];
+
+#elif defined(DUNE_OS_WINDOWS)
+      m_handle = CreateEvent(NULL, TRUE, FALSE, NULL);
+      if (m_handle == NULL)
+        throw Error("creating event handle", Error::getLastMessage());
+#endif
+    }
+
+    EventHandle::~EventHandle(void)
+    {
+#if defined(DUNE_OS_POSIX)
+      close(m_handle);
+#  if !defined(DUNE_SYS_HAS_SYS_EVENTFD_H)
+      close(m_write);
+#  endif
+
+#elif defined(DUNE_OS_WINDOWS)
+      CloseHandle(m_handle);
+#endif
+    }
+
+    void
+    EventHandle::signal(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_EVENTFD_H)
+      uint64_t value = 1;
+      // Only fails if the counter would overflow, i.e., if the
+      // handle is already readable.
+      if (write(m_handle, &value, sizeof(value)) < 0)
+        return;
+
+#elif defined(DUNE_OS_POSIX)
+      char c = 0;
+      // Only fails if the pipe is full, i.e., if the handle is
+      // already readable.
+      if (write(m_write, &c, 1) < 0)
+        return;
+
+#elif defined(DUNE_OS_WINDOWS)
+      SetEvent(m_handle);
+#endif
+    }
+
+    void
+    EventHandle::clear(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_EVENTFD_H)
+      uint64_t value = 0;
+      if (read(m_handle, &value, sizeof(value)) < 0)
+        return;
+
+#elif defined(DUNE_OS_POSIX)
+      char bfr[64];
+      while (read(m_handle, bfr, sizeof(bfr)) > 0)
+      { }
+
+#elif defined(DUNE_OS_WINDOWS)
+      ResetEvent(m_handle);
+#endif
+    }
+  }
+}
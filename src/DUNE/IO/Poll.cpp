@@ -29,6 +29,8 @@
 
 // ISO C++ 98 headers.
 #include <algorithm>
+#include <cerrno>
+#include <cmath>
 #include <cstring>
 
 // DUNE headers.
@@ -36,8 +38,18 @@
 #include <DUNE/System/Error.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Utils.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 #include <DUNE/IO/Poll.hpp>
 
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_POLL_H)
+#  include <poll.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
 namespace DUNE
 {
   namespace IO
@@ -45,10 +57,99 @@ namespace DUNE
     using std::memset;
     using System::Error;
 
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+    //! Initial capacity of the event list.
+    static const size_t c_events = 16;
+#endif
+
+    //! Convert a timeout in seconds to milliseconds.
+    static inline int
+    toMilliseconds(double timeout)
+    {
+      if (timeout < 0.0)
+        return -1;
+
+      return (int)std::ceil(timeout * 1000.0);
+    }
+
+    Poll::Poll(void)
+    {
+      setup();
+    }
+
+    Poll::Poll(const Poll& other)
+    {
+      setup();
+
+      for (size_t i = 0; i < other.m_handles.size(); ++i)
+        add(other.m_handles[i], other.m_flags[i]);
+    }
+
+    Poll&
+    Poll::operator=(const Poll& other)
+    {
+      if (this == &other)
+        return *this;
+
+      while (!m_handles.empty())
+        remove(m_handles.back());
+
+      for (size_t i = 0; i < other.m_handles.size(); ++i)
+        add(other.m_handles[i], other.m_flags[i]);
+
+      return *this;
+    }
+
     void
-    Poll::add(const NativeHandle& handle)
+    Poll::setup(void)
     {
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      m_epfd = epoll_create1(EPOLL_CLOEXEC);
+      if (m_epfd == -1)
+        throw Error("creating epoll instance", Error::getLastMessage());
+
+      m_events.resize(c_events);
+      m_triggered = 0;
+#elif defined(DUNE_OS_POSIX)
+      FD_ZERO(&m_rfd);
+#elif defined(DUNE_OS_WINDOWS)
+      m_rv = WAIT_FAILED;
+#endif
+    }
+
+    Poll::~Poll(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      close(m_epfd);
+#endif
+    }
+
+    void
+    Poll::add(const NativeHandle& handle, unsigned flags)
+    {
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN;
+      if (flags & PF_EDGE_TRIGGERED)
+        ev.events |= EPOLLET;
+      ev.data.fd = handle;
+
+      if (epoll_ctl(m_epfd, EPOLL_CTL_ADD, handle, &ev) == -1)
+      {
+        // Regular files cannot be polled and are always ready.
+        if (errno == EPERM)
+          m_ready.push_back(handle);
+        else if (errno != EEXIST)
+          throw Error("adding handle to poll", Error::getLastMessage());
+      }
+
+      if (m_handles.size() + 1 > m_events.size())
+        m_events.resize(m_events.size() * 2);
+#endif
+
       m_handles.push_back(handle);
+      m_flags.push_back(flags);
     }
 
     void
@@ -56,14 +157,45 @@ namespace DUNE
     {
       std::vector<NativeHandle>::iterator itr;
       itr = std::find(m_handles.begin(), m_handles.end(), handle);
-      if (itr != m_handles.end())
-        m_handles.erase(itr);
+      if (itr == m_handles.end())
+        return;
+
+      m_flags.erase(m_flags.begin() + (itr - m_handles.begin()));
+      m_handles.erase(itr);
+
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      // The handle may have been added more than once.
+      if (std::find(m_handles.begin(), m_handles.end(), handle) != m_handles.end())
+        return;
+
+      itr = std::find(m_ready.begin(), m_ready.end(), handle);
+      if (itr != m_ready.end())
+        m_ready.erase(itr);
+      else
+        epoll_ctl(m_epfd, EPOLL_CTL_DEL, handle, NULL);
+
+      // Forget pending events of this handle.
+      for (int i = 0; i < m_triggered; ++i)
+      {
+        if (m_events[i].data.fd == handle)
+          m_events[i].data.fd = -1;
+      }
+#endif
     }
 
     bool
     Poll::wasTriggered(const NativeHandle& handle)
     {
-#if defined(DUNE_OS_POSIX)
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      for (int i = 0; i < m_triggered; ++i)
+      {
+        if (m_events[i].data.fd == handle)
+          return true;
+      }
+
+      return std::find(m_ready.begin(), m_ready.end(), handle) != m_ready.end();
+
+#elif defined(DUNE_OS_POSIX)
       // Only the triggered fd's remain in the set after select() exits.
       return FD_ISSET(handle, &m_rfd) != 0;
 
@@ -79,9 +211,34 @@ namespace DUNE
       return false;
     }
 
+    void
+    Poll::getTriggered(std::vector<NativeHandle>& handles)
+    {
+      handles.clear();
+
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      for (int i = 0; i < m_triggered; ++i)
+      {
+        if (m_events[i].data.fd != -1)
+          handles.push_back(m_events[i].data.fd);
+      }
+
+      handles.insert(handles.end(), m_ready.begin(), m_ready.end());
+#else
+      for (size_t i = 0; i < m_handles.size(); ++i)
+      {
+        if (wasTriggered(m_handles[i]))
+          handles.push_back(m_handles[i]);
+      }
+#endif
+    }
+
     bool
     Poll::poll(double timeout)
     {
+      // Waiting for I/O must not hold virtual time back.
+      Time::VirtualClock::Idle idle(timeout != 0);
+
 #if defined(DUNE_OS_WINDOWS)
       DWORD count = m_handles.size();
       m_rv = WaitForMultipleObjects(count, &m_handles[0], FALSE, timeout * 1000);
@@ -101,6 +258,25 @@ namespace DUNE
 
       return false;
 
+#elif defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      m_triggered = 0;
+
+      // Handles that are always ready must not block.
+      int tout = m_ready.empty() ? toMilliseconds(timeout) : 0;
+      int rv = epoll_wait(m_epfd, &m_events[0], (int)m_events.size(), tout);
+
+      if (rv == -1)
+      {
+        //! Workaround for when we are interrupted by a signal.
+        if (errno == EINTR)
+          return false;
+        else
+          throw Error("polling handle", Error::getLastMessage());
+      }
+
+      m_triggered = rv;
+      return rv > 0 || !m_ready.empty();
+
 #elif defined(DUNE_OS_POSIX)
       int rv = 0;
       NativeHandle max = 0;
@@ -139,10 +315,31 @@ namespace DUNE
     bool
     Poll::poll(const NativeHandle& handle, double timeout)
     {
+      Time::VirtualClock::Idle idle(timeout != 0);
+
 #if defined(DUNE_OS_WINDOWS)
       DWORD rv = WaitForSingleObjectEx(handle, timeout * 1000, FALSE);
       return rv == WAIT_OBJECT_0;
 
+#elif defined(DUNE_SYS_HAS_POLL_H)
+      pollfd pfd;
+      pfd.fd = handle;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+
+      int rv = ::poll(&pfd, 1, toMilliseconds(timeout));
+
+      if (rv == -1)
+      {
+        //! Workaround for when we are interrupted by a signal.
+        if (errno == EINTR)
+          return false;
+        else
+          throw Error("polling handle", Error::getLastMessage());
+      }
+
+      return rv > 0;
+
 #elif defined(DUNE_OS_POSIX)
       fd_set rfd;
       FD_ZERO(&rfd);
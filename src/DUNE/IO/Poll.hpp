@@ -42,6 +42,11 @@
 #  include <sys/select.h>
 #endif
 
+// Linux headers.
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+#  include <sys/epoll.h>
+#endif
+
 namespace DUNE
 {
   namespace IO
@@ -49,9 +54,40 @@ namespace DUNE
     // Export symbol.
     class DUNE_DLL_SYM Poll;
 
+    //! Wait for I/O handles to become ready for reading. On systems
+    //! with epoll the cost of polling is independent of the number of
+    //! handles and there is no limit on handle values, otherwise
+    //! select() (or WaitForMultipleObjects() on Microsoft Windows) is
+    //! used. Handles must be removed before being closed.
     class Poll
     {
     public:
+      //! Registration flags.
+      enum Flags
+      {
+        //! Edge-triggered notification: a handle is reported only when
+        //! new data arrives, instead of while data is available.
+        //! Ignored if epoll is not available.
+        PF_EDGE_TRIGGERED = 0x01
+      };
+
+      //! Constructor.
+      Poll(void);
+
+      //! Copy constructor. The new object polls the same handles.
+      //! @param[in] other object to copy.
+      Poll(const Poll& other);
+
+      //! Destructor.
+      ~Poll(void);
+
+      //! Assignment operator. This object will poll the same handles
+      //! as the other object.
+      //! @param[in] other object to copy.
+      //! @return this object.
+      Poll&
+      operator=(const Poll& other);
+
       static bool
       poll(const NativeHandle& handle, double timeout);
 
@@ -63,15 +99,17 @@ namespace DUNE
 
       //! Add native I/O handle to the polling pool.
       //! @param[in] handle native I/O handle.
+      //! @param[in] flags registration flags.
       void
-      add(const NativeHandle& handle);
+      add(const NativeHandle& handle, unsigned flags = 0);
 
       //! Add I/O handle to the polling pool.
       //! @param[in] handle I/O handle.
+      //! @param[in] flags registration flags.
       void
-      add(const Handle& handle)
+      add(const Handle& handle, unsigned flags = 0)
       {
-        add(handle.getNative());
+        add(handle.getNative(), flags);
       }
 
       //! Remove native I/O handle from the polling pool.
@@ -99,14 +137,36 @@ namespace DUNE
         return wasTriggered(handle.getNative());
       }
 
+      //! Retrieve the handles that were triggered by the last call
+      //! to poll().
+      //! @param[out] handles triggered handles.
+      void
+      getTriggered(std::vector<NativeHandle>& handles);
+
     private:
       //! List of native I/O handles.
       std::vector<NativeHandle> m_handles;
-#if defined(DUNE_OS_POSIX)
+      //! Registration flags of each handle.
+      std::vector<unsigned> m_flags;
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+      //! epoll instance.
+      int m_epfd;
+      //! Events returned by the last poll.
+      std::vector<epoll_event> m_events;
+      //! Number of valid events.
+      int m_triggered;
+      //! Handles that cannot be polled (e.g., regular files) and are
+      //! always ready.
+      std::vector<NativeHandle> m_ready;
+#elif defined(DUNE_OS_POSIX)
       fd_set m_rfd;
 #elif defined(DUNE_OS_WINDOWS)
       DWORD m_rv;
 #endif
+
+      //! Initialize polling backend.
+      void
+      setup(void);
     };
   }
 }
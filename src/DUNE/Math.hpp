@@ -42,14 +42,20 @@ namespace DUNE
 #include <DUNE/Math/EulerAnglesZyx.hpp>
 #include <DUNE/Math/General.hpp>
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/MatrixN.hpp>
+#include <DUNE/Math/Cholesky.hpp>
+#include <DUNE/Math/LDLT.hpp>
+#include <DUNE/Math/QR.hpp>
 #include <DUNE/Math/Angles.hpp>
 #include <DUNE/Math/Random.hpp>
 #include <DUNE/Math/Optimization.hpp>
 #include <DUNE/Math/QPSolver.hpp>
 #include <DUNE/Math/Quaternion.hpp>
+#include <DUNE/Math/SlidingWindow.hpp>
 #include <DUNE/Math/MovingAverage.hpp>
 #include <DUNE/Math/MultiMovingAverage.hpp>
 #include <DUNE/Math/Grid.hpp>
 #include <DUNE/Math/FIRFilter.hpp>
+#include <DUNE/Math/FilterBank.hpp>
 
 #endif
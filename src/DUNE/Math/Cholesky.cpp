@@ -0,0 +1,214 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/Cholesky.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    Cholesky::Cholesky(void):
+      m_valid(false)
+    { }
+
+    Cholesky::Cholesky(const Matrix& a):
+      m_valid(false)
+    {
+      compute(a);
+    }
+
+    bool
+    Cholesky::compute(const Matrix& a)
+    {
+      if (!a.isSquare())
+        throw Matrix::Error("Matrix is not square!");
+
+      m_l.assign(a);
+
+      size_t n = a.rows();
+      double* l = &m_l(0, 0);
+      m_valid = false;
+
+      for (size_t j = 0; j < n; ++j)
+      {
+        double* lj = l + j * n;
+
+        double s = lj[j];
+        for (size_t k = 0; k < j; ++k)
+          s -= lj[k] * lj[k];
+
+        if (!(s > 0.0))
+          return false;
+
+        double d = std::sqrt(s);
+        lj[j] = d;
+
+        for (size_t i = j + 1; i < n; ++i)
+        {
+          double* li = l + i * n;
+          double v = li[j];
+          for (size_t k = 0; k < j; ++k)
+            v -= li[k] * lj[k];
+          li[j] = v / d;
+        }
+
+        // Clear the upper triangle.
+        for (size_t k = j + 1; k < n; ++k)
+          lj[k] = 0.0;
+      }
+
+      m_valid = true;
+      return true;
+    }
+
+    void
+    Cholesky::checkValid(void) const
+    {
+      if (!m_valid)
+        throw Matrix::Error("Decomposition is not valid!");
+    }
+
+    void
+    Cholesky::solve(const Matrix& b, Matrix& x) const
+    {
+      checkValid();
+
+      size_t n = m_l.rows();
+      if ((size_t)b.rows() != n)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      x.assign(b);
+
+      size_t m = x.columns();
+      const double* l = m_l.cbegin();
+      double* px = &x(0, 0);
+
+      for (size_t c = 0; c < m; ++c)
+      {
+        // Forward substitution: L * y = b.
+        for (size_t i = 0; i < n; ++i)
+        {
+          double v = px[i * m + c];
+          for (size_t k = 0; k < i; ++k)
+            v -= l[i * n + k] * px[k * m + c];
+          px[i * m + c] = v / l[i * n + i];
+        }
+
+        // Backward substitution: L' * x = y.
+        for (size_t i = n; i-- > 0;)
+        {
+          double v = px[i * m + c];
+          for (size_t k = i + 1; k < n; ++k)
+            v -= l[k * n + i] * px[k * m + c];
+          px[i * m + c] = v / l[i * n + i];
+        }
+      }
+    }
+
+    Matrix
+    Cholesky::solve(const Matrix& b) const
+    {
+      Matrix x;
+      solve(b, x);
+      return x;
+    }
+
+    void
+    Cholesky::update(const Matrix& v)
+    {
+      checkValid();
+
+      size_t n = m_l.rows();
+      if (v.size() != (int)n)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      m_w.assign(v);
+      double* w = &m_w(0);
+      double* l = &m_l(0, 0);
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        double lkk = l[k * n + k];
+        double r = std::sqrt(lkk * lkk + w[k] * w[k]);
+        double c = r / lkk;
+        double s = w[k] / lkk;
+        l[k * n + k] = r;
+
+        for (size_t i = k + 1; i < n; ++i)
+        {
+          double* lik = l + i * n + k;
+          *lik = (*lik + s * w[i]) / c;
+          w[i] = c * w[i] - s * (*lik);
+        }
+      }
+    }
+
+    bool
+    Cholesky::downdate(const Matrix& v)
+    {
+      checkValid();
+
+      size_t n = m_l.rows();
+      if (v.size() != (int)n)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      m_backup.assign(m_l);
+      m_w.assign(v);
+      double* w = &m_w(0);
+      double* l = &m_l(0, 0);
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        double lkk = l[k * n + k];
+        double r2 = lkk * lkk - w[k] * w[k];
+        if (!(r2 > 0.0))
+        {
+          m_l.assign(m_backup);
+          return false;
+        }
+
+        double r = std::sqrt(r2);
+        double c = r / lkk;
+        double s = w[k] / lkk;
+        l[k * n + k] = r;
+
+        for (size_t i = k + 1; i < n; ++i)
+        {
+          double* lik = l + i * n + k;
+          *lik = (*lik - s * w[i]) / c;
+          w[i] = c * w[i] - s * (*lik);
+        }
+      }
+
+      return true;
+    }
+  }
+}
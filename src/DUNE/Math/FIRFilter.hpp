@@ -31,11 +31,9 @@
 #define DUNE_MATH_FIR_FILTER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <vector>
 
-// DUNE headers.
-#include "DUNE/Utils/CircularBuffer.hpp"
-
 namespace DUNE
 {
   namespace Math
@@ -45,20 +43,16 @@ namespace DUNE
     public:
       //! Create a zero-initialized filter.
       FIRFilter(std::vector<T> weights)
-      : m_weights(std::move(weights)), m_buffer(m_weights.size()), m_val(T{ 0 })
-      {
-        for (size_t i = 0; i < m_weights.size(); ++i)
-          m_buffer.add(T{ 0 });
-      }
+      : m_weights(std::move(weights)), m_line(2 * m_weights.size(), T{ 0 }), m_pos(0), m_val(T{ 0 })
+      { }
 
       //! Clear samples and reset state.
       void
       clear(void)
       {
         m_val = T{ 0 };
-
-        for (size_t i = 0; i < m_weights.size(); ++i)
-          m_buffer(i) = T{ 0 };
+        m_pos = 0;
+        std::fill(m_line.begin(), m_line.end(), T{ 0 });
       }
 
       //! Add a new sample to the buffer.
@@ -66,13 +60,24 @@ namespace DUNE
       T
       update(T value)
       {
-        m_buffer.add(value);
+        size_t n = m_weights.size();
+        if (n == 0)
+          return m_val;
 
-        m_val = T{ 0 };
+        // Each sample is stored twice so that the last n samples are
+        // always contiguous, oldest first, starting at m_pos.
+        m_line[m_pos] = value;
+        m_line[m_pos + n] = value;
+        m_pos = (m_pos + 1) % n;
+
+        const T* w = &m_weights[0];
+        const T* x = &m_line[m_pos];
 
-        for (size_t i = 0; i < m_weights.size(); ++i)
-          m_val += m_weights[i] * m_buffer(i);
+        T acc = T{ 0 };
+        for (size_t i = 0; i < n; ++i)
+          acc += w[i] * x[i];
 
+        m_val = acc;
         return m_val;
       }
 
@@ -87,8 +92,10 @@ namespace DUNE
     private:
       //! Impulse response.
       std::vector<T> m_weights;
-      //! Input samples.
-      DUNE::Utils::CircularBuffer<T> m_buffer;
+      //! Input samples (delay line stored twice).
+      std::vector<T> m_line;
+      //! Position of the oldest sample in the delay line.
+      size_t m_pos;
       //! Caches the last filter output.
       T m_val;
     };
@@ -0,0 +1,185 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_FILTER_BANK_HPP_INCLUDED_
+#define DUNE_MATH_FILTER_BANK_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Bank of identical linear filters applied to several channels
+    //! at once. The filter is given by its transfer function
+    //!   H(z) = (b0 + b1 z^-1 + ... + bN z^-N) / (a0 + a1 z^-1 + ... + aN z^-N)
+    //! and implemented in transposed direct form II. State is stored
+    //! channel-minor, so each step is a sequence of contiguous loops
+    //! over channels that the compiler can vectorize. A FIR filter is
+    //! obtained with a = {1}.
+    template <typename T>
+    class FilterBank
+    {
+    public:
+      //! Constructor.
+      //! @param[in] b numerator coefficients.
+      //! @param[in] a denominator coefficients (a0 must not be zero).
+      //! @param[in] channels number of channels.
+      FilterBank(const std::vector<T>& b, const std::vector<T>& a, unsigned channels):
+        m_channels(channels)
+      {
+        if (b.empty() || a.empty() || a[0] == T{ 0 })
+          throw std::runtime_error("filter bank: invalid coefficients");
+
+        if (channels == 0)
+          throw std::runtime_error("filter bank: invalid number of channels");
+
+        size_t n = std::max(b.size(), a.size());
+        m_b.assign(n, T{ 0 });
+        m_a.assign(n, T{ 0 });
+
+        for (size_t i = 0; i < b.size(); ++i)
+          m_b[i] = b[i] / a[0];
+
+        for (size_t i = 0; i < a.size(); ++i)
+          m_a[i] = a[i] / a[0];
+
+        m_order = n - 1;
+        m_state.assign(std::max<size_t>(m_order, 1) * channels, T{ 0 });
+        m_out.assign(channels, T{ 0 });
+      }
+
+      //! Clear filter state.
+      void
+      clear(void)
+      {
+        std::fill(m_state.begin(), m_state.end(), T{ 0 });
+        std::fill(m_out.begin(), m_out.end(), T{ 0 });
+      }
+
+      //! Filter one sample of each channel.
+      //! @param[in] in one input sample per channel.
+      //! @return filter outputs, one per channel.
+      const T*
+      update(const T* in)
+      {
+        unsigned c = m_channels;
+        T* y = &m_out[0];
+
+        if (m_order == 0)
+        {
+          for (unsigned j = 0; j < c; ++j)
+            y[j] = m_b[0] * in[j];
+
+          return y;
+        }
+
+        T* z = &m_state[0];
+
+        for (unsigned j = 0; j < c; ++j)
+          y[j] = m_b[0] * in[j] + z[j];
+
+        for (size_t k = 1; k < m_order; ++k)
+        {
+          T bk = m_b[k];
+          T ak = m_a[k];
+          T* zk = z + (k - 1) * c;
+          const T* zn = z + k * c;
+
+          for (unsigned j = 0; j < c; ++j)
+            zk[j] = bk * in[j] - ak * y[j] + zn[j];
+        }
+
+        T bn = m_b[m_order];
+        T an = m_a[m_order];
+        T* zl = z + (m_order - 1) * c;
+
+        for (unsigned j = 0; j < c; ++j)
+          zl[j] = bn * in[j] - an * y[j];
+
+        return y;
+      }
+
+      //! Filter one sample of each channel.
+      //! @param[in] in one input sample per channel.
+      //! @param[out] out filter outputs, one per channel.
+      void
+      update(const std::vector<T>& in, std::vector<T>& out)
+      {
+        if (in.size() != m_channels)
+          throw std::runtime_error("filter bank: invalid number of samples");
+
+        const T* y = update(&in[0]);
+        out.assign(y, y + m_channels);
+      }
+
+      //! Get the last output of a channel.
+      //! @param[in] channel channel index.
+      //! @return filter output.
+      T
+      get(unsigned channel) const
+      {
+        return m_out[channel];
+      }
+
+      //! Get number of channels.
+      //! @return number of channels.
+      unsigned
+      getChannels(void) const
+      {
+        return m_channels;
+      }
+
+      //! Get filter order.
+      //! @return filter order.
+      size_t
+      getOrder(void) const
+      {
+        return m_order;
+      }
+
+    private:
+      //! Number of channels.
+      unsigned m_channels;
+      //! Filter order.
+      size_t m_order;
+      //! Normalized numerator coefficients.
+      std::vector<T> m_b;
+      //! Normalized denominator coefficients.
+      std::vector<T> m_a;
+      //! Delay elements (order x channels).
+      std::vector<T> m_state;
+      //! Last outputs.
+      std::vector<T> m_out;
+    };
+  }
+}
+
+#endif
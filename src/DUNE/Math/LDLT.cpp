@@ -0,0 +1,158 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/LDLT.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    LDLT::LDLT(void):
+      m_valid(false)
+    { }
+
+    LDLT::LDLT(const Matrix& a):
+      m_valid(false)
+    {
+      compute(a);
+    }
+
+    bool
+    LDLT::compute(const Matrix& a)
+    {
+      if (!a.isSquare())
+        throw Matrix::Error("Matrix is not square!");
+
+      m_ld.assign(a);
+
+      size_t n = a.rows();
+      double* ld = &m_ld(0, 0);
+      m_valid = false;
+
+      for (size_t j = 0; j < n; ++j)
+      {
+        double* rj = ld + j * n;
+
+        double d = rj[j];
+        for (size_t k = 0; k < j; ++k)
+          d -= rj[k] * rj[k] * ld[k * n + k];
+
+        if (std::fabs(d) <= Matrix::get_precision())
+          return false;
+
+        rj[j] = d;
+
+        for (size_t i = j + 1; i < n; ++i)
+        {
+          double* ri = ld + i * n;
+          double v = ri[j];
+          for (size_t k = 0; k < j; ++k)
+            v -= ri[k] * rj[k] * ld[k * n + k];
+          ri[j] = v / d;
+        }
+
+        for (size_t k = j + 1; k < n; ++k)
+          rj[k] = 0.0;
+      }
+
+      m_valid = true;
+      return true;
+    }
+
+    Matrix
+    LDLT::getL(void) const
+    {
+      Matrix l(m_ld);
+      for (int i = 0; i < l.rows(); ++i)
+        l(i, i) = 1.0;
+      return l;
+    }
+
+    Matrix
+    LDLT::getD(void) const
+    {
+      Matrix d(m_ld.rows(), 1);
+      for (int i = 0; i < m_ld.rows(); ++i)
+        d(i) = m_ld(i, i);
+      return d;
+    }
+
+    void
+    LDLT::solve(const Matrix& b, Matrix& x) const
+    {
+      if (!m_valid)
+        throw Matrix::Error("Decomposition is not valid!");
+
+      size_t n = m_ld.rows();
+      if ((size_t)b.rows() != n)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      x.assign(b);
+
+      size_t m = x.columns();
+      const double* ld = m_ld.cbegin();
+      double* px = &x(0, 0);
+
+      for (size_t c = 0; c < m; ++c)
+      {
+        // L * z = b.
+        for (size_t i = 0; i < n; ++i)
+        {
+          double v = px[i * m + c];
+          for (size_t k = 0; k < i; ++k)
+            v -= ld[i * n + k] * px[k * m + c];
+          px[i * m + c] = v;
+        }
+
+        // D * y = z.
+        for (size_t i = 0; i < n; ++i)
+          px[i * m + c] /= ld[i * n + i];
+
+        // L' * x = y.
+        for (size_t i = n; i-- > 0;)
+        {
+          double v = px[i * m + c];
+          for (size_t k = i + 1; k < n; ++k)
+            v -= ld[k * n + i] * px[k * m + c];
+          px[i * m + c] = v;
+        }
+      }
+    }
+
+    Matrix
+    LDLT::solve(const Matrix& b) const
+    {
+      Matrix x;
+      solve(b, x);
+      return x;
+    }
+  }
+}
@@ -0,0 +1,101 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_LDLT_HPP_INCLUDED_
+#define DUNE_MATH_LDLT_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LDLT;
+
+    //! LDL' decomposition A = L * D * L' of a symmetric matrix, with L
+    //! unit lower triangular and D diagonal. Unlike the Cholesky
+    //! decomposition no square roots are taken and D may have negative
+    //! entries. Only the lower triangle of A is read.
+    class LDLT
+    {
+    public:
+      //! Constructor.
+      LDLT(void);
+
+      //! Constructor.
+      //! @param[in] a symmetric matrix.
+      explicit LDLT(const Matrix& a);
+
+      //! Decompose a matrix.
+      //! @param[in] a symmetric matrix.
+      //! @return true if successful, false if a pivot is (near) zero.
+      bool
+      compute(const Matrix& a);
+
+      //! Check if the last decomposition succeeded.
+      //! @return true if the decomposition is valid, false otherwise.
+      bool
+      isValid(void) const
+      {
+        return m_valid;
+      }
+
+      //! Retrieve the unit lower triangular factor.
+      //! @return factor L.
+      Matrix
+      getL(void) const;
+
+      //! Retrieve the diagonal factor.
+      //! @return column vector with the diagonal of D.
+      Matrix
+      getD(void) const;
+
+      //! Solve A * x = b.
+      //! @param[in] b right hand side, with one column per system.
+      //! @param[out] x solution (may be the same object as b).
+      void
+      solve(const Matrix& b, Matrix& x) const;
+
+      //! Solve A * x = b.
+      //! @param[in] b right hand side, with one column per system.
+      //! @return solution.
+      Matrix
+      solve(const Matrix& b) const;
+
+    private:
+      //! Factors: D on the diagonal, L below it.
+      Matrix m_ld;
+      //! True if the decomposition is valid.
+      bool m_valid;
+    };
+  }
+}
+
+#endif
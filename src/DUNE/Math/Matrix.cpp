@@ -61,6 +61,77 @@ namespace DUNE
     //! The value used to test for zero in matrix inversion
     double Matrix::precision = 1e-10;
 
+    //! Number of inner-dimension terms processed per block.
+    static const size_t c_gemm_block_k = 64;
+    //! Number of destination columns processed per block.
+    static const size_t c_gemm_block_n = 256;
+
+    //! Accumulate c += alpha * op(a) * op(b), where op(a) is n x k,
+    //! op(b) is k x m and all operands are row-major. Loops are
+    //! ordered so that the innermost one always walks contiguous
+    //! memory without branches, which compilers vectorize.
+    static void
+    gemmKernel(size_t n, size_t m, size_t k, double alpha,
+               const double* a, bool ta, const double* b, bool tb, double* c)
+    {
+      if (!tb)
+      {
+        // op(b) rows are contiguous: c(i, :) += op(a)(i, p) * b(p, :),
+        // blocked so that a panel of 'b' stays in cache.
+        for (size_t pp = 0; pp < k; pp += c_gemm_block_k)
+        {
+          size_t pe = std::min(k, pp + c_gemm_block_k);
+          for (size_t jj = 0; jj < m; jj += c_gemm_block_n)
+          {
+            size_t je = std::min(m, jj + c_gemm_block_n);
+            for (size_t i = 0; i < n; ++i)
+            {
+              double* cr = c + i * m;
+              for (size_t p = pp; p < pe; ++p)
+              {
+                double v = alpha * (ta ? a[p * n + i] : a[i * k + p]);
+                const double* br = b + p * m;
+                for (size_t j = jj; j < je; ++j)
+                  cr[j] += v * br[j];
+              }
+            }
+          }
+        }
+        return;
+      }
+
+      // op(b) columns are rows of 'b': c(i, j) is a dot product.
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < m; ++j)
+        {
+          const double* br = b + j * k;
+          double s0 = 0.0;
+          double s1 = 0.0;
+          size_t p = 0;
+
+          if (!ta)
+          {
+            const double* ar = a + i * k;
+            for (; p + 1 < k; p += 2)
+            {
+              s0 += ar[p] * br[p];
+              s1 += ar[p + 1] * br[p + 1];
+            }
+            for (; p < k; ++p)
+              s0 += ar[p] * br[p];
+          }
+          else
+          {
+            for (; p < k; ++p)
+              s0 += a[p * n + i] * br[p];
+          }
+
+          c[i * m + j] += alpha * (s0 + s1);
+        }
+      }
+    }
+
     Matrix::Matrix(void):
       m_nrows(0),
       m_ncols(0),
@@ -655,6 +726,35 @@ namespace DUNE
       fill(value);
     }
 
+    void
+    Matrix::assign(const Matrix& m)
+    {
+      if (&m == this)
+        return;
+
+      if (m.isEmpty())
+      {
+        *this = m;
+        return;
+      }
+
+      reserve(m.m_nrows, m.m_ncols);
+      std::memcpy(m_data, m.m_data, m_size * sizeof(double));
+    }
+
+    void
+    Matrix::reserve(size_t r, size_t c)
+    {
+      if (m_size != 0 && m_size == r * c && *m_counter == 1)
+      {
+        m_nrows = r;
+        m_ncols = c;
+        return;
+      }
+
+      resize(r, c);
+    }
+
     void
     Matrix::resize(const Matrix& m)
     {
@@ -1529,33 +1629,73 @@ namespace DUNE
       if (m1.m_ncols != m2.m_nrows)
         throw Matrix::Error("Incompatible dimensions!");
 
-      Matrix s(m1.m_nrows, m2.m_ncols);
+      Matrix s(m1.m_nrows, m2.m_ncols, 0.0);
+      gemmKernel(m1.m_nrows, m2.m_ncols, m1.m_ncols, 1.0,
+                 m1.m_data, false, m2.m_data, false, s.m_data);
+      return s;
+    }
 
-      int n = m1.m_nrows;
-      int m = m1.m_ncols;
-      int r = m2.m_ncols;
+    void
+    gemm(double alpha, const Matrix& a, Matrix::Operation op_a, const Matrix& b,
+         Matrix::Operation op_b, double beta, Matrix& c)
+    {
+      if (a.isEmpty() || b.isEmpty())
+        throw Matrix::Error("Trying to access an empty matrix!");
 
-      double* m1_p = m1.m_data;
+      bool ta = (op_a == Matrix::OP_TRANSPOSE);
+      bool tb = (op_b == Matrix::OP_TRANSPOSE);
+      size_t n = ta ? a.m_ncols : a.m_nrows;
+      size_t k = ta ? a.m_nrows : a.m_ncols;
+      size_t kb = tb ? b.m_ncols : b.m_nrows;
+      size_t m = tb ? b.m_nrows : b.m_ncols;
 
-      for (int i = 0; i < n; i++)
+      if (k != kb)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      // The destination must not be read while being written.
+      if (&c == &a || &c == &b)
       {
-        for (int k = 0; k < m; k++)
-        {
-          double v = *m1_p++; // <-> v = m1(i,k)
-          double* m2_p = m2.m_data + k * r;
-          double* s_p = s.m_data + i * r;
+        Matrix t;
+        if (beta != 0.0)
+          t.assign(c);
+        gemm(alpha, a, op_a, b, op_b, beta, t);
+        c.assign(t);
+        return;
+      }
 
-          for (int j = 0; j < r; j++)
-          {
-            if (!k)
-              *s_p = 0;
-            *s_p += v * (*m2_p); // <-> s(i,j) += m1(i,k) * m2(k,j)
-            s_p++;
-            m2_p++;
-          }
+      if (beta == 0.0)
+      {
+        c.reserve(n, m);
+        std::fill(c.m_data, c.m_data + c.m_size, 0.0);
+      }
+      else
+      {
+        if (c.m_nrows != n || c.m_ncols != m)
+          throw Matrix::Error("Incompatible dimensions!");
+
+        c.split();
+        if (beta != 1.0)
+        {
+          for (size_t i = 0; i < c.m_size; ++i)
+            c.m_data[i] *= beta;
         }
       }
-      return s;
+
+      gemmKernel(n, m, k, alpha, a.m_data, ta, b.m_data, tb, c.m_data);
+    }
+
+    void
+    axpy(double alpha, const Matrix& x, Matrix& y)
+    {
+      if (x.isEmpty() || y.isEmpty())
+        throw Matrix::Error("Trying to access an empty matrix!");
+
+      if (x.m_nrows != y.m_nrows || x.m_ncols != y.m_ncols)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      y.split();
+      for (size_t i = 0; i < y.m_size; ++i)
+        y.m_data[i] += alpha * x.m_data[i];
     }
 
     Matrix
@@ -64,6 +64,15 @@ namespace DUNE
         { }
       };
 
+      //! Operation applied to an operand of gemm().
+      enum Operation
+      {
+        //! Use the matrix as is.
+        OP_NONE,
+        //! Use the transpose of the matrix.
+        OP_TRANSPOSE
+      };
+
       //! Constructor.
       //! Construct a zero sized matrix.
       Matrix(void);
@@ -329,6 +338,14 @@ namespace DUNE
       void
       resizeAndFill(size_t r, size_t c, double value);
 
+      //! Copy the contents of another matrix into this one. Unlike
+      //! the assignment operator, data is never shared and the current
+      //! storage is reused when dimensions allow, so this does not
+      //! allocate memory in steady state.
+      //! @param[in] m matrix to copy.
+      void
+      assign(const Matrix& m);
+
       //! This operator returns a reference to a given entry of a Matrix.
       //!
       //! As this methods makes possible to change the entries of a Matrix
@@ -694,6 +711,29 @@ namespace DUNE
       friend DUNE_DLL_SYM Matrix
       operator/(const Matrix& a, double x);
 
+      //! General matrix product with accumulation, computing
+      //! c = alpha * op(a) * op(b) + beta * c in place. No temporaries
+      //! are created and the storage of 'c' is reused: when beta is
+      //! zero 'c' is resized as needed, otherwise it must already have
+      //! the dimensions of the product.
+      //! @param[in] alpha scale of the product.
+      //! @param[in] a left operand.
+      //! @param[in] op_a operation applied to 'a'.
+      //! @param[in] b right operand.
+      //! @param[in] op_b operation applied to 'b'.
+      //! @param[in] beta scale of the previous contents of 'c'.
+      //! @param[in,out] c destination matrix.
+      friend DUNE_DLL_SYM void
+      gemm(double alpha, const Matrix& a, Operation op_a, const Matrix& b, Operation op_b,
+           double beta, Matrix& c);
+
+      //! Scaled accumulation in place, computing y = alpha * x + y.
+      //! @param[in] alpha scale of 'x'.
+      //! @param[in] x matrix to add.
+      //! @param[in,out] y destination matrix.
+      friend DUNE_DLL_SYM void
+      axpy(double alpha, const Matrix& x, Matrix& y);
+
       //! This method sends a Matrix to an 'ostream'.
       //! Each row of the Matrix is put on a different line.
       //! @param[in] os output stream.
@@ -867,6 +907,14 @@ namespace DUNE
       //! This method creates a unique copy of the data of a Matrix.
       void
       split(void);
+
+      //! Make sure this matrix owns storage of the given dimensions,
+      //! reusing the current buffer when possible. Contents are not
+      //! preserved.
+      //! @param[in] r number of rows
+      //! @param[in] c number of columns
+      void
+      reserve(size_t r, size_t c);
     };
 
     //! This function returns a 3x3 skew symmetrical
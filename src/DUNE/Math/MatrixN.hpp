@@ -0,0 +1,562 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_MATRIX_N_HPP_INCLUDED_
+#define DUNE_MATH_MATRIX_N_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+
+// DUNE headers.
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Matrix with dimensions fixed at compile time. Elements are stored
+    //! inline in row-major order, so instances live on the stack and
+    //! operations never allocate. Dimension mismatches are compile
+    //! errors, except when converting from a Math::Matrix.
+    template <size_t R, size_t C>
+    class MatrixN
+    {
+    public:
+      static_assert(R > 0 && C > 0, "matrix dimensions must be positive");
+
+      //! Constructor.
+      //! Construct a zero matrix.
+      constexpr MatrixN(void):
+        m_data()
+      { }
+
+      //! Constructor.
+      //! Construct a matrix filled with a constant value.
+      //! @param[in] value value used to initialize cells.
+      explicit MatrixN(double value)
+      {
+        fill(value);
+      }
+
+      //! Constructor.
+      //! Construct a matrix from row-major data.
+      //! @param[in] data pointer to R * C values.
+      explicit MatrixN(const double* data)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] = data[i];
+      }
+
+      //! Constructor.
+      //! Construct a matrix from a dynamically sized one.
+      //! @param[in] m matrix with R rows and C columns.
+      explicit MatrixN(const Matrix& m)
+      {
+        if ((size_t)m.rows() != R || (size_t)m.columns() != C)
+          throw Matrix::Error("Incompatible dimensions!");
+
+        const double* src = m.cbegin();
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] = src[i];
+      }
+
+      //! Identity matrix.
+      //! @return identity matrix.
+      static MatrixN
+      identity(void)
+      {
+        static_assert(R == C, "identity matrix must be square");
+        MatrixN m;
+        for (size_t i = 0; i < R; ++i)
+          m(i, i) = 1.0;
+        return m;
+      }
+
+      //! Diagonal matrix.
+      //! @param[in] diag pointer to R diagonal values.
+      //! @return diagonal matrix.
+      static MatrixN
+      diagonal(const double* diag)
+      {
+        static_assert(R == C, "diagonal matrix must be square");
+        MatrixN m;
+        for (size_t i = 0; i < R; ++i)
+          m(i, i) = diag[i];
+        return m;
+      }
+
+      //! Retrieve the number of rows of the matrix.
+      static constexpr size_t
+      rows(void)
+      {
+        return R;
+      }
+
+      //! Retrieve the number of columns of the matrix.
+      static constexpr size_t
+      columns(void)
+      {
+        return C;
+      }
+
+      //! Retrieve the number of elements of the matrix.
+      static constexpr size_t
+      size(void)
+      {
+        return R * C;
+      }
+
+      //! Convert to a dynamically sized matrix.
+      //! @return copy of this matrix.
+      Matrix
+      toMatrix(void) const
+      {
+        return Matrix(m_data, R, C);
+      }
+
+      //! Fill the matrix with a constant value.
+      //! @param[in] value value.
+      void
+      fill(double value)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] = value;
+      }
+
+      //! Pointer to first element.
+      double*
+      begin(void)
+      {
+        return m_data;
+      }
+
+      //! Pointer to element after last element.
+      double*
+      end(void)
+      {
+        return m_data + R * C;
+      }
+
+      //! Const pointer to first element.
+      const double*
+      begin(void) const
+      {
+        return m_data;
+      }
+
+      //! Const pointer to element after last element.
+      const double*
+      end(void) const
+      {
+        return m_data + R * C;
+      }
+
+      //! Element access.
+      //! @param[in] i row index.
+      //! @param[in] j column index.
+      //! @return reference to element.
+      double&
+      operator()(size_t i, size_t j)
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Element access.
+      //! @param[in] i row index.
+      //! @param[in] j column index.
+      //! @return element.
+      constexpr double
+      operator()(size_t i, size_t j) const
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Linear element access (row-major).
+      //! @param[in] i element index.
+      //! @return reference to element.
+      double&
+      operator()(size_t i)
+      {
+        return m_data[i];
+      }
+
+      //! Linear element access (row-major).
+      //! @param[in] i element index.
+      //! @return element.
+      constexpr double
+      operator()(size_t i) const
+      {
+        return m_data[i];
+      }
+
+      //! Retrieve a block of this matrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @return RB x CB block starting at (i, j).
+      template <size_t RB, size_t CB>
+      MatrixN<RB, CB>
+      get(size_t i, size_t j) const
+      {
+        static_assert(RB <= R && CB <= C, "block larger than matrix");
+        MatrixN<RB, CB> b;
+        for (size_t r = 0; r < RB; ++r)
+          for (size_t c = 0; c < CB; ++c)
+            b(r, c) = (*this)(i + r, j + c);
+        return b;
+      }
+
+      //! Overwrite a block of this matrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @param[in] b block.
+      template <size_t RB, size_t CB>
+      void
+      set(size_t i, size_t j, const MatrixN<RB, CB>& b)
+      {
+        static_assert(RB <= R && CB <= C, "block larger than matrix");
+        for (size_t r = 0; r < RB; ++r)
+          for (size_t c = 0; c < CB; ++c)
+            (*this)(i + r, j + c) = b(r, c);
+      }
+
+      MatrixN&
+      operator+=(const MatrixN& m)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] += m.m_data[i];
+        return *this;
+      }
+
+      MatrixN&
+      operator-=(const MatrixN& m)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] -= m.m_data[i];
+        return *this;
+      }
+
+      MatrixN&
+      operator*=(double x)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] *= x;
+        return *this;
+      }
+
+      MatrixN&
+      operator/=(double x)
+      {
+        for (size_t i = 0; i < R * C; ++i)
+          m_data[i] /= x;
+        return *this;
+      }
+
+      MatrixN
+      operator-(void) const
+      {
+        MatrixN m;
+        for (size_t i = 0; i < R * C; ++i)
+          m.m_data[i] = -m_data[i];
+        return m;
+      }
+
+      bool
+      operator==(const MatrixN& m) const
+      {
+        for (size_t i = 0; i < R * C; ++i)
+        {
+          if (m_data[i] != m.m_data[i])
+            return false;
+        }
+        return true;
+      }
+
+      bool
+      operator!=(const MatrixN& m) const
+      {
+        return !(*this == m);
+      }
+
+    private:
+      //! Elements in row-major order.
+      double m_data[R * C];
+    };
+
+    //! 3 element column vector.
+    typedef MatrixN<3, 1> Vector3;
+    //! 6 element column vector.
+    typedef MatrixN<6, 1> Vector6;
+    //! 3x3 matrix.
+    typedef MatrixN<3, 3> Matrix3;
+    //! 6x6 matrix.
+    typedef MatrixN<6, 6> Matrix6;
+
+    template <size_t R, size_t C>
+    inline MatrixN<R, C>
+    operator+(MatrixN<R, C> a, const MatrixN<R, C>& b)
+    {
+      return a += b;
+    }
+
+    template <size_t R, size_t C>
+    inline MatrixN<R, C>
+    operator-(MatrixN<R, C> a, const MatrixN<R, C>& b)
+    {
+      return a -= b;
+    }
+
+    template <size_t R, size_t C>
+    inline MatrixN<R, C>
+    operator*(MatrixN<R, C> a, double x)
+    {
+      return a *= x;
+    }
+
+    template <size_t R, size_t C>
+    inline MatrixN<R, C>
+    operator*(double x, MatrixN<R, C> a)
+    {
+      return a *= x;
+    }
+
+    template <size_t R, size_t C>
+    inline MatrixN<R, C>
+    operator/(MatrixN<R, C> a, double x)
+    {
+      return a /= x;
+    }
+
+    //! Matrix product.
+    template <size_t R, size_t K, size_t C>
+    inline MatrixN<R, C>
+    operator*(const MatrixN<R, K>& a, const MatrixN<K, C>& b)
+    {
+      MatrixN<R, C> m;
+      for (size_t i = 0; i < R; ++i)
+      {
+        for (size_t k = 0; k < K; ++k)
+        {
+          double aik = a(i, k);
+          for (size_t j = 0; j < C; ++j)
+            m(i, j) += aik * b(k, j);
+        }
+      }
+      return m;
+    }
+
+    //! Transpose of a matrix.
+    template <size_t R, size_t C>
+    inline MatrixN<C, R>
+    transpose(const MatrixN<R, C>& a)
+    {
+      MatrixN<C, R> m;
+      for (size_t i = 0; i < R; ++i)
+        for (size_t j = 0; j < C; ++j)
+          m(j, i) = a(i, j);
+      return m;
+    }
+
+    //! Inverse of a square matrix, computed by Gauss-Jordan elimination
+    //! with partial pivoting.
+    //! @param[in] a matrix.
+    //! @return inverse matrix.
+    template <size_t N>
+    inline MatrixN<N, N>
+    inverse(MatrixN<N, N> a)
+    {
+      MatrixN<N, N> inv = MatrixN<N, N>::identity();
+
+      for (size_t c = 0; c < N; ++c)
+      {
+        size_t p = c;
+        for (size_t r = c + 1; r < N; ++r)
+        {
+          if (std::fabs(a(r, c)) > std::fabs(a(p, c)))
+            p = r;
+        }
+
+        if (std::fabs(a(p, c)) <= Matrix::get_precision())
+          throw Matrix::Error("Inversion error!");
+
+        if (p != c)
+        {
+          for (size_t j = 0; j < N; ++j)
+          {
+            std::swap(a(p, j), a(c, j));
+            std::swap(inv(p, j), inv(c, j));
+          }
+        }
+
+        double d = 1.0 / a(c, c);
+        for (size_t j = 0; j < N; ++j)
+        {
+          a(c, j) *= d;
+          inv(c, j) *= d;
+        }
+
+        for (size_t r = 0; r < N; ++r)
+        {
+          if (r == c || a(r, c) == 0.0)
+            continue;
+
+          double f = a(r, c);
+          for (size_t j = 0; j < N; ++j)
+          {
+            a(r, j) -= f * a(c, j);
+            inv(r, j) -= f * inv(c, j);
+          }
+        }
+      }
+
+      return inv;
+    }
+
+    //! Dot product of two column vectors.
+    template <size_t N>
+    inline double
+    dot(const MatrixN<N, 1>& a, const MatrixN<N, 1>& b)
+    {
+      double s = 0.0;
+      for (size_t i = 0; i < N; ++i)
+        s += a(i) * b(i);
+      return s;
+    }
+
+    //! Euclidean (Frobenius) norm.
+    template <size_t R, size_t C>
+    inline double
+    norm(const MatrixN<R, C>& a)
+    {
+      double s = 0.0;
+      for (size_t i = 0; i < R * C; ++i)
+        s += a(i) * a(i);
+      return std::sqrt(s);
+    }
+
+    //! Cross product of two 3D vectors.
+    inline Vector3
+    cross(const Vector3& a, const Vector3& b)
+    {
+      Vector3 m;
+      m(0) = a(1) * b(2) - a(2) * b(1);
+      m(1) = a(2) * b(0) - a(0) * b(2);
+      m(2) = a(0) * b(1) - a(1) * b(0);
+      return m;
+    }
+
+    //! Skew symmetric matrix of a 3D vector, such that skew(a) * b is
+    //! the cross product of a and b.
+    inline Matrix3
+    skew(const Vector3& a)
+    {
+      Matrix3 m;
+      m(0, 1) = -a(2);
+      m(0, 2) = a(1);
+      m(1, 0) = a(2);
+      m(1, 2) = -a(0);
+      m(2, 0) = -a(1);
+      m(2, 1) = a(0);
+      return m;
+    }
+
+    //! Rotation matrix from body-fixed to inertial frame (ZYX Euler
+    //! angles convention).
+    //! @param[in] phi roll angle.
+    //! @param[in] theta pitch angle.
+    //! @param[in] psi yaw angle.
+    //! @return rotation matrix.
+    inline Matrix3
+    rotationZyx(double phi, double theta, double psi)
+    {
+      double cphi = std::cos(phi);
+      double sphi = std::sin(phi);
+      double ctheta = std::cos(theta);
+      double stheta = std::sin(theta);
+      double cpsi = std::cos(psi);
+      double spsi = std::sin(psi);
+
+      Matrix3 m;
+      m(0, 0) = cpsi * ctheta;
+      m(0, 1) = -spsi * cphi + cpsi * stheta * sphi;
+      m(0, 2) = spsi * sphi + cpsi * cphi * stheta;
+      m(1, 0) = spsi * ctheta;
+      m(1, 1) = cpsi * cphi + sphi * stheta * spsi;
+      m(1, 2) = -cpsi * sphi + stheta * spsi * cphi;
+      m(2, 0) = -stheta;
+      m(2, 1) = ctheta * sphi;
+      m(2, 2) = ctheta * cphi;
+      return m;
+    }
+
+    //! Rotation matrix of a unit quaternion [w x y z].
+    //! @param[in] q quaternion.
+    //! @return rotation matrix.
+    inline Matrix3
+    rotationQuaternion(const MatrixN<4, 1>& q)
+    {
+      double w = q(0);
+      double x = q(1);
+      double y = q(2);
+      double z = q(3);
+
+      Matrix3 m;
+      m(0, 0) = 1 - 2 * (y * y + z * z);
+      m(0, 1) = 2 * (x * y - z * w);
+      m(0, 2) = 2 * (x * z + y * w);
+      m(1, 0) = 2 * (x * y + z * w);
+      m(1, 1) = 1 - 2 * (x * x + z * z);
+      m(1, 2) = 2 * (y * z - x * w);
+      m(2, 0) = 2 * (x * z - y * w);
+      m(2, 1) = 2 * (y * z + x * w);
+      m(2, 2) = 1 - 2 * (x * x + y * y);
+      return m;
+    }
+
+    //! Hamilton product of two quaternions [w x y z].
+    inline MatrixN<4, 1>
+    quaternionProduct(const MatrixN<4, 1>& a, const MatrixN<4, 1>& b)
+    {
+      MatrixN<4, 1> m;
+      m(0) = a(0) * b(0) - a(1) * b(1) - a(2) * b(2) - a(3) * b(3);
+      m(1) = a(0) * b(1) + a(1) * b(0) + a(2) * b(3) - a(3) * b(2);
+      m(2) = a(0) * b(2) - a(1) * b(3) + a(2) * b(0) + a(3) * b(1);
+      m(3) = a(0) * b(3) + a(1) * b(2) - a(2) * b(1) + a(3) * b(0);
+      return m;
+    }
+
+    template <size_t R, size_t C>
+    inline std::ostream&
+    operator<<(std::ostream& os, const MatrixN<R, C>& a)
+    {
+      return os << a.toMatrix();
+    }
+  }
+}
+
+#endif
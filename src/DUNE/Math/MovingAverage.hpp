@@ -30,9 +30,8 @@
 #ifndef DUNE_MATH_MOVING_AVERAGE_HPP_INCLUDED_
 #define DUNE_MATH_MOVING_AVERAGE_HPP_INCLUDED_
 
-// ISO C++ 98 headers.
-#include <vector>
-#include <cmath>
+// DUNE headers.
+#include <DUNE/Math/SlidingWindow.hpp>
 
 namespace DUNE
 {
@@ -43,17 +42,13 @@ namespace DUNE
     {
     public:
       MovingAverage(unsigned window_size):
-        m_window_size(window_size)
-      {
-        clear();
-      }
+        m_window(window_size)
+      { }
 
       //! Clear sample.
       void
       clear(void)
       {
-        m_accum = 0;
-        m_oldest = 0;
         m_window.clear();
       }
 
@@ -62,17 +57,8 @@ namespace DUNE
       T
       update(const T& value)
       {
-        if (sampleSize() < m_window_size)
-        {
-          m_window.push_back(value);
-          m_accum += value;
-          return m_accum / sampleSize();
-        }
-
-        m_accum += value - m_window[m_oldest];
-        m_window[m_oldest] = value;
-        m_oldest = (m_oldest + 1) % m_window_size;
-        return m_accum / m_window_size;
+        m_window.update(value);
+        return m_window.mean();
       }
 
       //! Extract mean value of the sample.
@@ -80,10 +66,7 @@ namespace DUNE
       T
       mean(void)
       {
-        if (sampleSize())
-          return m_accum / sampleSize();
-        else
-          return 0;
+        return m_window.mean();
       }
 
       //! Extract standard deviation of the sample.
@@ -91,18 +74,7 @@ namespace DUNE
       T
       stdev(void)
       {
-        unsigned size = sampleSize();
-
-        if (!size)
-          return 0;
-
-        T sdev = 0;
-        T u = mean();
-
-        for (unsigned i = 0; i < size; i++)
-          sdev += (m_window[i] - u) * (m_window[i] - u);
-
-        return std::sqrt(sdev / size);
+        return m_window.stdev();
       }
 
       //! Know size of sample.
@@ -110,7 +82,7 @@ namespace DUNE
       unsigned
       sampleSize(void)
       {
-        return (unsigned)m_window.size();
+        return m_window.sampleSize();
       }
 
       //! Know size of window.
@@ -118,18 +90,12 @@ namespace DUNE
       unsigned
       windowSize(void)
       {
-        return m_window_size;
+        return m_window.windowSize();
       }
 
     private:
-      //! Accumulator.
-      T m_accum;
-      //! Window size.
-      unsigned m_window_size;
-      //! Window.
-      std::vector<T> m_window;
-      //! Index of oldest value.
-      unsigned m_oldest;
+      //! Window of samples.
+      SlidingWindow<T> m_window;
     };
   }
 }
@@ -50,12 +50,14 @@ namespace DUNE
       {
         m_accum.resize(m_wsizes.size());
 
-        m_max_size = 0;
+        m_max_size = 1;
 
         for (unsigned i = 0; i < m_wsizes.size(); ++i)
           if (m_wsizes[i] > m_max_size)
             m_max_size = m_wsizes[i];
 
+        m_window.resize(m_max_size);
+
         clear();
       }
 
@@ -64,7 +66,8 @@ namespace DUNE
       clear(void)
       {
         m_accum.assign(m_wsizes.size(), (T)0.0);
-        m_window.clear();
+        m_newest = 0;
+        m_count = 0;
       }
 
       //! Insert new sample
@@ -72,10 +75,11 @@ namespace DUNE
       void
       insertSample(const T& value)
       {
-        if (m_window.size() >= m_max_size)
-          m_window.pop_back();
+        m_newest = (m_newest + 1) % m_max_size;
+        m_window[m_newest] = value;
 
-        m_window.insert(m_window.begin(), value);
+        if (m_count < m_max_size)
+          ++m_count;
       }
 
       //! Update sample with new value.
@@ -87,8 +91,8 @@ namespace DUNE
         {
           m_accum[j] += value;
 
-          if (m_wsizes[j] <= m_window.size())
-            m_accum[j] -= m_window[m_wsizes[j] - 1];
+          if (m_wsizes[j] <= m_count)
+            m_accum[j] -= sample(m_wsizes[j] - 1);
         }
 
         insertSample(value);
@@ -101,22 +105,36 @@ namespace DUNE
       mean(unsigned j)
       {
         if (j >= m_wsizes.size())
-          std::runtime_error("multi moving average: invalid index");
+          throw std::runtime_error("multi moving average: invalid index");
 
-        if (!m_window.size())
+        if (!m_count)
           return 0.0;
 
-        if (m_wsizes[j] > m_window.size())
-          return m_accum[j] / m_window.size();
+        if (m_wsizes[j] > m_count)
+          return m_accum[j] / m_count;
         else
           return m_accum[j] / m_wsizes[j];
       }
 
     private:
+      //! Get a past sample.
+      //! @param[in] age number of samples since it was inserted (0
+      //!            for the newest).
+      //! @return sample value.
+      const T&
+      sample(unsigned age) const
+      {
+        return m_window[(m_newest + m_max_size - age) % m_max_size];
+      }
+
       //! Accumulator for each moving average.
       std::vector<T> m_accum;
-      //! Window.
+      //! Ring buffer with the most recent samples.
       std::vector<T> m_window;
+      //! Index of the newest sample.
+      unsigned m_newest;
+      //! Number of samples in the ring buffer.
+      unsigned m_count;
       //! Window sizes for each moving average
       std::vector<unsigned> m_wsizes;
       //! Maximum size of window
@@ -50,35 +50,14 @@
 #include <sstream>
 #include <stdexcept>
 
+// DUNE headers.
+#include <DUNE/Time/Clock.hpp>
+
 //#define __QPDBG__
 namespace DUNE
 {
   namespace Math
   {
-    // Template class just to encapsulate operator() in access to a std::vector
-    // (for pedantic syntactic sugar in consistencty with DUNE::Math::Matrix
-    //  and DUNE::Math::Matrix)
-    template <typename T>
-    class tvector: public std::vector<T>
-    {
-    public:
-      tvector(size_t n):
-        std::vector<T>(n)
-      { }
-
-      inline T&
-      operator()(size_t index)
-      {
-        return std::vector<T>::operator[](index);
-      }
-
-      inline const T&
-      operator()(size_t index) const
-      {
-        return std::vector<T>::operator[](index);
-      }
-    };
-
     // Utility functions
     static void
     compute_d(Matrix& d, const Matrix& J, const Matrix& np);
@@ -93,13 +72,13 @@ namespace DUNE
     add_constraint(Matrix& R, Matrix& J, Matrix& d, int& iq, double& rnorm);
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& A, Matrix& u, int n, int p, int& iq, int l);
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& A, Matrix& u, int n, int p, int& iq, int l);
 
     static void
     cholesky_decomposition(Matrix& A);
 
     static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b);
+    cholesky_solve(const Matrix& L, Matrix& y, Matrix& x, const Matrix& b);
 
     static void
     forward_elimination(const Matrix& L, Matrix& y, const Matrix& b);
@@ -117,7 +96,7 @@ namespace DUNE
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n = -1);
+    print_vector(const char* name, const std::vector<T>& v, int n = -1);
 
     static void
     print_vector(const char* name, const Matrix& v, int n = -1)
@@ -127,18 +106,233 @@ namespace DUNE
 
 #endif
 
+    QPSolver::QPSolver(void):
+      m_n(0),
+      m_p(0),
+      m_m(0),
+      m_cond(0.0),
+      m_max_iterations(0),
+      m_max_time(0.0),
+      m_iterations(0),
+      m_converged(false)
+    { }
+
+    QPSolver::QPSolver(unsigned vars, unsigned eqs, unsigned ineqs):
+      m_n(0),
+      m_p(0),
+      m_m(0),
+      m_cond(0.0),
+      m_max_iterations(0),
+      m_max_time(0.0),
+      m_iterations(0),
+      m_converged(false)
+    {
+      reserve(vars, eqs, ineqs);
+    }
+
+    void
+    QPSolver::reset(void)
+    {
+      m_warm.clear();
+    }
+
+    void
+    QPSolver::reserve(unsigned n, unsigned p, unsigned m)
+    {
+      if (n == m_n && p == m_p && m == m_m && !m_r.isEmpty())
+        return;
+
+      m_n = n;
+      m_p = p;
+      m_m = m;
+
+      // Keep constraint vectors non-empty for unconstrained problems.
+      unsigned k = std::max(m + p, 1u);
+
+      m_r.resize(n, n);
+      m_j.resize(n, n);
+      m_j0.resize(n, n);
+      m_z.resize(n, 1);
+      m_d.resize(n, 1);
+      m_np.resize(n, 1);
+      m_x_old.resize(n, 1);
+      m_s.resize(k, 1);
+      m_rv.resize(k, 1);
+      m_u.resize(k, 1);
+      m_u_old.resize(k, 1);
+
+      m_aset.assign(k, 0);
+      m_aset_old.assign(k, 0);
+      m_iai.assign(k, 0);
+      m_iaexcl.assign(k, 0);
+
+      m_warm.clear();
+      m_warm.reserve(k);
+
+      // Force factorization on the next call.
+      m_h = Matrix();
+    }
+
+    void
+    QPSolver::factorize(const Matrix& H)
+    {
+      if (!m_h.isEmpty() && m_h == H)
+        return;
+
+      int n = H.rows();
+
+      m_h.assign(H);
+      m_l.assign(H);
+
+      /* compute the trace of the original matrix G */
+      double c1 = 0.0;
+      for (int i = 0; i < n; i++)
+        c1 += H(i, i);
+
+      /* decompose the matrix H0 in the form L^T L */
+      cholesky_decomposition(m_l);
+
+      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
+      double c2 = 0.0;
+      m_d.fill(0);
+      for (int i = 0; i < n; i++)
+      {
+        m_d(i) = 1.0;
+        forward_elimination(m_l, m_z, m_d);
+        for (int j = 0; j < n; j++)
+          m_j0(i, j) = m_z(j);
+        c2 += m_z(i);
+        m_d(i) = 0.0;
+      }
+
+      /* c1 * c2 is an estimate for cond(H0) */
+      m_cond = c1 * c2;
+    }
+
+    double
+    QPSolver::warmStart(const Matrix& A, const Matrix& b, Matrix& x, double f_value, int& iq, double& R_norm)
+    {
+      int n = m_n;
+      int p = m_p;
+      int m = m_m;
+
+      for (size_t w = 0; w < m_warm.size(); ++w)
+      {
+        int ip = m_warm[w];
+        if (ip < 0 || ip >= m || iq >= n)
+          continue;
+
+        for (int j = 0; j < n; j++)
+          m_np(j) = A(ip, j);
+
+        compute_d(m_d, m_j, m_np);
+
+        // Skip constraints that became linearly dependent.
+        double dn = 0.0;
+        for (int j = iq; j < n; j++)
+          dn += m_d(j) * m_d(j);
+
+        if (std::sqrt(dn) <= std::numeric_limits<double>::epsilon() * R_norm)
+          continue;
+
+        update_z(m_z, m_j, m_d, iq);
+        update_r(m_r, m_rv, m_d, iq);
+
+        double zn = Matrix::dot(m_z, m_np);
+        if (zn <= std::numeric_limits<double>::epsilon())
+          continue;
+
+        double sum = b(ip);
+        for (int j = 0; j < n; j++)
+          sum += A(ip, j) * x(j);
+
+        // Step that makes the constraint active. Skip it if this
+        // would break dual feasibility.
+        double t = -sum / zn;
+        if (t < 0.0)
+          continue;
+
+        bool feasible = true;
+        for (int k = p; k < iq && feasible; k++)
+          feasible = m_u(k) - t * m_rv(k) >= 0.0;
+
+        if (!feasible)
+          continue;
+
+        for (int k = 0; k < n; k++)
+          x(k) += t * m_z(k);
+
+        f_value += 0.5 * (t * t) * zn;
+
+        for (int k = 0; k < iq; k++)
+          m_u(k) -= t * m_rv(k);
+
+        m_u(iq) = t;
+        m_aset[iq] = ip;
+
+        if (!add_constraint(m_r, m_j, m_d, iq, R_norm))
+        {
+          // Undo the step.
+          for (int k = 0; k < n; k++)
+            x(k) -= t * m_z(k);
+
+          f_value -= 0.5 * (t * t) * zn;
+          delete_constraint(m_r, m_j, m_aset, m_u, n, p, iq, ip);
+
+          for (int k = 0; k < iq; k++)
+            m_u(k) += t * m_rv(k);
+        }
+      }
+
+      return f_value;
+    }
+
+    bool
+    QPSolver::limitReached(double start) const
+    {
+      if (m_max_iterations > 0 && m_iterations >= m_max_iterations)
+        return true;
+
+      if (m_max_time > 0.0 && Time::Clock::get() - start >= m_max_time)
+        return true;
+
+      return false;
+    }
+
+    void
+    QPSolver::saveActiveSet(int iq)
+    {
+      m_warm.assign(m_aset.begin() + m_p, m_aset.begin() + iq);
+    }
+
     double
     QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      QPSolver solver;
+      return solver.minimize(H, f, A, b, x);
+    }
+
+    double
+    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      QPSolver solver;
+      return solver.minimize(H, f, Aeq, beq, A, b, x);
+    }
+
+    double
+    QPSolver::minimize(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
     {
       // Zero-size matrix and vector
       Matrix Aeq;
       Matrix beq;
-      return solve(H, f, Aeq, beq, A, b, x);
+      return minimize(H, f, Aeq, beq, A, b, x);
     }
 
     double
-    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
+    QPSolver::minimize(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
     {
+      double start = Time::Clock::get();
+
       // Validate parameter dimensions
       // n: number of vars
       // p: number of equality constraints
@@ -164,24 +358,40 @@ namespace DUNE
           throw Error("'beq' has an invalid size");
       }
 
+      reserve(n, p, m);
+      factorize(H);
+
       // Resize output vector
-      x.resize(n, 1);
+      if (!x.isColumnVector(n))
+        x.resize(n, 1);
 
       // Working variables
       int i, j, k, l, ip;
-      Matrix R(n, n), J(n, n);
-      Matrix s(m + p, 1), z(n, 1), r(m + p, 1), d(n, 1), np(n, 1), u(m + p, 1), x_old(n, 1), u_old(m + p, 1);
-      double f_value, psi, c1, c2, sum, ss, R_norm;
+      Matrix& R = m_r;
+      Matrix& J = m_j;
+      Matrix& s = m_s;
+      Matrix& z = m_z;
+      Matrix& r = m_rv;
+      Matrix& d = m_d;
+      Matrix& np = m_np;
+      Matrix& u = m_u;
+      Matrix& x_old = m_x_old;
+      Matrix& u_old = m_u_old;
+      double f_value, psi, sum, ss, R_norm;
       double inf = std::numeric_limits<double>::has_infinity ?
                    std::numeric_limits<double>::infinity() : 1.0E300;
 
       double t, t1, t2; /* t is the step lenght, which is the minimum of the partial step length t1
       * and the full step length t2 */
 
-      tvector<int> Aset(m + p), Aset_old(m + p), iai(m + p);
+      std::vector<int>& Aset = m_aset;
+      std::vector<int>& Aset_old = m_aset_old;
+      std::vector<int>& iai = m_iai;
+      std::vector<uint8_t>& iaexcl = m_iaexcl;
       int iq;
-      int iter = 0;
-      tvector<uint8_t> iaexcl(m + p);
+
+      m_iterations = 0;
+      m_converged = false;
 
 #ifdef __QPDBG__
       std::cout << std::endl << "Starting solve_quadprog" << std::endl;
@@ -197,44 +407,21 @@ namespace DUNE
        * Preprocessing phase
        */
 
-      /* compute the trace of the original matrix G */
-      Matrix H0(H);
-      c1 = 0.0;
-      for (i = 0; i < n; i++)
-        c1 += H0(i, i);
-
-      /* decompose the matrix H0 in the form L^T L */
-      cholesky_decomposition(H0);
-#ifdef __QPDBG__
-      print_matrix("H0", H0);
-#endif
       /* initialize the matrix R */
+      J.assign(m_j0);
       d.fill(0);
       R.fill(0);
       R_norm = 1.0; /* this variable will hold the norm of the matrix R */
-      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
-      c2 = 0.0;
-      for (i = 0; i < n; i++)
-      {
-        d(i) = 1.0;
-        forward_elimination(H0, z, d);
-        for (j = 0; j < n; j++)
-          J(i, j) = z(j);
-        c2 += z(i);
-        d(i) = 0.0;
-      }
 #ifdef __QPDBG__
       print_matrix("J", J);
 #endif
 
-      /* c1 * c2 is an estimate for cond(H0) */
-
       /*
         * Find the unconstrained minimizer of the quadratic form 0.5 * x G x + f x
        * this is a feasible point in the dual space
        * x = G^-1 * f
        */
-      cholesky_solve(H0, x, f);
+      cholesky_solve(m_l, z, x, f);
       for (i = 0; i < n; i++)
         x(i) = -x(i);
       /* and compute the current solution value */
@@ -277,7 +464,7 @@ namespace DUNE
 
         /* compute the new solution value */
         f_value += 0.5 * (t2 * t2) * Matrix::dot(z, np);
-        Aset(i) = -i - 1;
+        Aset[i] = -i - 1;
 
         if (!add_constraint(R, J, d, iq, R_norm))
           // Equality constraints are linearly dependent
@@ -286,17 +473,26 @@ namespace DUNE
 
       /* set iai = K \ A */
       for (i = 0; i < m; i++)
-        iai(i) = i;
+        iai[i] = i;
+
+      /* re-add the active set of the previous solution */
+      f_value = warmStart(A, b, x, f_value, iq, R_norm);
+
+l1:  if (limitReached(start))
+      {
+        saveActiveSet(iq);
+        return f_value;
+      }
 
-l1:  iter++;
+      m_iterations++;
     #ifdef __QPDBG__
       print_vector("x", x);
     #endif
       /* step 1: choose a violated constraint */
       for (i = p; i < iq; i++)
       {
-        ip = Aset(i);
-        iai(ip) = -1;
+        ip = Aset[i];
+        iai[ip] = -1;
       }
 
       /* compute s(x) = A^T * x + b for all elements of K \ A */
@@ -305,7 +501,7 @@ l1:  iter++;
       ip = 0; /* ip will be the index of the chosen violated constraint */
       for (i = 0; i < m; i++)
       {
-        iaexcl(i) = true;
+        iaexcl[i] = true;
         sum = 0.0;
         for (j = 0; j < n; j++)
           sum += A(i, j) * x(j);
@@ -317,9 +513,11 @@ l1:  iter++;
       print_vector("s", s, m);
     #endif
 
-      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * c1 * c2 * 100.0)
+      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * m_cond * 100.0)
       {
         /* numerically there are not infeasibilities anymore */
+        m_converged = true;
+        saveActiveSet(iq);
         return f_value;
       }
 
@@ -327,15 +525,15 @@ l1:  iter++;
       for (i = 0; i < iq; i++)
       {
         u_old(i) = u(i);
-        Aset_old(i) = Aset(i);
+        Aset_old[i] = Aset[i];
       }
       /* and for x */
-      x_old = x;
+      x_old.assign(x);
 
 l2:     /* Step 2: check for feasibility and determine a new S-pair */
       for (i = 0; i < m; i++)
       {
-        if (s(i) < ss && iai(i) != -1 && iaexcl(i))
+        if (s(i) < ss && iai[i] != -1 && iaexcl[i])
         {
           ss = s(i);
           ip = i;
@@ -343,6 +541,8 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
       }
       if (ss >= 0.0)
       {
+        m_converged = true;
+        saveActiveSet(iq);
         return f_value;
       }
 
@@ -352,7 +552,7 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
       /* set u = (u 0)^T */
       u(iq) = 0.0;
       /* add ip to the active set A */
-      Aset(iq) = ip;
+      Aset[iq] = ip;
 
     #ifdef __QPDBG__
       std::cout << "Trying with constraint " << ip << std::endl;
@@ -360,6 +560,14 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
     #endif
 
 l2a:    /* Step 2a: determine step direction */
+      if (limitReached(start))
+      {
+        saveActiveSet(iq);
+        return f_value;
+      }
+
+      m_iterations++;
+
         /* compute z = H np: the step direction in the primal space (through J, see the paper) */
       compute_d(d, J, np);
       update_z(z, J, d, iq);
@@ -383,7 +591,7 @@ l2a:    /* Step 2a: determine step direction */
           if (u(k) / r(k) < t1)
           {
             t1 = u(k) / r(k);
-            l = Aset(k);
+            l = Aset[k];
           }
         }
       }
@@ -416,7 +624,7 @@ l2a:    /* Step 2a: determine step direction */
         for (k = 0; k < iq; k++)
           u(k) -= t * r(k);
         u(iq) += t;
-        iai(l) = l;
+        iai[l] = l;
         delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
         std::cout << " in dual space: "
@@ -459,7 +667,7 @@ l2a:    /* Step 2a: determine step direction */
         if (!add_constraint(R, J, d, iq, R_norm))
         {
           std::cout << "not iaexcl " << ip << std::endl;
-          iaexcl(ip) = false;
+          iaexcl[ip] = false;
           delete_constraint(R, J, Aset, u, n, p, iq, ip);
     #ifdef __QPDBG__
           print_matrix("R", R);
@@ -467,18 +675,18 @@ l2a:    /* Step 2a: determine step direction */
           print_vector("iai", iai);
     #endif
           for (i = 0; i < m; i++)
-            iai(i) = i;
+            iai[i] = i;
           for (i = p; i < iq; i++)
           {
-            Aset(i) = Aset_old(i);
+            Aset[i] = Aset_old[i];
             u(i) = u_old(i);
-            iai(Aset(i)) = -1;
+            iai[Aset[i]] = -1;
           }
-          x = x_old;
+          x.assign(x_old);
           goto l2; /* go to step 2 */
         }
         else
-          iai(ip) = -1;
+          iai[ip] = -1;
     #ifdef __QPDBG__
         print_matrix("R", R);
         print_vector("Aset", Aset, iq);
@@ -493,7 +701,7 @@ l2a:    /* Step 2a: determine step direction */
       print_vector("x", x);
     #endif
       /* drop constraint l */
-      iai(l) = l;
+      iai[l] = l;
       delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
       print_matrix("R", R);
@@ -631,7 +839,7 @@ l2a:    /* Step 2a: determine step direction */
     }
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
     {
     #ifdef __QPDBG__
       std::cout << "Delete constraint " << l << ' ' << iq;
@@ -641,7 +849,7 @@ l2a:    /* Step 2a: determine step direction */
 
       /* Find the index qq for active constraint l to be removed */
       for (i = p; i < iq; i++)
-        if (Aset(i) == l)
+        if (Aset[i] == l)
         {
           qq = i;
           break;
@@ -650,15 +858,15 @@ l2a:    /* Step 2a: determine step direction */
       /* remove the constraint from the active set and the duals */
       for (i = qq; i < iq - 1; i++)
       {
-        Aset(i) = Aset(i + 1);
+        Aset[i] = Aset[i + 1];
         u(i) = u(i + 1);
         for (j = 0; j < n; j++)
           R(j, i) = R(j, i + 1);
       }
 
-      Aset(iq - 1) = Aset(iq);
+      Aset[iq - 1] = Aset[iq];
       u(iq - 1) = u(iq);
-      Aset(iq) = 0;
+      Aset[iq] = 0;
       u(iq) = 0.0;
       for (j = 0; j < iq; j++)
         R(j, iq - 1) = 0.0;
@@ -757,10 +965,8 @@ l2a:    /* Step 2a: determine step direction */
     }
 
     static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b)
+    cholesky_solve(const Matrix& L, Matrix& y, Matrix& x, const Matrix& b)
     {
-      Matrix y(L.rows(), 1);
-
       /* Solve L * y = b */
       forward_elimination(L, y, b);
       /* Solve L^T * x = y */
@@ -824,7 +1030,7 @@ l2a:    /* Step 2a: determine step direction */
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n)
+    print_vector(const char* name, const std::vector<T>& v, int n)
     {
       std::ostringstream s;
       std::string t;
@@ -834,7 +1040,7 @@ l2a:    /* Step 2a: determine step direction */
       s << name << ": " << std::endl << " ";
       for (int i = 0; i < n; i++)
       {
-        s << v(i) << ", ";
+        s << v[i] << ", ";
       }
       t = s.str();
       t = t.substr(0, t.size() - 2); // To remove the trailing space and comma
@@ -30,6 +30,9 @@
 #ifndef DUNE_MATH_QP_SOLVER_HPP_INCLUDED_
 #define DUNE_MATH_QP_SOLVER_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Math/Matrix.hpp>
@@ -42,6 +45,13 @@ namespace DUNE
     class DUNE_DLL_SYM QPSolver;
 
     //! Quadratic programming solver.
+    //!
+    //! Besides the one-shot static interface, a solver object can be
+    //! kept across calls when the same problem is solved repeatedly
+    //! (e.g., control allocation). In that case working storage is
+    //! allocated once for the problem size, the factorization of H is
+    //! reused while H does not change, and each call is warm-started
+    //! from the active set of the previous solution.
     class QPSolver
     {
     public:
@@ -54,6 +64,82 @@ namespace DUNE
         { }
       };
 
+      //! Constructor.
+      QPSolver(void);
+
+      //! Constructor. Preallocates working storage.
+      //! @param[in] vars number of variables.
+      //! @param[in] eqs number of equality constraints.
+      //! @param[in] ineqs number of inequality constraints.
+      QPSolver(unsigned vars, unsigned eqs, unsigned ineqs);
+
+      //! Set the maximum number of iterations of a single call to
+      //! minimize().
+      //! @param[in] iterations maximum number of iterations (0 for no limit).
+      void
+      setMaximumIterations(unsigned iterations)
+      {
+        m_max_iterations = iterations;
+      }
+
+      //! Set the maximum run time of a single call to minimize().
+      //! @param[in] time maximum time in seconds (0 for no limit).
+      void
+      setMaximumTime(double time)
+      {
+        m_max_time = time;
+      }
+
+      //! Forget the active set of the previous solution.
+      void
+      reset(void);
+
+      //! Check if the last call to minimize() reached the optimum.
+      //! @return true if the optimum was found, false if the iteration
+      //! or time limit was hit first.
+      bool
+      hasConverged(void) const
+      {
+        return m_converged;
+      }
+
+      //! Retrieve the number of iterations of the last call to minimize().
+      //! @return number of iterations.
+      unsigned
+      getIterations(void) const
+      {
+        return m_iterations;
+      }
+
+      //! Retrieve the number of active inequality constraints at the
+      //! last solution.
+      //! @return number of active inequality constraints.
+      unsigned
+      getActiveCount(void) const
+      {
+        return m_warm.size();
+      }
+
+      //! Minimize
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b
+      //! warm-starting from the previous active set. If a limit is
+      //! hit, x satisfies only the constraints in the current active
+      //! set and hasConverged() returns false.
+      double
+      minimize(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x);
+
+      //! Minimize
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b  and Aeq x = beq
+      //! warm-starting from the previous active set. If a limit is
+      //! hit, x satisfies only the constraints in the current active
+      //! set and hasConverged() returns false.
+      double
+      minimize(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
       //! Minimize
       //!   0.5 x' H x + f' x
       //! subject to:
@@ -67,6 +153,80 @@ namespace DUNE
       //!   A x <= b  and Aeq x = beq
       static double
       solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
+    private:
+      //! Resize working storage.
+      void
+      reserve(unsigned n, unsigned p, unsigned m);
+
+      //! Factorize H unless it is the same as in the previous call.
+      void
+      factorize(const Matrix& H);
+
+      //! Re-add the previous active set to the working set.
+      double
+      warmStart(const Matrix& A, const Matrix& b, Matrix& x, double f_value, int& iq, double& R_norm);
+
+      //! Store the current active set for the next call.
+      void
+      saveActiveSet(int iq);
+
+      //! Check the iteration and time limits.
+      bool
+      limitReached(double start) const;
+
+      //! Number of variables.
+      unsigned m_n;
+      //! Number of equality constraints.
+      unsigned m_p;
+      //! Number of inequality constraints.
+      unsigned m_m;
+      //! Copy of the last factorized H.
+      Matrix m_h;
+      //! Cholesky factor of H.
+      Matrix m_l;
+      //! Trace of H times trace of its inverse (condition estimate).
+      double m_cond;
+      //! Upper triangular factor R of the active constraints.
+      Matrix m_r;
+      //! Orthogonal transformation J.
+      Matrix m_j;
+      //! Inverse of the Cholesky factor (initial J).
+      Matrix m_j0;
+      //! Constraint slacks.
+      Matrix m_s;
+      //! Primal step direction.
+      Matrix m_z;
+      //! Dual step direction.
+      Matrix m_rv;
+      //! Transformed constraint normal.
+      Matrix m_d;
+      //! Constraint normal.
+      Matrix m_np;
+      //! Lagrange multipliers.
+      Matrix m_u;
+      //! Solution before a step.
+      Matrix m_x_old;
+      //! Lagrange multipliers before a step.
+      Matrix m_u_old;
+      //! Active set.
+      std::vector<int> m_aset;
+      //! Active set before a step.
+      std::vector<int> m_aset_old;
+      //! Inactive set.
+      std::vector<int> m_iai;
+      //! Constraints excluded for degeneracy.
+      std::vector<uint8_t> m_iaexcl;
+      //! Active inequality constraints of the last solution.
+      std::vector<int> m_warm;
+      //! Maximum number of iterations.
+      unsigned m_max_iterations;
+      //! Maximum run time.
+      double m_max_time;
+      //! Number of iterations of the last call.
+      unsigned m_iterations;
+      //! True if the last call reached the optimum.
+      bool m_converged;
     };
   }
 }
@@ -0,0 +1,193 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/QR.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    QR::QR(void)
+    { }
+
+    QR::QR(const Matrix& a)
+    {
+      compute(a);
+    }
+
+    void
+    QR::compute(const Matrix& a)
+    {
+      if (a.isEmpty() || a.rows() < a.columns())
+        throw Matrix::Error("Invalid dimensions!");
+
+      m_qr.assign(a);
+
+      size_t m = a.rows();
+      size_t n = a.columns();
+      m_tau.resizeAndFill(n, 1, 0.0);
+
+      double* qr = &m_qr(0, 0);
+      double* tau = &m_tau(0);
+
+      for (size_t k = 0; k < n; ++k)
+      {
+        double norm = 0.0;
+        for (size_t i = k; i < m; ++i)
+          norm += qr[i * n + k] * qr[i * n + k];
+        norm = std::sqrt(norm);
+
+        if (norm == 0.0)
+        {
+          tau[k] = 0.0;
+          continue;
+        }
+
+        double akk = qr[k * n + k];
+        double beta = (akk > 0.0) ? -norm : norm;
+        double scale = 1.0 / (akk - beta);
+        tau[k] = (beta - akk) / beta;
+
+        // Householder vector v, with v(k) = 1 implicit.
+        for (size_t i = k + 1; i < m; ++i)
+          qr[i * n + k] *= scale;
+        qr[k * n + k] = beta;
+
+        // Apply (I - tau * v * v') to the remaining columns.
+        for (size_t j = k + 1; j < n; ++j)
+        {
+          double w = qr[k * n + j];
+          for (size_t i = k + 1; i < m; ++i)
+            w += qr[i * n + k] * qr[i * n + j];
+          w *= tau[k];
+
+          qr[k * n + j] -= w;
+          for (size_t i = k + 1; i < m; ++i)
+            qr[i * n + j] -= w * qr[i * n + k];
+        }
+      }
+    }
+
+    int
+    QR::rank(void) const
+    {
+      if (m_qr.isEmpty())
+        return 0;
+
+      int n = m_qr.columns();
+      double rmax = 0.0;
+      for (int i = 0; i < n; ++i)
+        rmax = std::max(rmax, std::fabs(m_qr(i, i)));
+
+      double tol = rmax * Matrix::get_precision() * std::max(m_qr.rows(), n);
+      int r = 0;
+      for (int i = 0; i < n; ++i)
+      {
+        if (std::fabs(m_qr(i, i)) > tol)
+          ++r;
+      }
+
+      return r;
+    }
+
+    Matrix
+    QR::getR(void) const
+    {
+      int n = m_qr.columns();
+      Matrix r(n, n, 0.0);
+      for (int i = 0; i < n; ++i)
+        for (int j = i; j < n; ++j)
+          r(i, j) = m_qr(i, j);
+      return r;
+    }
+
+    void
+    QR::solve(const Matrix& b, Matrix& x)
+    {
+      if (m_qr.isEmpty())
+        throw Matrix::Error("Decomposition is not valid!");
+
+      size_t m = m_qr.rows();
+      size_t n = m_qr.columns();
+      if ((size_t)b.rows() != m)
+        throw Matrix::Error("Incompatible dimensions!");
+
+      if (rank() < (int)n)
+        throw Matrix::Error("Matrix is rank deficient!");
+
+      m_w.assign(b);
+
+      size_t c = m_w.columns();
+      const double* qr = m_qr.cbegin();
+      const double* tau = m_tau.cbegin();
+      double* w = &m_w(0, 0);
+
+      // w = Q' * b.
+      for (size_t k = 0; k < n; ++k)
+      {
+        for (size_t col = 0; col < c; ++col)
+        {
+          double s = w[k * c + col];
+          for (size_t i = k + 1; i < m; ++i)
+            s += qr[i * n + k] * w[i * c + col];
+          s *= tau[k];
+
+          w[k * c + col] -= s;
+          for (size_t i = k + 1; i < m; ++i)
+            w[i * c + col] -= s * qr[i * n + k];
+        }
+      }
+
+      // R * x = w (first n rows).
+      x.resize(n, c);
+      double* px = &x(0, 0);
+      for (size_t col = 0; col < c; ++col)
+      {
+        for (size_t i = n; i-- > 0;)
+        {
+          double v = w[i * c + col];
+          for (size_t k = i + 1; k < n; ++k)
+            v -= qr[i * n + k] * px[k * c + col];
+          px[i * c + col] = v / qr[i * n + i];
+        }
+      }
+    }
+
+    Matrix
+    QR::solve(const Matrix& b)
+    {
+      Matrix x;
+      solve(b, x);
+      return x;
+    }
+  }
+}
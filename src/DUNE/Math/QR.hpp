@@ -0,0 +1,93 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_QR_HPP_INCLUDED_
+#define DUNE_MATH_QR_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM QR;
+
+    //! QR decomposition A = Q * R of an m x n matrix (m >= n) using
+    //! Householder reflections. Used to solve linear least squares
+    //! problems without forming the normal equations.
+    class QR
+    {
+    public:
+      //! Constructor.
+      QR(void);
+
+      //! Constructor.
+      //! @param[in] a matrix with at least as many rows as columns.
+      explicit QR(const Matrix& a);
+
+      //! Decompose a matrix.
+      //! @param[in] a matrix with at least as many rows as columns.
+      void
+      compute(const Matrix& a);
+
+      //! Numerical rank of the decomposed matrix.
+      //! @return rank.
+      int
+      rank(void) const;
+
+      //! Retrieve the upper triangular factor.
+      //! @return n x n factor R.
+      Matrix
+      getR(void) const;
+
+      //! Solve the least squares problem min ||A * x - b||.
+      //! @param[in] b right hand side, with one column per system.
+      //! @param[out] x solution.
+      void
+      solve(const Matrix& b, Matrix& x);
+
+      //! Solve the least squares problem min ||A * x - b||.
+      //! @param[in] b right hand side, with one column per system.
+      //! @return solution.
+      Matrix
+      solve(const Matrix& b);
+
+    private:
+      //! R above the diagonal, Householder vectors below it.
+      Matrix m_qr;
+      //! Householder coefficients.
+      Matrix m_tau;
+      //! Workspace holding Q' * b.
+      Matrix m_w;
+    };
+  }
+}
+
+#endif
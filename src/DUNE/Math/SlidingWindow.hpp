@@ -0,0 +1,271 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_MATH_SLIDING_WINDOW_HPP_INCLUDED_
+#define DUNE_MATH_SLIDING_WINDOW_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// ISO C++ 11 headers.
+#include <cstdint>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Running statistics over the last N samples. Samples are kept
+    //! in a ring buffer; mean and variance are updated incrementally
+    //! and minimum and maximum are tracked with monotonic queues, so
+    //! every operation takes amortized constant time.
+    template <typename T>
+    class SlidingWindow
+    {
+    public:
+      //! Constructor.
+      //! @param[in] window_size number of samples in the window (at
+      //!            least one).
+      SlidingWindow(unsigned window_size):
+        m_window_size(window_size ? window_size : 1),
+        m_window(m_window_size),
+        m_min(m_window_size),
+        m_max(m_window_size)
+      {
+        clear();
+      }
+
+      //! Clear samples.
+      void
+      clear(void)
+      {
+        m_count = 0;
+        m_seq = 0;
+        m_mean = 0;
+        m_m2 = 0;
+        m_min_head = 0;
+        m_min_count = 0;
+        m_max_head = 0;
+        m_max_count = 0;
+      }
+
+      //! Add a new sample, evicting the oldest one if the window is
+      //! full.
+      //! @param[in] value new sample.
+      void
+      update(const T& value)
+      {
+        unsigned slot = (unsigned)(m_seq % m_window_size);
+
+        if (m_count < m_window_size)
+        {
+          ++m_count;
+          T delta = value - m_mean;
+          m_mean += delta / m_count;
+          m_m2 += delta * (value - m_mean);
+        }
+        else
+        {
+          T old = m_window[slot];
+          T mean = m_mean + (value - old) / m_count;
+          m_m2 += (value - old) * (value - mean + old - m_mean);
+          m_mean = mean;
+
+          if (m_m2 < 0)
+            m_m2 = 0;
+        }
+
+        // Evict samples that are leaving the window.
+        while (m_min_count && m_min[m_min_head] + m_window_size <= m_seq)
+          popFront(m_min_head, m_min_count);
+        while (m_max_count && m_max[m_max_head] + m_window_size <= m_seq)
+          popFront(m_max_head, m_max_count);
+
+        // Drop samples that can no longer be the minimum or maximum.
+        while (m_min_count && !(at(back(m_min, m_min_head, m_min_count)) < value))
+          --m_min_count;
+        while (m_max_count && !(value < at(back(m_max, m_max_head, m_max_count))))
+          --m_max_count;
+
+        m_window[slot] = value;
+        pushBack(m_min, m_min_head, m_min_count);
+        pushBack(m_max, m_max_head, m_max_count);
+
+        ++m_seq;
+
+        // Recompute statistics once per window to bound round-off.
+        if (m_count == m_window_size && slot == m_window_size - 1)
+          recompute();
+      }
+
+      //! Mean of the samples in the window.
+      //! @return mean value.
+      T
+      mean(void) const
+      {
+        return m_count ? m_mean : 0;
+      }
+
+      //! Population variance of the samples in the window.
+      //! @return variance.
+      T
+      variance(void) const
+      {
+        return m_count ? m_m2 / m_count : 0;
+      }
+
+      //! Population standard deviation of the samples in the window.
+      //! @return standard deviation.
+      T
+      stdev(void) const
+      {
+        return std::sqrt(variance());
+      }
+
+      //! Smallest sample in the window.
+      //! @return minimum value.
+      T
+      minimum(void) const
+      {
+        return m_min_count ? at(m_min[m_min_head]) : 0;
+      }
+
+      //! Largest sample in the window.
+      //! @return maximum value.
+      T
+      maximum(void) const
+      {
+        return m_max_count ? at(m_max[m_max_head]) : 0;
+      }
+
+      //! Most recent sample.
+      //! @return newest value.
+      T
+      newest(void) const
+      {
+        return m_count ? at(m_seq - 1) : 0;
+      }
+
+      //! Number of samples in the window.
+      //! @return number of samples.
+      unsigned
+      sampleSize(void) const
+      {
+        return m_count;
+      }
+
+      //! Maximum number of samples in the window.
+      //! @return window size.
+      unsigned
+      windowSize(void) const
+      {
+        return m_window_size;
+      }
+
+      //! Check if the window is full.
+      //! @return true if the window is full, false otherwise.
+      bool
+      isFull(void) const
+      {
+        return m_count == m_window_size;
+      }
+
+    private:
+      //! Sample with a given sequence number.
+      const T&
+      at(uint64_t seq) const
+      {
+        return m_window[seq % m_window_size];
+      }
+
+      //! Last sequence number of a monotonic queue.
+      uint64_t
+      back(const std::vector<uint64_t>& queue, unsigned head, unsigned count) const
+      {
+        return queue[(head + count - 1) % m_window_size];
+      }
+
+      //! Remove the first element of a monotonic queue.
+      void
+      popFront(unsigned& head, unsigned& count)
+      {
+        head = (head + 1) % m_window_size;
+        --count;
+      }
+
+      //! Append the current sequence number to a monotonic queue.
+      void
+      pushBack(std::vector<uint64_t>& queue, unsigned head, unsigned& count)
+      {
+        queue[(head + count) % m_window_size] = m_seq;
+        ++count;
+      }
+
+      //! Recompute mean and variance from the stored samples.
+      void
+      recompute(void)
+      {
+        T sum = 0;
+        for (unsigned i = 0; i < m_count; ++i)
+          sum += m_window[i];
+        m_mean = sum / m_count;
+
+        T m2 = 0;
+        for (unsigned i = 0; i < m_count; ++i)
+          m2 += (m_window[i] - m_mean) * (m_window[i] - m_mean);
+        m_m2 = m2;
+      }
+
+      //! Window size.
+      unsigned m_window_size;
+      //! Samples.
+      std::vector<T> m_window;
+      //! Sequence numbers of minimum candidates (increasing values).
+      std::vector<uint64_t> m_min;
+      //! Sequence numbers of maximum candidates (decreasing values).
+      std::vector<uint64_t> m_max;
+      //! Number of samples in the window.
+      unsigned m_count;
+      //! Sequence number of the next sample.
+      uint64_t m_seq;
+      //! Running mean.
+      T m_mean;
+      //! Running sum of squared deviations from the mean.
+      T m_m2;
+      //! First element of the minimum queue.
+      unsigned m_min_head;
+      //! Number of elements in the minimum queue.
+      unsigned m_min_count;
+      //! First element of the maximum queue.
+      unsigned m_max_head;
+      //! Number of elements in the maximum queue.
+      unsigned m_max_count;
+    };
+  }
+}
+
+#endif
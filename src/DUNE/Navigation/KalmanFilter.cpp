@@ -104,7 +104,15 @@ namespace DUNE
     void
     KalmanFilter::normalize(void)
     {
-      m_p = 0.5 * (m_p + transpose(m_p));
+      for (int i = 0; i < m_p.rows(); ++i)
+      {
+        for (int j = i + 1; j < m_p.columns(); ++j)
+        {
+          double v = 0.5 * (m_p(i, j) + m_p(j, i));
+          m_p(i, j) = v;
+          m_p(j, i) = v;
+        }
+      }
     }
 
     void
@@ -113,15 +121,31 @@ namespace DUNE
       if (u.rows() != b.columns() || u.columns() != 1)
         throw std::runtime_error(DTR("invalid dimensions"));
 
-      m_x = m_ax * m_x + b * u;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      // x = Ax * x + B * u
+      gemm(1.0, m_ax, Math::Matrix::OP_NONE, m_x, Math::Matrix::OP_NONE, 0.0, m_w_x);
+      gemm(1.0, b, Math::Matrix::OP_NONE, u, Math::Matrix::OP_NONE, 1.0, m_w_x);
+      m_x.assign(m_w_x);
+
+      predictCovariance();
     }
 
     void
     KalmanFilter::predict(void)
     {
-      m_x = m_ax * m_x;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      // x = Ax * x
+      gemm(1.0, m_ax, Math::Matrix::OP_NONE, m_x, Math::Matrix::OP_NONE, 0.0, m_w_x);
+      m_x.assign(m_w_x);
+
+      predictCovariance();
+    }
+
+    void
+    KalmanFilter::predictCovariance(void)
+    {
+      // P = Ap * P * Ap' + Q
+      gemm(1.0, m_ap, Math::Matrix::OP_NONE, m_p, Math::Matrix::OP_NONE, 0.0, m_w_p);
+      m_p.assign(m_q);
+      gemm(1.0, m_w_p, Math::Matrix::OP_NONE, m_ap, Math::Matrix::OP_TRANSPOSE, 1.0, m_p);
     }
 
     int
@@ -139,38 +163,47 @@ namespace DUNE
       if (m_r.rows() != m_r.columns() || m_r.rows() != m_innov.rows())
         throw std::runtime_error(DTR("invalid dimensions"));
 
-      // Measurement prediction covariance.
-      Math::Matrix S = (m_c * m_p * transpose(m_c)) + m_r;
-      Math::Matrix S_1;
+      // Measurement prediction covariance: S = C * P * C' + R.
+      gemm(1.0, m_c, Math::Matrix::OP_NONE, m_p, Math::Matrix::OP_NONE, 0.0, m_w_cp);
+      m_w_s.assign(m_r);
+      gemm(1.0, m_w_cp, Math::Matrix::OP_NONE, m_c, Math::Matrix::OP_TRANSPOSE, 1.0, m_w_s);
 
-      // Inverse of the measurement prediction covariance.
-      try
-      {
-        S_1 = inverse(S);
-      }
-      catch (...)
-      {
+      // Factorize S instead of inverting it.
+      if (!m_chol.compute(m_w_s))
         throw std::runtime_error(DTR("matrix inversion error"));
-      }
 
       // Check if innovation is above a threshold value.
       // Set threshold to 0 to accept everything.
       if (threshold != 0)
       {
-        double level = (transpose(m_innov) * S_1 * m_innov)(0);
+        m_chol.solve(m_innov, m_w_y);
+
+        double level = 0.0;
+        for (int i = 0; i < m_innov.rows(); ++i)
+          level += m_innov(i) * m_w_y(i);
 
         if (level >= threshold)
           return -1;
       }
 
-      // Kalman Gain.
-      Math::Matrix K = m_p * transpose(m_c) * S_1;
+      // Transposed Kalman Gain: K' = S^-1 * C * P (P is symmetric).
+      m_chol.solve(m_w_cp, m_w_k);
+
+      // State update: x = x + K * innov.
+      gemm(1.0, m_w_k, Math::Matrix::OP_TRANSPOSE, m_innov, Math::Matrix::OP_NONE, 1.0, m_x);
 
-      // State update.
-      m_x = m_x + K * m_innov;
+      // State Covariance update (Joseph form):
+      // P = (I - K * C) * P * (I - K * C)' + K * R * K'.
+      if ((size_t)m_w_ikc.rows() != m_state_count || (size_t)m_w_ikc.columns() != m_state_count)
+        m_w_ikc.resizeAndFill(m_state_count, m_state_count, 0.0);
 
-      // State Covariance update.
-      m_p = m_p - K * m_c * m_p;
+      m_w_ikc.identity();
+      gemm(-1.0, m_w_k, Math::Matrix::OP_TRANSPOSE, m_c, Math::Matrix::OP_NONE, 1.0, m_w_ikc);
+      gemm(1.0, m_w_ikc, Math::Matrix::OP_NONE, m_p, Math::Matrix::OP_NONE, 0.0, m_w_p);
+      gemm(1.0, m_w_k, Math::Matrix::OP_TRANSPOSE, m_r, Math::Matrix::OP_NONE, 0.0, m_w_kr);
+      gemm(1.0, m_w_kr, Math::Matrix::OP_NONE, m_w_k, Math::Matrix::OP_NONE, 0.0, m_p);
+      gemm(1.0, m_w_p, Math::Matrix::OP_NONE, m_w_ikc, Math::Matrix::OP_TRANSPOSE, 1.0, m_p);
+      normalize();
 
       return 0;
     }
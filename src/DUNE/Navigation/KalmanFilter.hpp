@@ -341,6 +341,10 @@ namespace DUNE
       setMeasurementNoise(double value);
 
     private:
+      //! Propagate the state covariance matrix.
+      void
+      predictCovariance(void);
+
       //! Kalman filter state count.
       size_t m_state_count;
       //! State vector.
@@ -361,6 +365,24 @@ namespace DUNE
       Math::Matrix m_r;
       //! Innovation vector.
       Math::Matrix m_innov;
+      //! Workspace for the predicted state.
+      Math::Matrix m_w_x;
+      //! Workspace for the predicted covariance.
+      Math::Matrix m_w_p;
+      //! Workspace for C * P.
+      Math::Matrix m_w_cp;
+      //! Workspace for the measurement prediction covariance.
+      Math::Matrix m_w_s;
+      //! Workspace for the transposed Kalman gain.
+      Math::Matrix m_w_k;
+      //! Workspace for I - K * C.
+      Math::Matrix m_w_ikc;
+      //! Workspace for K * R.
+      Math::Matrix m_w_kr;
+      //! Workspace for the normalized innovation.
+      Math::Matrix m_w_y;
+      //! Factorization of the measurement prediction covariance.
+      Math::Cholesky m_chol;
     };
   }
 }
@@ -0,0 +1,270 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/Network/FragmentReassembler.hpp>
+
+namespace DUNE
+{
+  namespace Network
+  {
+    //! Key that matches no message.
+    static const uint32_t c_no_key = 0xffffffff;
+
+    FragmentReassembler::FragmentReassembler(size_t max_memory, double max_age):
+      m_memory(0),
+      m_max_memory(max_memory),
+      m_max_age(max_age)
+    {
+      std::memset(&m_stats, 0, sizeof(m_stats));
+    }
+
+    void
+    FragmentReassembler::setMaxMemory(size_t max_memory)
+    {
+      m_max_memory = max_memory;
+      evict(0, c_no_key);
+    }
+
+    void
+    FragmentReassembler::setMaxAge(double max_age)
+    {
+      m_max_age = max_age;
+    }
+
+    void
+    FragmentReassembler::clear(void)
+    {
+      m_entries.clear();
+      m_memory = 0;
+    }
+
+    void
+    FragmentReassembler::erase(EntryMap::iterator itr)
+    {
+      m_memory -= itr->second.bytes;
+      m_entries.erase(itr);
+    }
+
+    void
+    FragmentReassembler::evict(size_t needed, uint32_t keep)
+    {
+      while (m_memory + needed > m_max_memory)
+      {
+        EntryMap::iterator oldest = m_entries.end();
+        for (EntryMap::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        {
+          if (itr->first == keep)
+            continue;
+
+          if (oldest == m_entries.end() || itr->second.created < oldest->second.created)
+            oldest = itr;
+        }
+
+        if (oldest == m_entries.end())
+          break;
+
+        erase(oldest);
+        ++m_stats.evicted;
+      }
+    }
+
+    IMC::Message*
+    FragmentReassembler::add(const IMC::MessagePart* part, double now)
+    {
+      if (part->num_frags == 0 || part->frag_number >= part->num_frags)
+      {
+        ++m_stats.invalid;
+        return NULL;
+      }
+
+      uint32_t key = getKey(part->getSource(), part->uid);
+      EntryMap::iterator itr = m_entries.find(key);
+
+      // Identifiers wrap around: a different number of fragments
+      // means that this is a new message.
+      if (itr != m_entries.end() && itr->second.num_frags != part->num_frags)
+      {
+        erase(itr);
+        itr = m_entries.end();
+      }
+
+      if (itr != m_entries.end() && itr->second.received[part->frag_number])
+      {
+        ++m_stats.duplicates;
+        itr->second.updated = now;
+        return NULL;
+      }
+
+      // Bound memory, never evicting the message being assembled.
+      size_t bytes = part->data.size();
+      evict(bytes, key);
+
+      if (itr == m_entries.end())
+      {
+        Entry e;
+        e.num_frags = part->num_frags;
+        e.received.resize(e.num_frags, false);
+        e.data.resize(e.num_frags);
+        e.missing = e.num_frags;
+        e.bytes = 0;
+        e.created = now;
+        e.nacked = now;
+        itr = m_entries.insert(std::make_pair(key, e)).first;
+      }
+
+      Entry& e = itr->second;
+      e.received[part->frag_number] = true;
+      e.data[part->frag_number] = part->data;
+      e.bytes += bytes;
+      e.updated = now;
+      --e.missing;
+      m_memory += bytes;
+      ++m_stats.fragments;
+
+      if (e.missing > 0)
+        return NULL;
+
+      // Message is complete: concatenate all fragments.
+      std::vector<char> data;
+      data.reserve(e.bytes);
+      for (unsigned i = 0; i < e.num_frags; ++i)
+        data.insert(data.end(), e.data[i].begin(), e.data[i].end());
+
+      erase(itr);
+
+      if (data.empty())
+      {
+        ++m_stats.invalid;
+        return NULL;
+      }
+
+      try
+      {
+        IMC::Message* msg = IMC::Packet::deserialize((uint8_t*)&data[0], data.size());
+        ++m_stats.completed;
+        m_stats.bytes += data.size();
+        return msg;
+      }
+      catch (std::exception&)
+      {
+        ++m_stats.invalid;
+        return NULL;
+      }
+    }
+
+    unsigned
+    FragmentReassembler::expire(double now)
+    {
+      unsigned count = 0;
+
+      EntryMap::iterator itr = m_entries.begin();
+      while (itr != m_entries.end())
+      {
+        if (now - itr->second.created > m_max_age)
+        {
+          EntryMap::iterator next = itr;
+          ++next;
+          erase(itr);
+          itr = next;
+          ++count;
+        }
+        else
+        {
+          ++itr;
+        }
+      }
+
+      m_stats.expired += count;
+      return count;
+    }
+
+    void
+    FragmentReassembler::getNacks(double now, double delay, std::vector<Nack>& nacks)
+    {
+      for (EntryMap::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+      {
+        Entry& e = itr->second;
+
+        if ((now - e.updated < delay) || (now - e.nacked < delay))
+          continue;
+
+        Nack nack;
+        nack.src = itr->first >> 8;
+        nack.uid = itr->first & 0xff;
+        for (unsigned i = 0; i < e.num_frags; ++i)
+        {
+          if (!e.received[i])
+            nack.missing.push_back(i);
+        }
+
+        e.nacked = now;
+        nacks.push_back(nack);
+        ++m_stats.nacks;
+      }
+    }
+
+    int
+    FragmentReassembler::getFragmentsMissing(uint16_t src, uint8_t uid) const
+    {
+      EntryMap::const_iterator itr = m_entries.find(getKey(src, uid));
+      if (itr == m_entries.end())
+        return -1;
+
+      return itr->second.missing;
+    }
+
+    IMC::MessagePart*
+    FragmentReassembler::createNack(const Nack& nack)
+    {
+      IMC::MessagePart* part = new IMC::MessagePart;
+      part->setDestination(nack.src);
+      part->uid = nack.uid;
+      part->num_frags = 0;
+      part->frag_number = nack.missing.size();
+      part->data.assign(nack.missing.begin(), nack.missing.end());
+      return part;
+    }
+
+    bool
+    FragmentReassembler::parseNack(const IMC::MessagePart* part, Nack& nack)
+    {
+      if (part->num_frags != 0 || part->frag_number != part->data.size())
+        return false;
+
+      nack.src = part->getDestination();
+      nack.uid = part->uid;
+      nack.missing.assign(part->data.begin(), part->data.end());
+      return true;
+    }
+  }
+}
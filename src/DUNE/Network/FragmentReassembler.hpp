@@ -0,0 +1,238 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_NETWORK_FRAGMENT_REASSEMBLER_HPP_INCLUDED_
+#define DUNE_NETWORK_FRAGMENT_REASSEMBLER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+
+namespace DUNE
+{
+  namespace Network
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM FragmentReassembler;
+
+    //! Selective-repeat reassembly of fragmented messages. Received
+    //! fragments are tracked in a bitmap per message, so that the
+    //! missing ones can be requested with negative acknowledgements
+    //! (NACKs) instead of resending the whole message. Memory used
+    //! by incomplete messages is bounded, evicting the oldest ones
+    //! first.
+    //!
+    //! IMC has no dedicated NACK message, so NACKs are encoded as a
+    //! MessagePart with zero fragments, where 'uid' identifies the
+    //! message, 'frag_number' is the number of missing fragments and
+    //! 'data' holds their numbers.
+    class FragmentReassembler
+    {
+    public:
+      //! Reassembly statistics.
+      struct Statistics
+      {
+        //! Fragments accepted.
+        uint64_t fragments;
+        //! Duplicate fragments.
+        uint64_t duplicates;
+        //! Invalid fragments.
+        uint64_t invalid;
+        //! Messages reassembled.
+        uint64_t completed;
+        //! Incomplete messages dropped for being too old.
+        uint64_t expired;
+        //! Incomplete messages dropped to bound memory usage.
+        uint64_t evicted;
+        //! NACKs generated.
+        uint64_t nacks;
+        //! Bytes of reassembled messages.
+        uint64_t bytes;
+      };
+
+      //! Request for missing fragments.
+      struct Nack
+      {
+        //! Source of the fragmented message.
+        uint16_t src;
+        //! Identifier of the fragmented message.
+        uint8_t uid;
+        //! Numbers of the missing fragments.
+        std::vector<uint8_t> missing;
+      };
+
+      //! Constructor.
+      //! @param[in] max_memory maximum number of bytes held by
+      //! incomplete messages.
+      //! @param[in] max_age maximum age in seconds of incomplete
+      //! messages.
+      FragmentReassembler(size_t max_memory = 1024 * 1024, double max_age = 1800.0);
+
+      //! Set the maximum number of bytes held by incomplete messages.
+      //! @param[in] max_memory number of bytes.
+      void
+      setMaxMemory(size_t max_memory);
+
+      //! Set the maximum age of incomplete messages.
+      //! @param[in] max_age age in seconds.
+      void
+      setMaxAge(double max_age);
+
+      //! Add a fragment.
+      //! @param[in] part fragment.
+      //! @param[in] now current time.
+      //! @return reassembled message, which must be deleted by the
+      //! caller, or NULL if the message is still incomplete.
+      IMC::Message*
+      add(const IMC::MessagePart* part, double now);
+
+      //! Drop incomplete messages older than the maximum age.
+      //! @param[in] now current time.
+      //! @return number of dropped messages.
+      unsigned
+      expire(double now);
+
+      //! Retrieve the missing fragments of the incomplete messages
+      //! that received no fragment, nor were NACKed, in the last
+      //! 'delay' seconds.
+      //! @param[in] now current time.
+      //! @param[in] delay time without activity in seconds.
+      //! @param[out] nacks requests for missing fragments.
+      void
+      getNacks(double now, double delay, std::vector<Nack>& nacks);
+
+      //! Retrieve the number of missing fragments of a message.
+      //! @param[in] src source of the fragmented message.
+      //! @param[in] uid identifier of the fragmented message.
+      //! @return number of missing fragments, or -1 if the message
+      //! is unknown.
+      int
+      getFragmentsMissing(uint16_t src, uint8_t uid) const;
+
+      //! Retrieve the number of incomplete messages.
+      //! @return number of messages.
+      size_t
+      size(void) const
+      {
+        return m_entries.size();
+      }
+
+      //! Retrieve the number of bytes held by incomplete messages.
+      //! @return number of bytes.
+      size_t
+      getMemoryUsage(void) const
+      {
+        return m_memory;
+      }
+
+      //! Retrieve the reassembly statistics.
+      //! @return statistics.
+      const Statistics&
+      getStatistics(void) const
+      {
+        return m_stats;
+      }
+
+      //! Drop all incomplete messages.
+      void
+      clear(void);
+
+      //! Create a NACK message.
+      //! @param[in] nack request for missing fragments.
+      //! @return new message, which must be deleted by the caller.
+      static IMC::MessagePart*
+      createNack(const Nack& nack);
+
+      //! Test if a fragment is a NACK and decode it.
+      //! @param[in] part fragment.
+      //! @param[out] nack request for missing fragments, whose
+      //! source is the destination of the NACK.
+      //! @return true if the fragment is a NACK, false otherwise.
+      static bool
+      parseNack(const IMC::MessagePart* part, Nack& nack);
+
+    private:
+      //! Incomplete message.
+      struct Entry
+      {
+        //! Number of fragments.
+        unsigned num_frags;
+        //! Received fragment bitmap.
+        std::vector<bool> received;
+        //! Fragment data.
+        std::vector<std::vector<char> > data;
+        //! Number of missing fragments.
+        unsigned missing;
+        //! Bytes held.
+        size_t bytes;
+        //! Time of the first fragment.
+        double created;
+        //! Time of the last fragment.
+        double updated;
+        //! Time of the last NACK.
+        double nacked;
+      };
+
+      //! Incomplete messages by source and identifier.
+      typedef std::map<uint32_t, Entry> EntryMap;
+
+      //! Incomplete messages.
+      EntryMap m_entries;
+      //! Bytes held by incomplete messages.
+      size_t m_memory;
+      //! Maximum bytes held by incomplete messages.
+      size_t m_max_memory;
+      //! Maximum age of incomplete messages.
+      double m_max_age;
+      //! Statistics.
+      Statistics m_stats;
+
+      static uint32_t
+      getKey(uint16_t src, uint8_t uid)
+      {
+        return ((uint32_t)src << 8) | uid;
+      }
+
+      void
+      erase(EntryMap::iterator itr);
+
+      //! Evict the oldest incomplete messages until there is room
+      //! for more data.
+      //! @param[in] needed number of bytes needed.
+      //! @param[in] keep key of a message that must not be evicted.
+      void
+      evict(size_t needed, uint32_t keep);
+    };
+  }
+}
+
+#endif
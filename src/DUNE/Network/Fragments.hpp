@@ -49,6 +49,14 @@ namespace DUNE
       int
       getNumberOfFragments(void);
 
+      //! Retrieve the identifier of the fragmented message.
+      //! @return message identifier.
+      int
+      getUid(void) const
+      {
+        return m_uid;
+      }
+
       ~Fragments(void);
 
     private:
@@ -56,6 +64,12 @@ namespace DUNE
       int m_uid;
       int m_num_frags;
       std::vector<IMC::MessagePart*> m_fragments;
+
+      //! Non-copyable.
+      Fragments(const Fragments&);
+
+      Fragments&
+      operator=(const Fragments&);
     };
 
   }
@@ -0,0 +1,142 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Network/RateController.hpp>
+
+namespace DUNE
+{
+  namespace Network
+  {
+    //! Weight of new loss samples.
+    static const double c_loss_gain = 0.3;
+    //! Weight of new goodput samples.
+    static const double c_goodput_gain = 0.3;
+    //! Quality below which rates are decreased.
+    static const double c_quality_low = 0.25;
+    //! Quality above which rates may be increased.
+    static const double c_quality_high = 0.5;
+
+    RateController::RateController(double period):
+      m_period(period),
+      m_min_scale(0.1),
+      m_loss_low(0.05),
+      m_loss_high(0.2),
+      m_increase(0.1),
+      m_decrease(0.5)
+    {
+      reset();
+    }
+
+    void
+    RateController::setMinimumScale(double scale)
+    {
+      m_min_scale = std::min(1.0, std::max(scale, 1e-3));
+      m_scale = std::max(m_scale, m_min_scale);
+    }
+
+    void
+    RateController::setQuality(double quality)
+    {
+      m_quality = std::min(1.0, std::max(quality, 0.0));
+    }
+
+    void
+    RateController::setQuality(double margin, double low, double high)
+    {
+      if (high <= low)
+        setQuality(margin >= high ? 1.0 : 0.0);
+      else
+        setQuality((margin - low) / (high - low));
+    }
+
+    bool
+    RateController::update(double now)
+    {
+      if (m_last < 0)
+      {
+        m_last = now;
+        return false;
+      }
+
+      double elapsed = now - m_last;
+      if (elapsed < m_period)
+        return false;
+
+      m_last = now;
+
+      // Without outcomes there is no evidence about the link: hold the
+      // loss estimate.
+      unsigned total = m_delivered + m_lost;
+      if (total > 0)
+      {
+        double loss = (double)m_lost / total;
+        m_loss += c_loss_gain * (loss - m_loss);
+      }
+
+      double offered = m_bytes / elapsed;
+      m_offered += c_goodput_gain * (offered - m_offered);
+      m_goodput += c_goodput_gain * (offered * (1.0 - m_loss) - m_goodput);
+
+      m_bytes = 0;
+      m_delivered = 0;
+      m_lost = 0;
+
+      double scale = m_scale;
+      if (m_loss > m_loss_high && m_offered > 0)
+        // Offer only what the link has been delivering.
+        scale = std::max(m_min_scale, m_scale * m_goodput / m_offered);
+      else if (m_loss > m_loss_high || m_quality < c_quality_low)
+        scale = std::max(m_min_scale, m_scale * m_decrease);
+      else if (m_loss < m_loss_low && m_quality >= c_quality_high)
+        scale = std::min(1.0, m_scale + m_increase);
+
+      if (scale == m_scale)
+        return false;
+
+      m_scale = scale;
+      return true;
+    }
+
+    void
+    RateController::reset(void)
+    {
+      m_scale = 1.0;
+      m_loss = 0.0;
+      m_quality = 1.0;
+      m_goodput = 0.0;
+      m_offered = 0.0;
+      m_last = -1.0;
+      m_bytes = 0;
+      m_delivered = 0;
+      m_lost = 0;
+    }
+  }
+}
@@ -0,0 +1,201 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_NETWORK_RATE_CONTROLLER_HPP_INCLUDED_
+#define DUNE_NETWORK_RATE_CONTROLLER_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Network
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM RateController;
+
+    //! Adaptive rate control for telemetry links.
+    //!
+    //! The controller computes a scale factor, between a minimum and
+    //! one, to apply to the configured send rates of a link. It is fed
+    //! with delivery outcomes (acknowledged or lost transmissions,
+    //! missed periodic messages) and, optionally, with a link quality
+    //! derived from signal strength. Once per update period the scale
+    //! is decreased if the link is congested or weak and increased
+    //! additively if it is healthy, so the offered load tracks what
+    //! the link can deliver.
+    //!
+    //! On congestion, if the bytes sent are accounted, the scale is
+    //! cut to the share of the offered load that the link delivered
+    //! (goodput over offered rate). Without byte counts, and on a
+    //! weak link, it is decreased multiplicatively.
+    class RateController
+    {
+    public:
+      //! Constructor.
+      //! @param[in] period update period in seconds.
+      RateController(double period = 1.0);
+
+      //! Set the update period.
+      //! @param[in] period period in seconds.
+      void
+      setPeriod(double period)
+      {
+        m_period = period;
+      }
+
+      //! Set the minimum scale factor.
+      //! @param[in] scale minimum scale, in ]0, 1].
+      void
+      setMinimumScale(double scale);
+
+      //! Set the packet loss thresholds.
+      //! @param[in] low loss below which rates are increased.
+      //! @param[in] high loss above which rates are decreased.
+      void
+      setLossThresholds(double low, double high)
+      {
+        m_loss_low = low;
+        m_loss_high = high;
+      }
+
+      //! Set the adaptation steps.
+      //! @param[in] increase additive increase per period.
+      //! @param[in] decrease multiplicative decrease per period.
+      void
+      setSteps(double increase, double decrease)
+      {
+        m_increase = increase;
+        m_decrease = decrease;
+      }
+
+      //! Account bytes sent over the link.
+      //! @param[in] bytes number of bytes.
+      void
+      sent(unsigned bytes)
+      {
+        m_bytes += bytes;
+      }
+
+      //! Account delivery outcomes.
+      //! @param[in] delivered number of transmissions known to be
+      //! delivered.
+      //! @param[in] lost number of transmissions known to be lost.
+      void
+      outcome(unsigned delivered, unsigned lost)
+      {
+        m_delivered += delivered;
+        m_lost += lost;
+      }
+
+      //! Set the link quality.
+      //! @param[in] quality quality in [0, 1] (1 for a strong link).
+      void
+      setQuality(double quality);
+
+      //! Set the link quality from a signal to noise margin.
+      //! @param[in] margin measured margin.
+      //! @param[in] low margin at (and below) which quality is 0.
+      //! @param[in] high margin at (and above) which quality is 1.
+      void
+      setQuality(double margin, double low, double high);
+
+      //! Update the scale factor if the update period has elapsed.
+      //! @param[in] now current time.
+      //! @return true if the scale factor changed.
+      bool
+      update(double now);
+
+      //! Restore full rates and clear measurements.
+      void
+      reset(void);
+
+      //! Scale factor to apply to send rates.
+      double
+      getScale(void) const
+      {
+        return m_scale;
+      }
+
+      //! Filtered packet loss ratio.
+      double
+      getLoss(void) const
+      {
+        return m_loss;
+      }
+
+      //! Link quality.
+      double
+      getQuality(void) const
+      {
+        return m_quality;
+      }
+
+      //! Filtered goodput (bytes sent and not lost), in bytes per
+      //! second.
+      double
+      getGoodput(void) const
+      {
+        return m_goodput;
+      }
+
+    private:
+      //! Update period.
+      double m_period;
+      //! Minimum scale.
+      double m_min_scale;
+      //! Loss below which rates are increased.
+      double m_loss_low;
+      //! Loss above which rates are decreased.
+      double m_loss_high;
+      //! Additive increase.
+      double m_increase;
+      //! Multiplicative decrease.
+      double m_decrease;
+      //! Current scale.
+      double m_scale;
+      //! Filtered loss.
+      double m_loss;
+      //! Link quality.
+      double m_quality;
+      //! Filtered goodput.
+      double m_goodput;
+      //! Filtered offered rate.
+      double m_offered;
+      //! Time of last update (negative before the first one).
+      double m_last;
+      //! Bytes sent since last update.
+      unsigned m_bytes;
+      //! Transmissions delivered since last update.
+      unsigned m_delivered;
+      //! Transmissions lost since last update.
+      unsigned m_lost;
+    };
+  }
+}
+
+#endif
@@ -231,6 +231,24 @@ namespace DUNE
       return static_cast<size_t>(rv);
     }
 
+    size_t
+    TCPSocket::peek(uint8_t* bfr, size_t size)
+    {
+      ssize_t rv = ::recv(m_handle, (char*)bfr, size, MSG_PEEK);
+      if (rv == 0)
+      {
+        throw ConnectionClosed();
+      }
+      else if (rv < 0)
+      {
+        if (errno == ECONNRESET)
+          throw ConnectionClosed();
+        throw NetworkError(DTR("error receiving data"), getLastErrorMessage());
+      }
+
+      return static_cast<size_t>(rv);
+    }
+
     size_t
     TCPSocket::doWrite(const uint8_t* bfr, size_t size)
     {
@@ -77,6 +77,14 @@ namespace DUNE
       bool
       writeFile(const char* filename, int64_t off_end, int64_t off_beg = -1);
 
+      //! Read data without removing it from the input queue, so
+      //! that a subsequent read returns the same data.
+      //! @param[out] bfr data buffer.
+      //! @param[in] size capacity of the data buffer.
+      //! @return number of bytes available in the data buffer.
+      size_t
+      peek(uint8_t* bfr, size_t size);
+
       //! Enable/disable keep-alive messages. When enabled connections
       //! are kept active by periodically transmitting messages.
       //! @param[in] enabled true to enable this feature, false to
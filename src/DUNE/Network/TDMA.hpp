@@ -50,7 +50,9 @@ namespace DUNE
     {
     public:
       //! Empty Constructor.
-      TDMA(void)
+      TDMA(void):
+        m_slot_count(0),
+        m_slot_duration(0)
       { }
 
       //! Constructor.
@@ -90,6 +92,28 @@ namespace DUNE
         return false;
       }
 
+      //! Check if a given instant lies inside one of our slots. Unlike
+      //! check(), which only signals the beginning of a slot, this
+      //! covers the whole slot duration.
+      //! @param[in] time UTC time in seconds (since midnight or epoch).
+      //! @return true if we are inside a slot, false otherwise.
+      bool
+      inSlot(double time) const
+      {
+        if (m_slot_count == 0 || m_slot_duration == 0)
+          return false;
+
+        double sec = std::fmod(time, 60.0);
+        std::set<unsigned>::const_iterator itr = m_seconds.begin();
+        for (; itr != m_seconds.end(); ++itr)
+        {
+          if (sec >= *itr && sec < *itr + m_slot_duration)
+            return true;
+        }
+
+        return false;
+      }
+
       //! Set number of total slots.
       //! @param[in] number total number of slots.
       void
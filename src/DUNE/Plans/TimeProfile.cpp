@@ -217,15 +217,16 @@ namespace DUNE
       }
       else
       {
+        // All points are offsets from the same origin.
+        Coordinates::LocalTangentPlane ltp(maneuver->lat, maneuver->lon);
+
         // Iterate point list
         for (; itr != maneuver->points.end(); itr++)
         {
           if ((*itr) == NULL)
             continue;
 
-          pos.lat = maneuver->lat;
-          pos.lon = maneuver->lon;
-          Coordinates::WGS84::displace((*itr)->x, (*itr)->y, &pos.lat, &pos.lon);
+          ltp.fromNED((*itr)->x, (*itr)->y, 0.0, &pos.lat, &pos.lon);
 
           float travelled = distance3D(pos, last_pos);
 
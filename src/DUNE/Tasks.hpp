@@ -51,6 +51,7 @@ namespace DUNE
 #include <DUNE/Tasks/ParameterTable.hpp>
 #include <DUNE/Tasks/SimpleTransport.hpp>
 #include <DUNE/Tasks/MessageFilter.hpp>
+#include <DUNE/Tasks/MessageDecimator.hpp>
 #include <DUNE/Tasks/SourceFilter.hpp>
 
 #endif
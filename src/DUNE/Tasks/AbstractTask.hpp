@@ -61,6 +61,11 @@ namespace DUNE
       virtual void
       receive(const IMC::Message* msg) = 0;
 
+      //! Retrieve the number of messages queued for consumption.
+      //! @return number of queued messages.
+      virtual unsigned
+      getQueueSize(void) = 0;
+
       //! Retrieve task name.
       //! @return task name.
       virtual const char*
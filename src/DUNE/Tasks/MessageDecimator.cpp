@@ -0,0 +1,293 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/I18N.hpp>
+#include <DUNE/Tasks/MessageDecimator.hpp>
+#include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Utils/String.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Compute rule key.
+    static uint32_t
+    getRuleKey(uint32_t id, unsigned eid)
+    {
+      return (id << 8) | (eid & 0xff);
+    }
+
+    //! Compute stream key.
+    static uint64_t
+    getStreamKey(const IMC::Message* msg)
+    {
+      return ((uint64_t)msg->getSource() << 40)
+      | ((uint64_t)msg->getId() << 24)
+      | ((uint64_t)msg->getSourceEntity() << 16)
+      | msg->getSubId();
+    }
+
+    //! Parse decimation mode.
+    static bool
+    parseMode(const std::string& str, MessageDecimator::Mode& mode)
+    {
+      if (str == "Rate")
+        mode = MessageDecimator::MODE_RATE;
+      else if (str == "Mean")
+        mode = MessageDecimator::MODE_MEAN;
+      else if (str == "Minimum")
+        mode = MessageDecimator::MODE_MINIMUM;
+      else if (str == "Maximum")
+        mode = MessageDecimator::MODE_MAXIMUM;
+      else if (str == "Deadband")
+        mode = MessageDecimator::MODE_DEADBAND;
+      else
+        return false;
+
+      return true;
+    }
+
+    MessageDecimator::MessageDecimator(void)
+    { }
+
+    MessageDecimator::~MessageDecimator(void)
+    {
+      clear();
+    }
+
+    void
+    MessageDecimator::setup(const std::vector<std::string>& spec, const Task* task)
+    {
+      clear();
+      m_rules.clear();
+
+      for (unsigned i = 0; i < spec.size(); ++i)
+      {
+        std::vector<std::string> parts;
+        Utils::String::split(spec[i], ":", parts);
+
+        Rule rule;
+        rule.threshold = 0;
+
+        if ((parts.size() != 3 && parts.size() != 4)
+            || !parseMode(parts[1], rule.mode)
+            || std::sscanf(parts[2].c_str(), "%lf", &rule.period) != 1
+            || rule.period < 0
+            || (parts.size() == 4 && std::sscanf(parts[3].c_str(), "%lf", &rule.threshold) != 1))
+          throw std::runtime_error(Utils::String::str(DTR("invalid decimation rule: %s"), spec[i].c_str()));
+
+        std::vector<std::string> target;
+        Utils::String::split(parts[0], "@", target);
+
+        uint32_t id = IMC::Factory::getIdFromAbbrev(target[0]);
+        unsigned eid = DUNE_IMC_CONST_UNK_EID;
+
+        if (target.size() > 1)
+        {
+          if (task == NULL)
+            throw std::runtime_error(Utils::String::str(DTR("invalid decimation rule: %s"), spec[i].c_str()));
+
+          try
+          {
+            eid = task->resolveEntity(target[1]);
+          }
+          catch (...)
+          {
+            // Entity not present in this system.
+            continue;
+          }
+        }
+
+        m_rules[getRuleKey(id, eid)] = rule;
+      }
+    }
+
+    const MessageDecimator::Rule*
+    MessageDecimator::findRule(const IMC::Message* msg) const
+    {
+      if (m_rules.empty())
+        return NULL;
+
+      std::map<uint32_t, Rule>::const_iterator itr = m_rules.find(getRuleKey(msg->getId(), msg->getSourceEntity()));
+      if (itr == m_rules.end())
+        itr = m_rules.find(getRuleKey(msg->getId(), DUNE_IMC_CONST_UNK_EID));
+
+      if (itr == m_rules.end())
+        return NULL;
+
+      return &itr->second;
+    }
+
+    bool
+    MessageDecimator::matches(const IMC::Message* msg) const
+    {
+      return findRule(msg) != NULL;
+    }
+
+    bool
+    MessageDecimator::filter(const IMC::Message* msg, double now)
+    {
+      const Rule* rule = findRule(msg);
+      if (rule == NULL)
+        return false;
+
+      uint64_t key = getStreamKey(msg);
+      double value = msg->getValueFP();
+
+      std::map<uint64_t, Stream>::iterator itr = m_streams.find(key);
+      if (itr == m_streams.end())
+      {
+        Stream& stream = m_streams[key];
+        stream.rule = rule;
+        stream.time = now;
+        stream.value = value;
+        stream.count = 0;
+        stream.accum = 0;
+        stream.last = NULL;
+
+        if (rule->mode == MODE_RATE || rule->mode == MODE_DEADBAND)
+          return false;
+
+        itr = m_streams.find(key);
+      }
+
+      Stream& stream = itr->second;
+
+      switch (rule->mode)
+      {
+        case MODE_RATE:
+          if (now - stream.time < rule->period)
+            return true;
+
+          stream.time = now;
+          return false;
+
+        case MODE_DEADBAND:
+          if (std::fabs(value - stream.value) <= rule->threshold
+              && (rule->period <= 0 || now - stream.time < rule->period))
+            return true;
+
+          stream.time = now;
+          stream.value = value;
+          return false;
+
+        default:
+          break;
+      }
+
+      // Aggregation modes.
+      if (stream.count > 0 && now - stream.time >= rule->period)
+        complete(stream);
+
+      if (stream.count == 0)
+      {
+        stream.time = now;
+        stream.accum = value;
+      }
+      else if (rule->mode == MODE_MEAN)
+      {
+        stream.accum += value;
+      }
+      else if (rule->mode == MODE_MINIMUM)
+      {
+        if (value < stream.accum)
+          stream.accum = value;
+      }
+      else if (value > stream.accum)
+      {
+        stream.accum = value;
+      }
+
+      ++stream.count;
+      delete stream.last;
+      stream.last = msg->clone();
+
+      return true;
+    }
+
+    void
+    MessageDecimator::complete(Stream& stream)
+    {
+      if (stream.count == 0)
+        return;
+
+      if (stream.rule->mode == MODE_MEAN)
+        stream.last->setValueFP(stream.accum / stream.count);
+      else
+        stream.last->setValueFP(stream.accum);
+
+      m_ready.push_back(stream.last);
+      stream.last = NULL;
+      stream.count = 0;
+    }
+
+    IMC::Message*
+    MessageDecimator::pop(double now)
+    {
+      if (m_ready.empty())
+      {
+        std::map<uint64_t, Stream>::iterator itr = m_streams.begin();
+        for (; itr != m_streams.end(); ++itr)
+        {
+          if (itr->second.count > 0 && now - itr->second.time >= itr->second.rule->period)
+            complete(itr->second);
+        }
+      }
+
+      if (m_ready.empty())
+        return NULL;
+
+      IMC::Message* msg = m_ready.front();
+      m_ready.pop_front();
+      return msg;
+    }
+
+    void
+    MessageDecimator::clear(void)
+    {
+      std::map<uint64_t, Stream>::iterator itr = m_streams.begin();
+      for (; itr != m_streams.end(); ++itr)
+        delete itr->second.last;
+
+      m_streams.clear();
+
+      while (!m_ready.empty())
+      {
+        delete m_ready.front();
+        m_ready.pop_front();
+      }
+    }
+  }
+}
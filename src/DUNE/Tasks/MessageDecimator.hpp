@@ -0,0 +1,177 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_MESSAGE_DECIMATOR_HPP_INCLUDED_
+#define DUNE_TASKS_MESSAGE_DECIMATOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Forward declarations.
+    class Task;
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM MessageDecimator;
+
+    //! Reduce the volume of message streams according to per message
+    //! and per entity rules. Rules are specified as
+    //! <Message>[@<Entity>]:<Mode>:<Period>[:<Threshold>], where
+    //! <Mode> is one of:
+    //!  - Rate: pass at most one message per period.
+    //!  - Mean, Minimum, Maximum: aggregate the 'value' field over
+    //!    windows of the given period and output one message per
+    //!    window.
+    //!  - Deadband: pass a message when its 'value' field changed by
+    //!    more than the threshold since the last passed message, or
+    //!    when the period (if not zero) elapsed.
+    //!
+    //! Streams are identified by message, source system, source
+    //! entity and sub identification number, and state is updated
+    //! incrementally. Times are supplied by the caller, normally the
+    //! local time of reception, and filter() and pop() must use the
+    //! same clock. Message timestamps are not used, so replayed or
+    //! delayed messages do not close windows early.
+    class MessageDecimator
+    {
+    public:
+      //! Decimation modes.
+      enum Mode
+      {
+        //! Rate limiting.
+        MODE_RATE,
+        //! Window mean.
+        MODE_MEAN,
+        //! Window minimum.
+        MODE_MINIMUM,
+        //! Window maximum.
+        MODE_MAXIMUM,
+        //! Change threshold.
+        MODE_DEADBAND
+      };
+
+      //! Constructor.
+      MessageDecimator(void);
+
+      //! Destructor.
+      ~MessageDecimator(void);
+
+      //! Configure decimation rules. Existing stream state is
+      //! discarded.
+      //! @param[in] spec list of rule specifications.
+      //! @param[in] task task used to resolve entity labels.
+      void
+      setup(const std::vector<std::string>& spec, const Task* task = NULL);
+
+      //! Check if a message has decimation rules.
+      //! @param[in] msg message.
+      //! @return true if the message is decimated, false otherwise.
+      bool
+      matches(const IMC::Message* msg) const;
+
+      //! Update decimation state with a new message.
+      //! @param[in] msg message.
+      //! @param[in] now time of reception, in seconds.
+      //! @return true if the message must be discarded, false if it
+      //! must be passed through unchanged.
+      bool
+      filter(const IMC::Message* msg, double now);
+
+      //! Retrieve the next aggregated message. Aggregation windows
+      //! that ended before the given time are completed.
+      //! @param[in] now current time, in seconds, on the same clock
+      //! given to filter().
+      //! @return aggregated message (caller takes ownership) or NULL
+      //! if none is available.
+      IMC::Message*
+      pop(double now);
+
+      //! Discard all stream state and pending aggregated messages.
+      void
+      clear(void);
+
+    private:
+      //! Decimation rule.
+      struct Rule
+      {
+        //! Mode.
+        Mode mode;
+        //! Period in seconds.
+        double period;
+        //! Change threshold.
+        double threshold;
+      };
+
+      //! Stream state.
+      struct Stream
+      {
+        //! Rule.
+        const Rule* rule;
+        //! Time of last passed message or window start.
+        double time;
+        //! Last passed value.
+        double value;
+        //! Number of samples in window.
+        unsigned count;
+        //! Window accumulator.
+        double accum;
+        //! Last message in window.
+        IMC::Message* last;
+      };
+
+      //! Rules by message and entity.
+      std::map<uint32_t, Rule> m_rules;
+      //! Stream state.
+      std::map<uint64_t, Stream> m_streams;
+      //! Completed aggregates.
+      std::deque<IMC::Message*> m_ready;
+
+      //! Find rule for a given message.
+      //! @param[in] msg message.
+      //! @return rule or NULL.
+      const Rule*
+      findRule(const IMC::Message* msg) const;
+
+      //! Complete the aggregation window of a stream.
+      //! @param[in] stream stream.
+      void
+      complete(Stream& stream);
+    };
+  }
+}
+
+#endif
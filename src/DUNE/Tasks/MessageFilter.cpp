@@ -40,7 +40,8 @@ namespace DUNE
 {
   namespace Tasks
   {
-    MessageFilter::MessageFilter(void)
+    MessageFilter::MessageFilter(void):
+      m_scale(1.0)
     { }
 
     MessageFilter::~MessageFilter(void)
@@ -81,7 +82,11 @@ namespace DUNE
         double now = Time::Clock::get();
         double& stime = m_stimes[MsgKey(mid, msg->getSourceEntity())];
 
-        if (stime + rmitr->second > now)
+        double period = rmitr->second;
+        if (m_scale < 1.0 && m_critical.find(mid) == m_critical.end())
+          period /= m_scale;
+
+        if (stime + period > now)
           return true;
 
         stime = now;
@@ -117,6 +122,17 @@ namespace DUNE
       }
     }
 
+    //! Setup messages whose rates are not affected by the rate scale.
+    //! @param[in] spec list of message abbreviations.
+    void
+    MessageFilter::setupCritical(const std::vector<std::string>& spec)
+    {
+      m_critical.clear();
+
+      for (unsigned int i = 0; i < spec.size(); ++i)
+        m_critical.insert(IMC::Factory::getIdFromAbbrev(spec[i]));
+    }
+
     //! Setup entities filter.
     //! @param[in] spec String specification.
     //! @param[in] task Pointer to Task object.
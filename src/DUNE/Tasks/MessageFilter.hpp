@@ -33,6 +33,7 @@
 // ISO C++ 98 headers.
 #include <vector>
 #include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/Tasks/Task.hpp>
@@ -55,6 +56,24 @@ namespace DUNE
       void
       setupEntities(const std::vector<std::string>& spec, Tasks::Task* task);
 
+      void
+      setupCritical(const std::vector<std::string>& spec);
+
+      //! Scale the configured rates of non critical messages.
+      //! @param[in] scale scale factor, in ]0, 1].
+      void
+      setRateScale(double scale)
+      {
+        m_scale = scale;
+      }
+
+      //! Retrieve the scale applied to the configured rates.
+      double
+      getRateScale(void) const
+      {
+        return m_scale;
+      }
+
       bool
       filter(const IMC::Message* msg);
 
@@ -62,6 +81,10 @@ namespace DUNE
       // Rate limiters.
       typedef std::map<uint32_t, double> RateMap;
       RateMap m_rates;
+      // Scale applied to rates of non critical messages.
+      double m_scale;
+      // Messages whose rates are never scaled.
+      std::set<uint32_t> m_critical;
 
       // Send times.
       typedef std::pair<uint32_t, unsigned int> MsgKey;
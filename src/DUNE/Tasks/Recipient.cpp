@@ -31,6 +31,7 @@
 #include <cstddef>
 
 // DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/Tasks/Context.hpp>
@@ -42,7 +43,8 @@ namespace DUNE
   {
     Recipient::Recipient(AbstractTask* task, Context& ctx):
       m_task(task),
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_event(NULL)
     { }
 
     Recipient::~Recipient(void)
@@ -55,6 +57,8 @@ namespace DUNE
         if (msg)
           delete msg;
       }
+
+      delete m_event;
     }
 
     void
@@ -90,15 +94,42 @@ namespace DUNE
         runCallBacks();
     }
 
+    IO::NativeHandle
+    Recipient::getHandle(void)
+    {
+      Concurrency::ScopedMutex l(m_event_lock);
+
+      if (m_event == NULL)
+      {
+        m_event = new IO::EventHandle;
+        if (!m_mqueue.empty())
+          m_event->signal();
+      }
+
+      return m_event->getNative();
+    }
+
     void
     Recipient::put(const IMC::Message* msg)
     {
       m_mqueue.push(msg->clone());
+
+      Concurrency::ScopedMutex l(m_event_lock);
+      if (m_event != NULL)
+        m_event->signal();
     }
 
     void
     Recipient::runCallBacks(void)
     {
+      // Clear before draining the queue, so that messages queued
+      // meanwhile signal the event again.
+      {
+        Concurrency::ScopedMutex l(m_event_lock);
+        if (m_event != NULL)
+          m_event->clear();
+      }
+
       unsigned int size = m_mqueue.size();
 
       for (unsigned int i = 0; i < size; ++i)
@@ -35,7 +35,9 @@
 #include <vector>
 
 // DUNE headers.
+#include <DUNE/Concurrency/Mutex.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/IO/EventHandle.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
 
@@ -64,12 +66,26 @@ namespace DUNE
       void
       put(const IMC::Message*);
 
+      //! Retrieve the number of queued messages.
+      //! @return number of queued messages.
+      unsigned
+      size(void)
+      {
+        return m_mqueue.size();
+      }
+
       void
       bind(uint32_t id, AbstractConsumer* c);
 
       void
       waitForMessages(double timeout);
 
+      //! Retrieve a native I/O handle that becomes readable when
+      //! messages are queued. The handle is created on first use.
+      //! @return native I/O handle.
+      IO::NativeHandle
+      getHandle(void);
+
       void
       runCallBacks(void);
 
@@ -82,6 +98,10 @@ namespace DUNE
       std::map<uint32_t, std::vector<AbstractConsumer*> > m_cbacks;
       //! Message queue.
       Concurrency::TSQueue<IMC::Message*> m_mqueue;
+      //! Event signaled when messages are queued.
+      IO::EventHandle* m_event;
+      //! Lock protecting m_event.
+      Concurrency::Mutex m_event_lock;
     };
   }
 }
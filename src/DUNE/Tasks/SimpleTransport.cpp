@@ -89,13 +89,27 @@ namespace DUNE
       m_rl.setupRates(m_gargs.rlim);
       m_rl.setupEntities(m_gargs.entities_flt, this);
       bind(this, m_gargs.transports);
+      m_wait.add(getMessageHandle());
 
+      // Implementations wake up as soon as messages are queued, so
+      // the reception timeout only bounds the reaction to stopping().
       while (!stopping())
       {
         consumeMessages();
 
-        onDataReception(m_buf.getBuffer(), m_buf.getCapacity(), 0.005);
+        onDataReception(m_buf.getBuffer(), m_buf.getCapacity(), 1.0);
       }
+
+      m_wait.remove(getMessageHandle());
+    }
+
+    bool
+    SimpleTransport::waitForData(const IO::Handle& handle, double timeout)
+    {
+      if (!m_wait.poll(timeout))
+        return false;
+
+      return m_wait.wasTriggered(handle);
     }
 
     void
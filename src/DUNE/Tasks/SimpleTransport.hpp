@@ -36,6 +36,8 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Utils/ByteBuffer.hpp>
+#include <DUNE/IO/Handle.hpp>
+#include <DUNE/IO/Poll.hpp>
 #include <DUNE/IMC/Parser.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/MessageFilter.hpp>
@@ -70,6 +72,35 @@ namespace DUNE
       void
       handleData(IMC::Parser& parser, const uint8_t* p, unsigned int n);
 
+    protected:
+      //! Register a handle to be watched by waitForData(). Must be
+      //! called when the handle is opened.
+      //! @param[in] handle I/O handle.
+      void
+      addDataHandle(const IO::Handle& handle)
+      {
+        m_wait.add(handle);
+      }
+
+      //! Stop watching a handle. Must be called before the handle is
+      //! closed.
+      //! @param[in] handle I/O handle.
+      void
+      removeDataHandle(const IO::Handle& handle)
+      {
+        m_wait.remove(handle);
+      }
+
+      //! Wait until the given handle has data to be read or until
+      //! messages are queued for this task, whichever comes first.
+      //! The handle must have been registered with addDataHandle().
+      //! @param[in] handle I/O handle.
+      //! @param[in] timeout amount of time to wait in seconds.
+      //! @return true if the handle has data to be read, false
+      //! otherwise.
+      bool
+      waitForData(const IO::Handle& handle, double timeout);
+
     private:
       struct GArguments
       {
@@ -87,6 +118,8 @@ namespace DUNE
       GArguments m_gargs;
       Utils::ByteBuffer m_buf;
       MessageFilter m_rl;
+      //! Poll set used to wait for data and messages.
+      IO::Poll m_wait;
     };
   }
 }
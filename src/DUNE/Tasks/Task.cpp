@@ -38,6 +38,7 @@
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/PeriodicDelay.hpp>
 #include <DUNE/Time/Counter.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 #include <DUNE/Status/Messages.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
@@ -354,6 +355,9 @@ namespace DUNE
       prctl(PR_SET_NAME, getName(), 0, 0, 0);
 #endif
 
+      // Virtual time advances only when all tasks are waiting.
+      Time::VirtualClock::Participant participant;
+
       try
       {
         setPriority(m_args.priority);
@@ -336,6 +336,14 @@ namespace DUNE
         m_recipient->put(msg);
       }
 
+      //! Retrieve the number of messages queued for consumption.
+      //! @return number of queued messages.
+      unsigned
+      getQueueSize(void)
+      {
+        return m_recipient->size();
+      }
+
       //! Instruct task to reserve all entity identifiers that it
       //! needs for normal execution.
       void
@@ -504,6 +512,17 @@ namespace DUNE
         m_recipient->runCallBacks();
       }
 
+      //! Retrieve a native I/O handle that becomes readable when
+      //! messages are queued for this task, and is cleared by
+      //! consumeMessages(). Tasks waiting on I/O handles can poll it
+      //! together with them to react immediately to new messages.
+      //! @return native I/O handle.
+      IO::NativeHandle
+      getMessageHandle(void)
+      {
+        return m_recipient->getHandle();
+      }
+
       //! Declare a configuration parameter that can be parsed using
       //! the basic parameter parser.
       //! @tparam T type of the destination variable.
@@ -36,6 +36,7 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 #include <DUNE/System/Error.hpp>
 
 // Platform headers.
@@ -62,6 +63,9 @@ namespace DUNE
     uint64_t
     Clock::getNsec(void)
     {
+      if (VirtualClock::isEnabled())
+        return VirtualClock::getNsec();
+
       uint64_t time = getNsecRT();
       if (Clock::s_time_multiplier != 1.0) {
         double ellapsed_time = (time - s_starttime_mono);
@@ -97,6 +101,9 @@ namespace DUNE
     uint64_t
     Clock::getSinceEpochNsec(void)
     {
+      if (VirtualClock::isEnabled())
+        return s_starttime_epoch + (VirtualClock::getNsec() - s_starttime_mono);
+
       uint64_t time = getSinceEpochNsecRT();
       if (Clock::s_time_multiplier != 1.0) {
         double ellapsed_time = (time - s_starttime_epoch);
@@ -108,6 +115,13 @@ namespace DUNE
     void
     Clock::set(double value)
     {
+      if (VirtualClock::isEnabled())
+      {
+        s_starttime_epoch = value * c_nsec_per_sec;
+        s_starttime_mono = VirtualClock::getNsec();
+        return;
+      }
+
       if (Clock::s_time_multiplier != 1.0) {
         s_starttime_epoch = value * c_nsec_per_sec;
         setTimeMultiplier(Clock::s_time_multiplier);
@@ -128,6 +142,10 @@ namespace DUNE
     void
     Clock::setTimeMultiplier(double mul)
     {
+      // Virtual time runs as fast as possible.
+      if (VirtualClock::isEnabled())
+        return;
+
       Clock::s_time_multiplier = 1.0;
       s_starttime_epoch = getSinceEpochNsecRT();
       s_starttime_mono = getNsecRT();
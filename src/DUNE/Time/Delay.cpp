@@ -32,6 +32,7 @@
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 
 // Platform headers.
 #if defined(DUNE_SYS_HAS_TIME_H)
@@ -49,6 +50,11 @@ namespace DUNE
     void
     Delay::waitNsec(uint64_t nsec)
     {
+      if (VirtualClock::isEnabled())
+      {
+        VirtualClock::sleep(nsec);
+        return;
+      }
 
       // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_CREATE_WAITABLE_TIMER)
@@ -41,6 +41,7 @@
 // DUNE headers.
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
 
 namespace DUNE
 {
@@ -80,6 +81,12 @@ namespace DUNE
       void
       reset(void)
       {
+        if (VirtualClock::isEnabled())
+        {
+          m_deadline = VirtualClock::getNsec() + m_delay;
+          return;
+        }
+
         // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_GET_SYSTEM_TIME_AS_FILE_TIME)
         FILETIME ft;
@@ -105,6 +112,13 @@ namespace DUNE
       void
       wait(void)
       {
+        if (VirtualClock::isEnabled())
+        {
+          VirtualClock::sleepUntil(m_deadline);
+          m_deadline += m_delay;
+          return;
+        }
+
         // Microsoft Windows.
 #if defined(DUNE_SYS_HAS_CREATE_WAITABLE_TIMER)
         HANDLE th = CreateWaitableTimer(0, TRUE, 0);
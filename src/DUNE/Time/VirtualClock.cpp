@@ -0,0 +1,353 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <list>
+#include <cerrno>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Time/Constants.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/VirtualClock.hpp>
+#include <DUNE/Concurrency/RawTLS.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+
+// Platform headers.
+#if defined(DUNE_SYS_HAS_PTHREAD_H)
+#  include <pthread.h>
+#endif
+
+namespace DUNE
+{
+  namespace Time
+  {
+    //! Deadline of waits without timeout.
+    static const uint64_t c_forever = static_cast<uint64_t>(-1);
+
+    //! Pending wait.
+    struct Waiter
+    {
+      //! Condition being waited on, if any.
+      const void* cond;
+      //! Virtual deadline.
+      uint64_t deadline;
+      //! True if the waiting thread is a participant.
+      bool participant;
+      //! True when released.
+      bool done;
+      //! True if released by a notification.
+      bool notified;
+    };
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+    //! Lock protecting the clock state.
+    static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+    //! Condition used to release waiters.
+    static pthread_cond_t s_cond;
+    //! True if s_cond uses the monotonic clock.
+    static bool s_cond_monotonic = false;
+#endif
+    //! Current virtual time.
+    static uint64_t s_now = 0;
+    //! Number of participants that are not waiting.
+    static unsigned s_running = 0;
+    //! Pending waits, in registration order.
+    static std::list<Waiter*> s_waiters;
+
+    bool VirtualClock::s_enabled = false;
+
+    //! Participant mark of the calling thread.
+    static Concurrency::RawTLS&
+    participant(void)
+    {
+      static Concurrency::RawTLS tls;
+      return tls;
+    }
+
+    //! Release a pending wait. Must be called with s_mutex locked.
+    static std::list<Waiter*>::iterator
+    release(std::list<Waiter*>::iterator itr, bool notified)
+    {
+      Waiter* w = *itr;
+      w->done = true;
+      w->notified = notified;
+      // Count the thread as running right away, so that time does
+      // not move before it gets the chance to wake up.
+      if (w->participant)
+        ++s_running;
+      return s_waiters.erase(itr);
+    }
+
+    //! Advance virtual time while all participants are waiting. Must
+    //! be called with s_mutex locked.
+    static void
+    advance(void)
+    {
+      bool released = false;
+
+      while (s_running == 0 && !s_waiters.empty())
+      {
+        uint64_t next = c_forever;
+        std::list<Waiter*>::iterator itr = s_waiters.begin();
+        for (; itr != s_waiters.end(); ++itr)
+        {
+          if ((*itr)->deadline < next)
+            next = (*itr)->deadline;
+        }
+
+        if (next == c_forever)
+          break;
+
+        if (next > s_now)
+          s_now = next;
+
+        itr = s_waiters.begin();
+        while (itr != s_waiters.end())
+        {
+          if ((*itr)->deadline <= s_now)
+            itr = release(itr, false);
+          else
+            ++itr;
+        }
+
+        released = true;
+      }
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      if (released)
+        pthread_cond_broadcast(&s_cond);
+#endif
+    }
+
+    //! Block until a registered wait is released. Waits of
+    //! participants end only by virtual time or notification, other
+    //! waits also end after the equivalent amount of real time. Must
+    //! be called with s_mutex locked.
+    static void
+    block(Waiter& w)
+    {
+      advance();
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      if (w.participant || w.deadline == c_forever)
+      {
+        while (!w.done)
+          pthread_cond_wait(&s_cond, &s_mutex);
+        return;
+      }
+
+      uint64_t rt = (s_cond_monotonic ? Clock::getNsecRT() : Clock::getSinceEpochNsecRT())
+      + (w.deadline - s_now);
+      timespec ts = {(time_t)(rt / c_nsec_per_sec), (long)(rt % c_nsec_per_sec)};
+
+      while (!w.done)
+      {
+        if (pthread_cond_timedwait(&s_cond, &s_mutex, &ts) == ETIMEDOUT)
+          break;
+      }
+
+      if (!w.done)
+        s_waiters.remove(&w);
+#endif
+    }
+
+    VirtualClock::Participant::Participant(void):
+      m_attached(false)
+    {
+      if (!s_enabled || participant().get() != NULL)
+        return;
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+      ++s_running;
+      pthread_mutex_unlock(&s_mutex);
+#endif
+
+      participant().set(this);
+      m_attached = true;
+    }
+
+    VirtualClock::Participant::~Participant(void)
+    {
+      if (!m_attached)
+        return;
+
+      participant().set(NULL);
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+      --s_running;
+      advance();
+      pthread_mutex_unlock(&s_mutex);
+#endif
+    }
+
+    VirtualClock::Idle::Idle(bool idle):
+      m_idle(idle && s_enabled && participant().get() != NULL)
+    {
+      if (!m_idle)
+        return;
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+      --s_running;
+      advance();
+      pthread_mutex_unlock(&s_mutex);
+#endif
+    }
+
+    VirtualClock::Idle::~Idle(void)
+    {
+      if (!m_idle)
+        return;
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+      ++s_running;
+      pthread_mutex_unlock(&s_mutex);
+#endif
+    }
+
+    void
+    VirtualClock::enable(void)
+    {
+      if (s_enabled)
+        return;
+
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_condattr_t attr;
+      pthread_condattr_init(&attr);
+#  if defined(DUNE_SYS_HAS_PTHREAD_CONDATTR_SETCLOCK) && defined(CLOCK_MONOTONIC)
+      s_cond_monotonic = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0;
+#  endif
+      pthread_cond_init(&s_cond, &attr);
+      pthread_condattr_destroy(&attr);
+#endif
+
+      // Virtual time starts at the current time, at normal speed.
+      Clock::setTimeMultiplier(1.0);
+      s_now = Clock::getNsecRT();
+      s_enabled = true;
+    }
+
+    uint64_t
+    VirtualClock::getNsec(void)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+      uint64_t now = s_now;
+      pthread_mutex_unlock(&s_mutex);
+      return now;
+#else
+      return s_now;
+#endif
+    }
+
+    void
+    VirtualClock::sleepUntil(uint64_t deadline)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+
+      if (deadline > s_now)
+      {
+        Waiter w = {NULL, deadline, participant().get() != NULL, false, false};
+        if (w.participant)
+          --s_running;
+        s_waiters.push_back(&w);
+        block(w);
+      }
+
+      pthread_mutex_unlock(&s_mutex);
+#else
+      (void)deadline;
+#endif
+    }
+
+    bool
+    VirtualClock::wait(Concurrency::Condition& cond, double timeout)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+
+      Waiter w = {&cond, c_forever, participant().get() != NULL, false, false};
+      if (timeout > 0)
+        w.deadline = s_now + static_cast<uint64_t>(timeout * c_nsec_per_sec_fp);
+      if (w.participant)
+        --s_running;
+      s_waiters.push_back(&w);
+
+      // Notifications are registered with s_mutex, so none is lost
+      // between releasing the condition and blocking.
+      cond.unlock();
+      block(w);
+      pthread_mutex_unlock(&s_mutex);
+      cond.lock();
+
+      return w.notified;
+#else
+      (void)cond;
+      (void)timeout;
+      return false;
+#endif
+    }
+
+    void
+    VirtualClock::notify(const void* cond, bool all)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      pthread_mutex_lock(&s_mutex);
+
+      bool released = false;
+      std::list<Waiter*>::iterator itr = s_waiters.begin();
+      while (itr != s_waiters.end())
+      {
+        if ((*itr)->cond != cond)
+        {
+          ++itr;
+          continue;
+        }
+
+        itr = release(itr, true);
+        released = true;
+
+        if (!all)
+          break;
+      }
+
+      if (released)
+        pthread_cond_broadcast(&s_cond);
+
+      pthread_mutex_unlock(&s_mutex);
+#else
+      (void)cond;
+      (void)all;
+#endif
+    }
+  }
+}
@@ -0,0 +1,147 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef DUNE_TIME_VIRTUAL_CLOCK_HPP_INCLUDED_
+#define DUNE_TIME_VIRTUAL_CLOCK_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    class Condition;
+  }
+
+  namespace Time
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM VirtualClock;
+
+    //! Discrete-event clock for simulation.
+    //!
+    //! When enabled, the monotonic and epoch clocks stop following
+    //! the system clock. Timed waits (Delay, PeriodicDelay and
+    //! Concurrency::Condition) are registered with this clock and,
+    //! as soon as every participant thread is waiting, time jumps to
+    //! the earliest pending deadline and the corresponding waiters
+    //! are released. Idle periods therefore take no real time and
+    //! the instants at which periodic work runs do not depend on
+    //! machine load.
+    //!
+    //! Participants are the threads that drive the simulation (task
+    //! threads). Waits of other threads are released either by
+    //! virtual time or when the equivalent real time elapses, so
+    //! they never hold virtual time back nor block forever.
+    class VirtualClock
+    {
+    public:
+      //! Guard that registers the calling thread as a participant
+      //! for its lifetime. Does nothing if virtual time is disabled.
+      class Participant
+      {
+      public:
+        Participant(void);
+
+        ~Participant(void);
+
+      private:
+        bool m_attached;
+      };
+
+      //! Guard that marks a participant as idle for its lifetime,
+      //! without a deadline. Used around waits that virtual time
+      //! cannot end, such as I/O polling. Does nothing for other
+      //! threads or if virtual time is disabled.
+      class Idle
+      {
+      public:
+        //! Constructor.
+        //! @param[in] idle false to leave the thread running.
+        Idle(bool idle = true);
+
+        ~Idle(void);
+
+      private:
+        bool m_idle;
+      };
+
+      //! Enable virtual time, starting at the current time. Must be
+      //! called before any thread starts using the clock.
+      static void
+      enable(void);
+
+      //! Check if virtual time is enabled.
+      //! @return true if enabled, false otherwise.
+      static bool
+      isEnabled(void)
+      {
+        return s_enabled;
+      }
+
+      //! Get virtual monotonic time.
+      //! @return time in nanoseconds.
+      static uint64_t
+      getNsec(void);
+
+      //! Suspend the calling thread until a given virtual time.
+      //! @param[in] deadline virtual monotonic time in nanoseconds.
+      static void
+      sleepUntil(uint64_t deadline);
+
+      //! Suspend the calling thread for a given amount of virtual time.
+      //! @param[in] nsec amount of nanoseconds to suspend.
+      static void
+      sleep(uint64_t nsec)
+      {
+        sleepUntil(getNsec() + nsec);
+      }
+
+      //! Wait for a condition to be notified. Must be called with the
+      //! condition's mutex locked, which is released while waiting.
+      //! @param[in] cond condition.
+      //! @param[in] timeout timeout in seconds, zero or negative to
+      //! wait forever.
+      //! @return true if the condition was notified, false on timeout.
+      static bool
+      wait(Concurrency::Condition& cond, double timeout);
+
+      //! Release threads waiting on a condition.
+      //! @param[in] cond condition.
+      //! @param[in] all true to release all waiters, false to release one.
+      static void
+      notify(const void* cond, bool all);
+
+    private:
+      //! True if virtual time is enabled.
+      static bool s_enabled;
+    };
+  }
+}
+
+#endif
@@ -238,7 +238,9 @@ main(int argc, char** argv)
   .add("-V", "--vehicle",
        "Vehicle name override", "VEHICLE")
   .add("-X", "--dump-params-xml",
-       "Dump parameters XML to folder DIR", "DIR");
+       "Dump parameters XML to folder DIR", "DIR")
+  .add("-t", "--virtual-time",
+       "Run on virtual time, as fast as possible");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -259,6 +261,10 @@ main(int argc, char** argv)
 #endif
   }
 
+  // If requested, run on virtual time.
+  if (!options.value("--virtual-time").empty())
+    Time::VirtualClock::enable();
+
   // If requested, set alternate configuration directory.
   if (options.value("--config-dir") != "")
   {
@@ -365,9 +365,11 @@ namespace Maneuver
         double coords[]= {e, n};
         polygon = Math::Matrix(coords, 2, 1);
 
+        LocalTangentPlane ltp(m_lat, m_lon);
+
         for (; it != maneuver->polygon.end(); it++ )
         {
-          WGS84::displacement(m_lat, m_lon, 0, (*it)->lat, (*it)->lon, 0, &n, &e);
+          ltp.toNED((*it)->lat, (*it)->lon, 0.0, &n, &e);
           coords[0] = e;
           coords[1] = n;
           new_vtx = Math::Matrix(coords, 2, 1);
@@ -0,0 +1,471 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+
+#if defined(DUNE_SYS_HAS_MMAP)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+// Local headers.
+#include "Bathymetry.hpp"
+
+namespace Simulators
+{
+  namespace Environment
+  {
+    //! File signature.
+    static const char c_magic[8] = {'D', 'U', 'N', 'E', 'B', 'T', 'H', 'Y'};
+    //! File format version.
+    static const uint32_t c_version = 1;
+    //! Byte order marker.
+    static const uint32_t c_byte_order = 0x01020304;
+    //! Number of ray samples evaluated at once.
+    static const size_t c_ray_batch = 32;
+    //! Number of bisection steps when refining a ray hit.
+    static const unsigned c_ray_refine = 10;
+
+    //! On-disk header, followed by rows * cols single precision depths.
+    struct FileHeader
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t byte_order;
+      uint32_t rows;
+      uint32_t cols;
+      double lat;
+      double lon;
+      double resolution;
+      double radius;
+      double n0;
+      double e0;
+      double n1;
+      double e1;
+    };
+
+    //! Inverse distance weighting of the soundings around a point.
+    struct InverseDistance: public QuadTree::Iteration
+    {
+      Point center;
+      double sum;
+      double wsum;
+      bool exact;
+
+      InverseDistance(const Point& p):
+        center(p),
+        sum(0),
+        wsum(0),
+        exact(false)
+      { }
+
+      void
+      process(const QuadTree::Item& item)
+      {
+        if (exact)
+          return;
+
+        double d = center.distance(Point(item.x, item.y));
+
+        if (d < 1e-6)
+        {
+          sum = item.value;
+          wsum = 1.0;
+          exact = true;
+          return;
+        }
+
+        double w = 1.0 / (d * d);
+        sum += w * item.value;
+        wsum += w;
+      }
+    };
+
+    const float Bathymetry::s_nan = std::numeric_limits<float>::quiet_NaN();
+
+    Bathymetry::Bathymetry(const std::vector<QuadTree::Item>& items,
+                           double lat, double lon,
+                           double resolution, double radius):
+      m_lat(lat),
+      m_lon(lon),
+      m_resolution(resolution),
+      m_radius(radius),
+      m_grid(NULL),
+      m_data(NULL),
+      m_map(NULL),
+      m_map_size(0)
+    {
+      if (items.empty())
+        throw std::runtime_error("Bathymetry: no data");
+
+      if (resolution <= 0)
+        throw std::runtime_error("Bathymetry: invalid resolution");
+
+      Bounds bounds(Point(items[0].x, items[0].y));
+      for (size_t i = 1; i < items.size(); ++i)
+        bounds.cover(Point(items[i].x, items[i].y));
+
+      QuadTree tree(bounds, items);
+
+      size_t rows = (size_t)std::floor((bounds.max_x - bounds.min_x) / resolution) + 2;
+      size_t cols = (size_t)std::floor((bounds.max_y - bounds.min_y) / resolution) + 2;
+
+      setGrid(bounds.min_x, bounds.min_y,
+              bounds.min_x + (rows - 1) * resolution,
+              bounds.min_y + (cols - 1) * resolution,
+              rows, cols);
+
+      m_storage.resize(rows * cols, s_nan);
+      m_data = &m_storage[0];
+
+      for (size_t i = 0; i < rows; ++i)
+      {
+        for (size_t j = 0; j < cols; ++j)
+        {
+          InverseDistance idw(Point(m_n0 + i * resolution, m_e0 + j * resolution));
+          tree.iterate(idw, idw.center, radius);
+
+          if (idw.wsum > 0)
+            m_storage[i * cols + j] = (float)(idw.sum / idw.wsum);
+        }
+      }
+    }
+
+    Bathymetry::Bathymetry(const std::string& path):
+      m_grid(NULL),
+      m_data(NULL),
+      m_map(NULL),
+      m_map_size(0)
+    {
+      FileHeader hdr;
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+
+      if (!ifs.read((char*)&hdr, sizeof(hdr)))
+        throw std::runtime_error("Bathymetry: failed to read " + path);
+
+      if (std::memcmp(hdr.magic, c_magic, sizeof(c_magic)) != 0
+          || hdr.version != c_version
+          || hdr.byte_order != c_byte_order
+          || hdr.rows < 2 || hdr.cols < 2)
+        throw std::runtime_error("Bathymetry: invalid file " + path);
+
+      m_lat = hdr.lat;
+      m_lon = hdr.lon;
+      m_resolution = hdr.resolution;
+      m_radius = hdr.radius;
+
+      size_t count = (size_t)hdr.rows * hdr.cols;
+      size_t size = sizeof(hdr) + count * sizeof(float);
+
+#if defined(DUNE_SYS_HAS_MMAP)
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd >= 0)
+      {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= size)
+        {
+          void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (map != MAP_FAILED)
+          {
+            m_map = map;
+            m_map_size = size;
+            m_data = (const float*)((const char*)map + sizeof(hdr));
+          }
+        }
+
+        ::close(fd);
+      }
+#endif
+
+      if (m_data == NULL)
+      {
+        m_storage.resize(count);
+        if (!ifs.read((char*)&m_storage[0], count * sizeof(float)))
+          throw std::runtime_error("Bathymetry: truncated file " + path);
+        m_data = &m_storage[0];
+      }
+
+      setGrid(hdr.n0, hdr.e0, hdr.n1, hdr.e1, hdr.rows, hdr.cols);
+    }
+
+    Bathymetry::~Bathymetry(void)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (m_map != NULL)
+        munmap(m_map, m_map_size);
+#endif
+
+      delete m_grid;
+    }
+
+    void
+    Bathymetry::setGrid(double n0, double e0, double n1, double e1, size_t rows, size_t cols)
+    {
+      std::vector<double> min(2), max(2);
+      std::vector<size_t> dims(2);
+      min[0] = n0;
+      min[1] = e0;
+      max[0] = n1;
+      max[1] = e1;
+      dims[0] = rows;
+      dims[1] = cols;
+
+      m_grid = new DUNE::Math::Grid<2>(min, max, dims);
+      m_n0 = n0;
+      m_e0 = e0;
+      m_rows = rows;
+      m_cols = cols;
+    }
+
+    Bathymetry*
+    Bathymetry::loadCache(const std::string& path, const std::string& source,
+                          double resolution, double radius)
+    {
+      DUNE::FileSystem::Path cache(path);
+      DUNE::FileSystem::Path src(source);
+
+      if (!cache.isFile())
+        return NULL;
+
+      if (src.isFile() && cache.getLastModifiedTime() < src.getLastModifiedTime())
+        return NULL;
+
+      Bathymetry* bathy = new Bathymetry(path);
+      if (bathy->getResolution() != resolution || bathy->getRadius() != radius)
+      {
+        delete bathy;
+        return NULL;
+      }
+
+      return bathy;
+    }
+
+    void
+    Bathymetry::save(const std::string& path) const
+    {
+      FileHeader hdr;
+      std::memset(&hdr, 0, sizeof(hdr));
+      std::memcpy(hdr.magic, c_magic, sizeof(c_magic));
+      hdr.version = c_version;
+      hdr.byte_order = c_byte_order;
+      hdr.rows = (uint32_t)m_rows;
+      hdr.cols = (uint32_t)m_cols;
+      hdr.lat = m_lat;
+      hdr.lon = m_lon;
+      hdr.resolution = m_resolution;
+      hdr.radius = m_radius;
+      hdr.n0 = m_grid->getLower(0);
+      hdr.e0 = m_grid->getLower(1);
+      hdr.n1 = m_grid->getUpper(0);
+      hdr.e1 = m_grid->getUpper(1);
+
+      std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+      ofs.write((const char*)&hdr, sizeof(hdr));
+      ofs.write((const char*)m_data, m_rows * m_cols * sizeof(float));
+
+      if (!ofs)
+        throw std::runtime_error("Bathymetry: failed to write " + path);
+    }
+
+    double
+    Bathymetry::nearest(double n, double e) const
+    {
+      long i = (long)std::floor((n - m_n0) / m_resolution + 0.5);
+      long j = (long)std::floor((e - m_e0) / m_resolution + 0.5);
+      return at(i, j);
+    }
+
+    double
+    Bathymetry::bilinear(double n, double e) const
+    {
+      double fi = (n - m_n0) / m_resolution;
+      double fj = (e - m_e0) / m_resolution;
+
+      if (!(fi >= 0 && fj >= 0 && fi <= m_rows - 1 && fj <= m_cols - 1))
+        return s_nan;
+
+      size_t i = std::min((size_t)fi, m_rows - 2);
+      size_t j = std::min((size_t)fj, m_cols - 2);
+      double t = fi - i;
+      double u = fj - j;
+
+      const float* p = m_data + i * m_cols + j;
+      double v[4] = {p[0], p[1], p[m_cols], p[m_cols + 1]};
+      double w[4] = {(1 - t) * (1 - u), (1 - t) * u, t * (1 - u), t * u};
+
+      double sum = 0;
+      double wsum = 0;
+      for (unsigned k = 0; k < 4; ++k)
+      {
+        // Missing corners are left out and the remaining weights renormalized.
+        if (v[k] == v[k])
+        {
+          sum += w[k] * v[k];
+          wsum += w[k];
+        }
+      }
+
+      if (wsum <= 0)
+        return s_nan;
+
+      return sum / wsum;
+    }
+
+    //! Catmull-Rom interpolation between p1 and p2.
+    static inline double
+    cubic(double p0, double p1, double p2, double p3, double t)
+    {
+      return p1 + 0.5 * t * (p2 - p0 + t * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3
+                                           + t * (3.0 * (p1 - p2) + p3 - p0)));
+    }
+
+    double
+    Bathymetry::bicubic(double n, double e) const
+    {
+      double fi = (n - m_n0) / m_resolution;
+      double fj = (e - m_e0) / m_resolution;
+
+      if (!(fi >= 1 && fj >= 1 && fi < m_rows - 2 && fj < m_cols - 2))
+        return bilinear(n, e);
+
+      size_t i = (size_t)fi;
+      size_t j = (size_t)fj;
+      double t = fi - i;
+      double u = fj - j;
+
+      double col[4];
+      for (unsigned k = 0; k < 4; ++k)
+      {
+        const float* p = m_data + (i - 1 + k) * m_cols + j - 1;
+        col[k] = cubic(p[0], p[1], p[2], p[3], u);
+      }
+
+      double value = cubic(col[0], col[1], col[2], col[3], t);
+
+      // Holes in the neighbourhood propagate as NaN.
+      if (value != value)
+        return bilinear(n, e);
+
+      return value;
+    }
+
+    double
+    Bathymetry::depth(double n, double e, Interpolation method) const
+    {
+      switch (method)
+      {
+        case INTERP_NEAREST:
+          return nearest(n, e);
+        case INTERP_BICUBIC:
+          return bicubic(n, e);
+        default:
+          return bilinear(n, e);
+      }
+    }
+
+    void
+    Bathymetry::depth(const double* n, const double* e, double* d, size_t count) const
+    {
+      for (size_t i = 0; i < count; ++i)
+        d[i] = bilinear(n[i], e[i]);
+    }
+
+    double
+    Bathymetry::intersect(double n, double e, double z, double psi, double theta,
+                          double range, double offset) const
+    {
+      // Unit direction of the ray.
+      double dn = std::cos(theta) * std::cos(psi);
+      double de = std::cos(theta) * std::sin(psi);
+      double dz = -std::sin(theta);
+
+      double step = 0.5 * m_resolution;
+      size_t samples = (size_t)std::ceil(range / step) + 1;
+
+      double s[c_ray_batch];
+      double pn[c_ray_batch];
+      double pe[c_ray_batch];
+      double depths[c_ray_batch];
+
+      double prev = 0;
+
+      for (size_t first = 0; first < samples; first += c_ray_batch)
+      {
+        size_t count = std::min(c_ray_batch, samples - first);
+
+        for (size_t k = 0; k < count; ++k)
+        {
+          s[k] = std::min((first + k) * step, range);
+          pn[k] = n + s[k] * dn;
+          pe[k] = e + s[k] * de;
+        }
+
+        depth(pn, pe, depths, count);
+
+        for (size_t k = 0; k < count; ++k)
+        {
+          // Ray is below the bottom (NaN compares false and never hits).
+          if (z + s[k] * dz >= depths[k] + offset)
+          {
+            if (s[k] == 0)
+              return 0;
+
+            // Refine the crossing between the last two samples.
+            double lo = prev;
+            double hi = s[k];
+            for (unsigned r = 0; r < c_ray_refine; ++r)
+            {
+              double mid = 0.5 * (lo + hi);
+              double b = bilinear(n + mid * dn, e + mid * de);
+              if (z + mid * dz >= b + offset)
+                hi = mid;
+              else
+                lo = mid;
+            }
+
+            return hi;
+          }
+
+          prev = s[k];
+        }
+      }
+
+      return range;
+    }
+  }
+}
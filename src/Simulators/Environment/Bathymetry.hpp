@@ -0,0 +1,235 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef SIMULATORS_ENVIRONMENT_BATHYMETRY_HPP_INCLUDED_
+#define SIMULATORS_ENVIRONMENT_BATHYMETRY_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Grid.hpp>
+
+// Local headers.
+#include "QuadTree.hpp"
+
+namespace Simulators
+{
+  namespace Environment
+  {
+    //! Regularly gridded bathymetry.
+    //!
+    //! Depths are stored as single precision values on a north/east
+    //! grid in row-major order (north index first). Cells without
+    //! data are NaN. The grid can be built from scattered soundings,
+    //! saved to a compact binary file and later loaded back by mapping
+    //! the file into memory, which avoids parsing large surveys at
+    //! every start.
+    class Bathymetry
+    {
+    public:
+      //! Interpolation methods.
+      enum Interpolation
+      {
+        //! Nearest grid point.
+        INTERP_NEAREST,
+        //! Bilinear interpolation of the four surrounding points.
+        INTERP_BILINEAR,
+        //! Bicubic (Catmull-Rom) interpolation of the sixteen
+        //! surrounding points.
+        INTERP_BICUBIC
+      };
+
+      //! Build a grid from scattered soundings.
+      //! Each grid point is the inverse distance weighted mean of the
+      //! soundings within the given radius.
+      //! @param[in] items soundings (north, east, depth).
+      //! @param[in] lat reference latitude (rad).
+      //! @param[in] lon reference longitude (rad).
+      //! @param[in] resolution grid spacing (m).
+      //! @param[in] radius search radius (m).
+      Bathymetry(const std::vector<QuadTree::Item>& items,
+                 double lat, double lon,
+                 double resolution, double radius);
+
+      //! Load a grid from a binary file.
+      //! @param[in] path file path.
+      Bathymetry(const std::string& path);
+
+      ~Bathymetry(void);
+
+      //! Load a grid from a binary cache file if it is up to date, i.e.,
+      //! not older than the source data (when present) and built with
+      //! the given resolution and search radius.
+      //! @param[in] path cache file path.
+      //! @param[in] source source data path.
+      //! @param[in] resolution grid spacing (m).
+      //! @param[in] radius search radius (m).
+      //! @return grid (caller takes ownership) or NULL if the cache is
+      //! missing or out of date.
+      static Bathymetry*
+      loadCache(const std::string& path, const std::string& source,
+                double resolution, double radius);
+
+      //! Save the grid to a binary file.
+      //! @param[in] path file path.
+      void
+      save(const std::string& path) const;
+
+      //! Get the depth at a given position.
+      //! @param[in] n northing offset from reference (m).
+      //! @param[in] e easting offset from reference (m).
+      //! @param[in] method interpolation method.
+      //! @return depth (m) or NaN if there is no data at the position.
+      double
+      depth(double n, double e, Interpolation method = INTERP_BILINEAR) const;
+
+      //! Get the bilinearly interpolated depth at several positions.
+      //! @param[in] n northing offsets from reference (m).
+      //! @param[in] e easting offsets from reference (m).
+      //! @param[out] d depths (m), NaN where there is no data.
+      //! @param[in] count number of positions.
+      void
+      depth(const double* n, const double* e, double* d, size_t count) const;
+
+      //! Cast a ray and find where it hits the bottom.
+      //! @param[in] n northing of the ray origin (m).
+      //! @param[in] e easting of the ray origin (m).
+      //! @param[in] z depth of the ray origin (m).
+      //! @param[in] psi ray heading (rad).
+      //! @param[in] theta ray elevation, positive upwards (rad).
+      //! @param[in] range maximum range (m).
+      //! @param[in] offset value added to all depths (m).
+      //! @return distance to the bottom or range if nothing was hit.
+      double
+      intersect(double n, double e, double z, double psi, double theta,
+                double range, double offset = 0.0) const;
+
+      //! Get the reference latitude.
+      //! @return reference latitude (rad).
+      double
+      getLatitude(void) const
+      {
+        return m_lat;
+      }
+
+      //! Get the reference longitude.
+      //! @return reference longitude (rad).
+      double
+      getLongitude(void) const
+      {
+        return m_lon;
+      }
+
+      //! Get the grid spacing.
+      //! @return grid spacing (m).
+      double
+      getResolution(void) const
+      {
+        return m_resolution;
+      }
+
+      //! Get the search radius used to build the grid.
+      //! @return search radius (m).
+      double
+      getRadius(void) const
+      {
+        return m_radius;
+      }
+
+      //! Get the underlying grid.
+      //! @return grid.
+      const DUNE::Math::Grid<2>&
+      getGrid(void) const
+      {
+        return *m_grid;
+      }
+
+    private:
+      //! Reference latitude.
+      double m_lat;
+      //! Reference longitude.
+      double m_lon;
+      //! Grid spacing.
+      double m_resolution;
+      //! Search radius.
+      double m_radius;
+      //! Grid geometry.
+      DUNE::Math::Grid<2>* m_grid;
+      //! Lower northing.
+      double m_n0;
+      //! Lower easting.
+      double m_e0;
+      //! Number of rows (northing).
+      size_t m_rows;
+      //! Number of columns (easting).
+      size_t m_cols;
+      //! Depths (owned or mapped).
+      const float* m_data;
+      //! Owned depths when not mapped.
+      std::vector<float> m_storage;
+      //! Mapped file address.
+      void* m_map;
+      //! Mapped file size.
+      size_t m_map_size;
+
+      //! Non-copyable.
+      Bathymetry(const Bathymetry&);
+
+      Bathymetry&
+      operator=(const Bathymetry&);
+
+      void
+      setGrid(double n0, double e0, double n1, double e1, size_t rows, size_t cols);
+
+      //! Get a grid value, NaN if out of the grid.
+      inline float
+      at(long i, long j) const
+      {
+        if (i < 0 || j < 0 || (size_t)i >= m_rows || (size_t)j >= m_cols)
+          return s_nan;
+        return m_data[i * m_cols + j];
+      }
+
+      double
+      bilinear(double n, double e) const;
+
+      double
+      bicubic(double n, double e) const;
+
+      double
+      nearest(double n, double e) const;
+
+      //! Quiet NaN.
+      static const float s_nan;
+    };
+  }
+}
+
+#endif
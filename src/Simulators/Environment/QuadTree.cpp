@@ -28,6 +28,8 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <cstring>
 
@@ -41,143 +43,402 @@ namespace Simulators
 {
   namespace Environment
   {
-    // The actual implementation
-    struct Node
+    //! Maximum number of items in a leaf.
+    static const uint32_t c_leaf_size = 8;
+    //! Maximum tree depth (number of bits per axis in Morton codes).
+    static const unsigned c_max_level = 16;
+    //! Traversal stack size: each level adds at most three pending nodes.
+    static const unsigned c_stack_size = 3 * (c_max_level + 1) + 1;
+
+    //! Spread the lower 16 bits of a value to the even bit positions.
+    static inline uint32_t
+    spread(uint32_t v)
     {
-      union
+      v = (v | (v << 8)) & 0x00ff00ff;
+      v = (v | (v << 4)) & 0x0f0f0f0f;
+      v = (v | (v << 2)) & 0x33333333;
+      v = (v | (v << 1)) & 0x55555555;
+      return v;
+    }
+
+    //! Quantize a coordinate to 16 bits.
+    static inline uint32_t
+    quantize(double v, double min, double extent)
+    {
+      if (extent <= 0)
+        return 0;
+
+      double q = (v - min) / extent * 65536.0;
+      return q >= 65535.0 ? 65535 : (q <= 0 ? 0 : (uint32_t)q);
+    }
+
+    //! Squared distance from a point to a node's bounding box.
+    template <typename T>
+    static inline double
+    distance2(const T& node, const Point& p)
+    {
+      double dx = std::max(0.0, std::max(node.min_x - p.x, p.x - node.max_x));
+      double dy = std::max(0.0, std::max(node.min_y - p.y, p.y - node.max_y));
+      return dx * dx + dy * dy;
+    }
+
+    //! Squared distance between an item and a point.
+    static inline double
+    distance2(const QuadTree::Item& item, const Point& p)
+    {
+      double dx = item.x - p.x;
+      double dy = item.y - p.y;
+      return dx * dx + dy * dy;
+    }
+
+    //! Morton code ordering of an item index.
+    struct CodeOrder
+    {
+      const std::vector<uint32_t>& codes;
+
+      CodeOrder(const std::vector<uint32_t>& c):
+        codes(c)
+      { }
+
+      bool
+      operator()(size_t a, size_t b) const
       {
-        QuadTree::Item item;
-        Node* children[4];
-      } m_data;
+        return codes[a] < codes[b];
+      }
+    };
+
+    QuadTree::QuadTree(const Bounds& bounds):
+      m_bounds(bounds), m_indexed(0)
+    { }
+
+    QuadTree::QuadTree(const Bounds& bounds, const std::vector<Item>& items):
+      m_bounds(bounds), m_indexed(0)
+    {
+      load(items);
+    }
+
+    QuadTree::~QuadTree()
+    {
+      clear();
+    }
 
-      bool m_leaf;
+    uint32_t
+    QuadTree::code(double x, double y) const
+    {
+      uint32_t qx = quantize(x, m_bounds.min_x, m_bounds.width());
+      uint32_t qy = quantize(y, m_bounds.min_y, m_bounds.height());
+      return (spread(qx) << 1) | spread(qy);
+    }
+
+    void
+    QuadTree::load(const std::vector<Item>& items)
+    {
+      clear();
+      m_items.reserve(items.size());
+      m_codes.reserve(items.size());
 
-      Node(const QuadTree::Item& item)
+      for (size_t i = 0; i < items.size(); ++i)
       {
-        m_data.item = item;
-        m_leaf = true;
+        if (!m_bounds.contains(items[i]))
+          continue;
+
+        m_items.push_back(items[i]);
+        m_codes.push_back(code(items[i].x, items[i].y));
       }
 
-      ~Node(void)
+      rebuild();
+    }
+
+    void
+    QuadTree::update(void) const
+    {
+      if (m_indexed != m_items.size())
+        rebuild();
+    }
+
+    void
+    QuadTree::rebuild(void) const
+    {
+      m_nodes.clear();
+      m_indexed = m_items.size();
+
+      if (m_items.empty())
+        return;
+
+      bool sorted = true;
+      for (size_t i = 1; i < m_codes.size() && sorted; ++i)
+        sorted = m_codes[i - 1] <= m_codes[i];
+
+      if (!sorted)
       {
-        if (!m_leaf)
+        std::vector<size_t> order(m_items.size());
+        for (size_t i = 0; i < order.size(); ++i)
+          order[i] = i;
+
+        std::stable_sort(order.begin(), order.end(), CodeOrder(m_codes));
+
+        std::vector<Item> items(m_items.size());
+        std::vector<uint32_t> codes(m_codes.size());
+        for (size_t i = 0; i < order.size(); ++i)
         {
-          for (int i = 0; i < 4; ++i)
-          {
-            if (m_data.children[i])
-              delete m_data.children[i];
-          }
+          items[i] = m_items[order[i]];
+          codes[i] = m_codes[order[i]];
         }
+
+        m_items.swap(items);
+        m_codes.swap(codes);
       }
 
-      void
-      insert(const QuadTree::Item& item, Bounds& b)
+      m_nodes.reserve(2 * m_items.size() / c_leaf_size + 1);
+      m_nodes.resize(1);
+      build(0, 0, (uint32_t)m_items.size(), 0);
+    }
+
+    void
+    QuadTree::build(uint32_t index, uint32_t first, uint32_t count, unsigned level) const
+    {
+      Node node;
+      node.min_x = node.max_x = m_items[first].x;
+      node.min_y = node.max_y = m_items[first].y;
+      node.first = first;
+      node.count = count;
+      node.child = 0;
+      node.children = 0;
+
+      for (uint32_t i = first + 1; i < first + count; ++i)
       {
-        if (m_leaf)
-        {
-          m_leaf = false;
-          QuadTree::Item prev_item = m_data.item;
-          std::memset(m_data.children, 0, sizeof(m_data.children));
-          insert(prev_item, b);   // Split
-        }
-        std::pair<int, Bounds> bq = b.quadrant(item);
-        Node** c = m_data.children + bq.first;
-        if (*c)
-          (*c)->insert(item, bq.second);   // Branch
-        else
-          *c = new Node(item);    // New leaf
+        node.min_x = std::min(node.min_x, m_items[i].x);
+        node.max_x = std::max(node.max_x, m_items[i].x);
+        node.min_y = std::min(node.min_y, m_items[i].y);
+        node.max_y = std::max(node.max_y, m_items[i].y);
       }
 
-      bool
-      isLeaf(void) const
+      if (count <= c_leaf_size || level >= c_max_level)
+      {
+        m_nodes[index] = node;
+        return;
+      }
+
+      // Items sharing a quadrant at this level are contiguous.
+      unsigned shift = 30 - 2 * level;
+      uint32_t bounds[5];
+      bounds[0] = first;
+      bounds[4] = first + count;
+
+      for (unsigned q = 1; q < 4; ++q)
       {
-        return m_leaf;
+        uint32_t i = bounds[q - 1];
+        while (i < bounds[4] && ((m_codes[i] >> shift) & 3) < q)
+          ++i;
+        bounds[q] = i;
       }
 
-      bool
-      remove(const Bounds& area, const Bounds& b)
+      node.child = (uint32_t)m_nodes.size();
+      for (unsigned q = 0; q < 4; ++q)
+      {
+        if (bounds[q + 1] > bounds[q])
+          ++node.children;
+      }
+
+      m_nodes[index] = node;
+      m_nodes.resize(m_nodes.size() + node.children);
+
+      uint32_t child = node.child;
+      for (unsigned q = 0; q < 4; ++q)
+      {
+        if (bounds[q + 1] > bounds[q])
+          build(child++, bounds[q], bounds[q + 1] - bounds[q], level + 1);
+      }
+    }
+
+    void
+    QuadTree::iterate(Iteration& iter) const
+    {
+      update();
+
+      for (size_t i = 0; i < m_items.size(); ++i)
+        iter.process(m_items[i]);
+    }
+
+    void
+    QuadTree::iterate(Iteration& iter, const Bounds& area) const
+    {
+      update();
+
+      if (m_nodes.empty())
+        return;
+
+      uint32_t stack[c_stack_size];
+      unsigned top = 0;
+      stack[top++] = 0;
+
+      while (top > 0)
       {
-        if (m_leaf)
-          return area.contains(m_data.item);
+        const Node& node = m_nodes[stack[--top]];
+
+        if (node.min_x > area.max_x || area.min_x > node.max_x ||
+            node.min_y > area.max_y || area.min_y > node.max_y)
+          continue;
 
-        int cdel = 0;
+        bool inside = area.contains(Point(node.min_x, node.min_y))
+                      && area.contains(Point(node.max_x, node.max_y));
 
-        for (int i = 0; i < 4; ++i)
+        if (inside || node.child == 0)
+        {
+          for (uint32_t i = node.first; i < node.first + node.count; ++i)
+          {
+            if (inside || area.contains(m_items[i]))
+              iter.process(m_items[i]);
+          }
+        }
+        else
         {
-          Node** c = m_data.children + i;
+          for (uint32_t i = 0; i < node.children; ++i)
+            stack[top++] = node.child + i;
+        }
+      }
+    }
+
+    void
+    QuadTree::iterate(Iteration& iter, const Point& center, double radius) const
+    {
+      update();
+
+      if (m_nodes.empty())
+        return;
+
+      double r2 = radius * radius;
+      uint32_t stack[c_stack_size];
+      unsigned top = 0;
+      stack[top++] = 0;
 
-          if (!*c)
-            continue;
+      while (top > 0)
+      {
+        const Node& node = m_nodes[stack[--top]];
 
-          Bounds cb = b.quadrant(i);
+        if (distance2(node, center) > r2)
+          continue;
 
-          if (area.intersects(cb) && (*c)->remove(area, cb))
+        if (node.child == 0)
+        {
+          for (uint32_t i = node.first; i < node.first + node.count; ++i)
           {
-            delete *c;
-            * c = 0;
-            ++cdel;
+            if (distance2(m_items[i], center) <= r2)
+              iter.process(m_items[i]);
           }
         }
-        return cdel == 4;   // true if all sub-nodes were removed
+        else
+        {
+          for (uint32_t i = 0; i < node.children; ++i)
+            stack[top++] = node.child + i;
+        }
       }
+    }
 
-      void
-      iterate(QuadTree::Iteration& iter, const Bounds& area, const Bounds& b) const
+    size_t
+    QuadTree::nearest(const Point& center, size_t k, Item* items, double* distances) const
+    {
+      update();
+
+      if (m_nodes.empty() || k == 0)
+        return 0;
+
+      size_t found = 0;
+      double worst = 0;
+      uint32_t stack[c_stack_size];
+      unsigned top = 0;
+      stack[top++] = 0;
+
+      while (top > 0)
       {
-        if (m_leaf && b.contains(m_data.item))
-          iter.process(m_data.item);
+        const Node& node = m_nodes[stack[--top]];
+
+        if (found == k && distance2(node, center) > worst)
+          continue;
+
+        if (node.child == 0)
+        {
+          for (uint32_t i = node.first; i < node.first + node.count; ++i)
+          {
+            double d = distance2(m_items[i], center);
+            if (found == k && d >= worst)
+              continue;
+
+            // Insertion into the sorted result list.
+            size_t j = (found < k) ? found++ : k - 1;
+            while (j > 0 && distance2(items[j - 1], center) > d)
+            {
+              items[j] = items[j - 1];
+              --j;
+            }
+
+            items[j] = m_items[i];
+            worst = distance2(items[found - 1], center);
+          }
+        }
         else
-          for (int i = 0; i < 4; ++i)
+        {
+          // Push farthest children first so the closest is visited next.
+          uint32_t order[4];
+          double dist[4];
+          for (uint32_t i = 0; i < node.children; ++i)
           {
-            if (m_data.children[i])
+            double d = distance2(m_nodes[node.child + i], center);
+            uint32_t j = i;
+            while (j > 0 && dist[j - 1] < d)
             {
-              Bounds cb = b.quadrant(i);
-              if (area.intersects(cb))
-                m_data.children[i]->iterate(iter, area, cb);
+              order[j] = order[j - 1];
+              dist[j] = dist[j - 1];
+              --j;
             }
+
+            order[j] = node.child + i;
+            dist[j] = d;
           }
-      }
-    };
 
-    QuadTree::QuadTree(const Bounds& bounds):
-      m_bounds(bounds), m_root(0)
-    { }
+          for (uint32_t i = 0; i < node.children; ++i)
+          {
+            if (found < k || dist[i] <= worst)
+              stack[top++] = order[i];
+          }
+        }
+      }
 
-    QuadTree::~QuadTree()
-    {
-      clear();
-    }
+      if (distances != NULL)
+      {
+        for (size_t i = 0; i < found; ++i)
+          distances[i] = std::sqrt(distance2(items[i], center));
+      }
 
-    void
-    QuadTree::iterate(Iteration& iter) const
-    {
-      iterate(iter, m_bounds);
+      return found;
     }
 
     void
-    QuadTree::iterate(Iteration& iter, const Bounds& area) const
+    QuadTree::clear()
     {
-      if (!m_root)
-        return;
-
-      m_root->iterate(iter, area, m_bounds);
+      m_items.clear();
+      m_codes.clear();
+      m_nodes.clear();
+      m_indexed = 0;
     }
 
     void
-    QuadTree::clear()
+    QuadTree::remove(const Bounds& area)
     {
-      if (m_root)
+      size_t n = 0;
+      for (size_t i = 0; i < m_items.size(); ++i)
       {
-        delete m_root;
-        m_root = 0;
+        if (area.contains(m_items[i]))
+          continue;
+
+        m_items[n] = m_items[i];
+        m_codes[n] = m_codes[i];
+        ++n;
       }
-    }
 
-    void
-    QuadTree::remove(const Bounds& area)
-    {
-      if (m_root && m_root->remove(area, m_bounds))
-        clear();   // entire contents were deleted
+      m_items.resize(n);
+      m_codes.resize(n);
+      rebuild();
     }
 
     bool
@@ -186,10 +447,8 @@ namespace Simulators
       if (!m_bounds.contains(item))
         return false;
 
-      if (!m_root)
-        m_root = new Node(item);
-      else
-        m_root->insert(item, m_bounds);
+      m_items.push_back(item);
+      m_codes.push_back(code(item.x, item.y));
 
       return true;
     }
@@ -216,9 +475,7 @@ namespace Simulators
 
       v.clear();
       Search iter(v);
-
-      if (m_root)
-        m_root->iterate(iter, search_area, m_bounds);
+      iterate(iter, search_area);
 
       return v.size() != 0;
     }
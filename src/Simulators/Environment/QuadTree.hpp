@@ -46,10 +46,15 @@ namespace Simulators
 {
   namespace Environment
   {
-    //! Forward declaration.
-    struct Node;
-
     //! "Quad-tree" structure used to index spatial data in two dimensions.
+    //!
+    //! Items are kept in a single array sorted by their Morton
+    //! (Z-order) code and the tree nodes live in a second contiguous
+    //! array, each node referring to a range of items and to a range
+    //! of child nodes. Queries walk the nodes with a fixed-size stack
+    //! and do not allocate. Items added with insert() are indexed the
+    //! next time the tree is queried; bulk loading is preferred when
+    //! all data is available up front.
     class QuadTree
     {
     public:
@@ -73,8 +78,21 @@ namespace Simulators
       //! Constructor.
       QuadTree(const Bounds& bounds);
 
+      //! Constructor with bulk loading.
+      //! @param[in] bounds tree bounds.
+      //! @param[in] items items to load, out-of-bounds items are ignored.
+      QuadTree(const Bounds& bounds, const std::vector<Item>& items);
+
       ~QuadTree();
 
+      //! Replace the contents of the tree.
+      //! Loading is fastest when items are already in Morton order,
+      //! e.g. when they were previously obtained by iterating a tree
+      //! with the same bounds.
+      //! @param[in] items items to load, out-of-bounds items are ignored.
+      void
+      load(const std::vector<Item>& items);
+
       //! Insert an item.
       //! Returns 'false' if item is out-of-bounds.
       bool
@@ -88,6 +106,24 @@ namespace Simulators
       void
       iterate(Iteration& iteration, const Bounds& area) const;
 
+      //! Iterate over the items within a given distance of a point.
+      //! @param[in] iteration iteration handle.
+      //! @param[in] center center of the search.
+      //! @param[in] radius search radius.
+      void
+      iterate(Iteration& iteration, const Point& center, double radius) const;
+
+      //! Find the k items nearest to a point.
+      //! @param[in] center query point.
+      //! @param[in] k maximum number of items to find.
+      //! @param[out] items nearest items, sorted by increasing distance
+      //! (must hold k items).
+      //! @param[out] distances distances of the nearest items (must
+      //! hold k values or be NULL).
+      //! @return number of items found.
+      size_t
+      nearest(const Point& center, size_t k, Item* items, double* distances = NULL) const;
+
       //! Clear entire tree.
       void
       clear(void);
@@ -105,9 +141,54 @@ namespace Simulators
       uint32_t
       size(const Bounds& area) const;
 
+      //! Get total number of elements.
+      size_t
+      size(void) const
+      {
+        return m_items.size();
+      }
+
     private:
+      //! Tree node.
+      struct Node
+      {
+        //! Bounding box of the items below this node.
+        double min_x, max_x, min_y, max_y;
+        //! Index of the first item.
+        uint32_t first;
+        //! Number of items.
+        uint32_t count;
+        //! Index of the first child node (0 if leaf).
+        uint32_t child;
+        //! Number of child nodes.
+        uint32_t children;
+      };
+
       Bounds m_bounds;     //!< Bounds.
-      Node* m_root;     //!< Node handle providing actual implementation.
+      //! Items in Morton order.
+      mutable std::vector<Item> m_items;
+      //! Morton codes of the items.
+      mutable std::vector<uint32_t> m_codes;
+      //! Nodes, root first.
+      mutable std::vector<Node> m_nodes;
+      //! Number of items covered by the nodes.
+      mutable size_t m_indexed;
+
+      //! Compute the Morton code of a point.
+      uint32_t
+      code(double x, double y) const;
+
+      //! Index items added since the last query.
+      void
+      update(void) const;
+
+      //! Sort items and rebuild all nodes.
+      void
+      rebuild(void) const;
+
+      //! Build a node and its descendants.
+      void
+      build(uint32_t index, uint32_t first, uint32_t count, unsigned level) const;
     };
 
     std::ostream&
@@ -29,13 +29,14 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <cstdlib>
 #include <iomanip>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
-#include "QuadTree.hpp"
+#include "Bathymetry.hpp"
 
 namespace Simulators
 {
@@ -49,9 +50,6 @@ namespace Simulators
     using std::sin;
     using std::cos;
 
-    //! Number of points in the forward direction for bottom intersection
-    static const unsigned c_forward_points = 10;
-
     class PencilBeam
     {
     public:
@@ -143,6 +141,12 @@ namespace Simulators
       double oob_depth;
       //! Interpolation radius.
       double interp_radius;
+      //! Bathymetry grid resolution.
+      double resolution;
+      //! Bathymetry interpolation method.
+      std::string interp_method;
+      //! Cache gridded bathymetry on disk.
+      bool cache;
       // Forward distance arguments
       //! Standard deviation of the forward distance estimates
       double fd_std_dev;
@@ -195,8 +199,10 @@ namespace Simulators
       double m_a_n, m_a_e, m_b_n, m_b_e;
       //! PRNG handle.
       Random::Generator* m_prng;
-      //! The tree.
-      QuadTree* m_qtree;
+      //! Gridded bathymetry.
+      Bathymetry* m_bathy;
+      //! Bathymetry interpolation method.
+      Bathymetry::Interpolation m_interp;
       //! Reference latitude and longitude for data points.
       double m_ref_lat, m_ref_lon;
       //! NE offsets in regard to navigational reference.
@@ -209,7 +215,8 @@ namespace Simulators
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Periodic(name, ctx),
         m_prng(NULL),
-        m_qtree(NULL),
+        m_bathy(NULL),
+        m_interp(Bathymetry::INTERP_BILINEAR),
         m_pb(NULL)
       {
         param("Simulate - Bottom Distance", m_args.simulate_bd)
@@ -248,7 +255,24 @@ namespace Simulators
 
         param("Interpolation Radius", m_args.interp_radius)
         .units(Units::Meter)
-        .defaultValue("10.0");
+        .defaultValue("10.0")
+        .description("Radius of the soundings used to compute each grid point");
+
+        param("Bathymetry Resolution", m_args.resolution)
+        .units(Units::Meter)
+        .defaultValue("5.0")
+        .minimumValue("0.1")
+        .description("Spacing of the bathymetry grid");
+
+        param("Bathymetry Interpolation", m_args.interp_method)
+        .values("Nearest, Bilinear, Bicubic")
+        .defaultValue("Bilinear")
+        .description("Interpolation method used to compute depths between grid points");
+
+        param("Bathymetry Cache", m_args.cache)
+        .defaultValue("true")
+        .description("Store the gridded bathymetry in a binary file in the"
+                     " data directory and reuse it while it is up to date");
 
         param("Simulate Pier", m_args.simulate_pier)
         .defaultValue("false")
@@ -354,7 +378,7 @@ namespace Simulators
       onResourceRelease(void)
       {
         Memory::clear(m_prng);
-        Memory::clear(m_qtree);
+        Memory::clear(m_bathy);
         Memory::clear(m_pb);
       }
 
@@ -379,6 +403,16 @@ namespace Simulators
             m_args.forward_orientation[i] = Angles::radians(m_args.forward_orientation[i]);
         }
 
+        if (paramChanged(m_args.interp_method))
+        {
+          if (m_args.interp_method == "Nearest")
+            m_interp = Bathymetry::INTERP_NEAREST;
+          else if (m_args.interp_method == "Bicubic")
+            m_interp = Bathymetry::INTERP_BICUBIC;
+          else
+            m_interp = Bathymetry::INTERP_BILINEAR;
+        }
+
         if (paramChanged(m_args.pb.sector_width))
           m_args.pb.sector_width = Angles::radians(m_args.pb.sector_width);
 
@@ -397,54 +431,92 @@ namespace Simulators
         debug("pier point B lat: %0.6f, lon: %0.6f", m_args.pier[2], m_args.pier[3]);
       }
 
+      //! Load the gridded bathymetry, using the binary cache when it
+      //! is up to date with the source data.
       void
-      onResourceInitialization(void)
+      loadBathymetry(void)
       {
         Utils::String::toLowerCase(m_args.location);
         Path path = m_ctx.dir_cfg / "simulation" / ("bathymetry-" + m_args.location + ".ini");
-        DUNE::Parsers::Config cfg(path.c_str());
-        std::vector<std::string> lines;
-        cfg.get("Bathymetry", "Data", "", lines);
-        cfg.get("Bathymetry", "Latitude (degrees)", "", m_ref_lat);
-        cfg.get("Bathymetry", "Longitude (degrees)", "", m_ref_lon);
+        Path cache = m_ctx.dir_db / ("bathymetry-" + m_args.location + ".bin");
 
-        debug("%s | %0.6f, %0.6f", m_args.location.c_str(), m_ref_lat, m_ref_lon);
         debug("%s | %s", m_args.location.c_str(), path.c_str());
-        debug("%s | %lu %s", m_args.location.c_str(), (long unsigned int)lines.size(), "bathymetry values");
 
-        m_ref_lat = Angles::radians(m_ref_lat);
-        m_ref_lon = Angles::radians(m_ref_lon);
+        if (m_args.cache)
+        {
+          try
+          {
+            m_bathy = Bathymetry::loadCache(cache.str(), path.str(),
+                                            m_args.resolution, m_args.interp_radius);
 
-        std::vector<QuadTree::Item> data;
-        QuadTree::Item item;
-        Bounds* bounds = 0;
+            if (m_bathy != NULL)
+              debug("%s | loaded %s", m_args.location.c_str(), cache.c_str());
+          }
+          catch (std::exception& e)
+          {
+            war("%s", e.what());
+          }
+        }
 
-        for (unsigned i = 0; i < lines.size(); ++i)
+        if (m_bathy == NULL)
         {
-          std::vector<double> v;
-          DUNE::Utils::String::split(lines[i], " ", v);
-          if (!bounds)
-            bounds = new Bounds(Point(v[0], v[1]));
-          else
-            bounds->cover(Point(v[0], v[1]));
-          item.x = v[0]; item.y = v[1]; item.value = v[2];
-          data.push_back(item);
-        }
+          DUNE::Parsers::Config cfg(path.c_str());
+          std::vector<std::string> lines;
+          double lat = 0;
+          double lon = 0;
+          cfg.get("Bathymetry", "Data", "", lines);
+          cfg.get("Bathymetry", "Latitude (degrees)", "", lat);
+          cfg.get("Bathymetry", "Longitude (degrees)", "", lon);
 
-        std::stringstream ss;
-        ss << *bounds;
-        trace("bounds: %s", ss.str().c_str());
+          debug("%s | %lu %s", m_args.location.c_str(), (long unsigned int)lines.size(), "bathymetry values");
+
+          std::vector<QuadTree::Item> data;
+          data.reserve(lines.size());
+          QuadTree::Item item;
+
+          for (unsigned i = 0; i < lines.size(); ++i)
+          {
+            const char* str = lines[i].c_str();
+            char* end = NULL;
+            item.x = std::strtod(str, &end);
+            item.y = std::strtod(end, &end);
+            item.value = std::strtod(end, &end);
+
+            if (end != str)
+              data.push_back(item);
+          }
 
-        // Fill the tree
-        m_qtree = new QuadTree(*bounds);
-        delete bounds;
+          m_bathy = new Bathymetry(data, Angles::radians(lat), Angles::radians(lon),
+                                   m_args.resolution, m_args.interp_radius);
 
-        for (unsigned i = 0; i < data.size(); ++i)
-          m_qtree->insert(data[i]);
+          if (m_args.cache)
+          {
+            try
+            {
+              m_bathy->save(cache.str());
+            }
+            catch (std::exception& e)
+            {
+              war("%s", e.what());
+            }
+          }
+        }
 
-        ss.clear();
-        ss << *m_qtree;
-        trace("tree elements: %s", ss.str().c_str());
+        m_ref_lat = m_bathy->getLatitude();
+        m_ref_lon = m_bathy->getLongitude();
+
+        const Math::Grid<2>& grid = m_bathy->getGrid();
+        debug("%s | %0.6f, %0.6f", m_args.location.c_str(),
+              Angles::degrees(m_ref_lat), Angles::degrees(m_ref_lon));
+        trace("grid: %lu x %lu points, north [%0.2f, %0.2f], east [%0.2f, %0.2f]",
+              (long unsigned int)grid.getDimensions(0), (long unsigned int)grid.getDimensions(1),
+              grid.getLower(0), grid.getUpper(0), grid.getLower(1), grid.getUpper(1));
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        loadBathymetry();
 
         m_bd.beam_config.clear();
         m_bd.location.clear();
@@ -561,35 +633,14 @@ namespace Simulators
       double
       depthAt(double x, double y)
       {
-        Point p(x, y);
-        Bounds search_area(p, m_args.interp_radius);
-
-        std::vector<QuadTree::Item> items;
+        double depth = m_bathy->depth(x, y, m_interp);
 
-        m_qtree->search(search_area, items);
-
-        if (items.size() == 0)
+        if (depth != depth)
         {
           trace("out of bounds");
           return m_args.oob_depth;
         }
 
-        trace("found %lu close data values", (long unsigned int)items.size());
-
-        // @todo interpolate rather than picking closest one
-        double dmin = p.distance(Point(items[0].x, items[0].y));
-        double depth = items[0].value;
-
-        for (unsigned int i = 1; i < items.size(); ++i)
-        {
-          double d = p.distance(Point(items[i].x, items[i].y));
-          if (d < dmin)
-          {
-            dmin = d;
-            depth = items[i].value;
-          }
-        }
-
         return depth + m_args.tide;
       }
 
@@ -699,57 +750,15 @@ namespace Simulators
         return range;
       }
 
-      //! Compute the depths of c_forward_points in front of the vehicle
-      //! Use connections between these points as line segments
-      //! and intersect them with lower beam part of the echo sounder.
+      //! Cast the lower edge of the forward beam against the
+      //! bathymetry.
       //! @return range after intersection
       double
       bottomIntersection(void)
       {
-        double intersect_range = m_args.max_range;
-
-        double x_step = m_args.max_range / (double)c_forward_points;
-
-        std::vector<float> fwd_depths(c_forward_points);
-
-        fwd_depths[0] = depthAt(m_sstate.x + m_off_n, m_sstate.y + m_off_e);
-
-        // x and z coordinates of the end of the forward beam
-        double x_target, z_target;
-
-        x_target = m_args.max_range * cos(m_sstate.theta - m_args.forward_width / 2.0);
-        z_target = - m_args.max_range * sin(m_sstate.theta - m_args.forward_width / 2.0);
-        z_target += m_sstate.z; // SHOULD NOT BE Z BUT DEPTH
-
-        for (unsigned i = 1; i < c_forward_points; i++)
-        {
-          double xe = (double)i * x_step * cos(m_sstate.psi);
-          double ye = (double)i * x_step * sin(m_sstate.psi);
-
-          fwd_depths[i] = depthAt(m_sstate.x + m_off_n + xe, m_sstate.y + m_off_e + ye);
-
-          double bottom_x_1 = (double)(i - 1) * x_step;
-          double bottom_z_1 = fwd_depths[i - 1];
-
-          double bottom_x_2 = (double)i * x_step;
-          double bottom_z_2 = fwd_depths[i];
-
-          double x, z;
-
-          bool test_int = lineSegmentIntersect(LineSegParam<double>(0.0, m_sstate.z,
-                                                                    x_target, z_target,
-                                                                    bottom_x_1, bottom_z_1,
-                                                                    bottom_x_2, bottom_z_2),
-                                               &x, &z); // SHOULD NOT BE STATE.Z BUT DEPTH
-
-          if (test_int)
-          {
-            intersect_range = Math::norm(x, z - m_sstate.z); // SHOULD NOT BE Z BUT DEPTH
-            break;
-          }
-        }
-
-        return intersect_range;
+        return m_bathy->intersect(m_sstate.x + m_off_n, m_sstate.y + m_off_e, m_sstate.z,
+                                  m_sstate.psi, m_sstate.theta - m_args.forward_width / 2.0,
+                                  m_args.max_range, m_args.tide);
       }
     };
   }
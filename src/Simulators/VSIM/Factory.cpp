@@ -61,12 +61,18 @@ namespace Simulators
     Simulators::VSIM::Vehicle*
     Factory::produceVehicle(Parsers::Config& cfg)
     {
-      Simulators::VSIM::Vehicle* vehicle = NULL;
-
       // To allow different types of vehicles.
       std::string model;
       cfg.get("General", "Vehicle Type", "lauv", model);
 
+      return produceVehicle(cfg, model);
+    }
+
+    Simulators::VSIM::Vehicle*
+    Factory::produceVehicle(Parsers::Config& cfg, const std::string& model)
+    {
+      Simulators::VSIM::Vehicle* vehicle = NULL;
+
       // Build model's complete section name.
       std::string section = "VSIM/Model/" + model;
 
@@ -57,6 +57,13 @@ namespace Simulators
       //! @return pointer to a VSIM::Vehicle object.
       static Simulators::VSIM::Vehicle*
       produceVehicle(DUNE::Parsers::Config& cfg);
+
+      //! This task is responsible for creating a vehicle of a given model.
+      //! @param[in] cfg configuration file.
+      //! @param[in] model vehicle model (section VSIM/Model/<model>).
+      //! @return pointer to a VSIM::Vehicle object.
+      static Simulators::VSIM::Vehicle*
+      produceVehicle(DUNE::Parsers::Config& cfg, const std::string& model);
     };
   }
 }
@@ -65,25 +65,45 @@ namespace Simulators
       std::string svlabel;
       //! Simulation time multiplier
       double time_multiplier;
+      //! Additional simulated systems.
+      std::vector<std::string> fleet;
+      //! Vehicle models of additional simulated systems.
+      std::vector<std::string> fleet_models;
+      //! Integration scheme.
+      std::string integrator;
+      //! Number of threads used to step vehicles.
+      unsigned threads;
+    };
+
+    //! Simulated system.
+    struct Member
+    {
+      //! System name.
+      std::string name;
+      //! System identifier.
+      unsigned id;
+      //! Simulation vehicle.
+      Simulators::VSIM::Vehicle* vehicle;
+      //! Simulated position (X,Y,Z).
+      IMC::SimulatedState sstate;
+      //! Stream velocity.
+      double svel[3];
+      //! True if the vehicle origin is defined.
+      bool active;
     };
 
     //! Simulator task.
     struct Task: public Tasks::Periodic
     {
-      //! Simulation vehicle.
-      Simulators::VSIM::Vehicle* m_vehicle;
+      //! Simulated systems, local system first.
+      std::vector<Member> m_members;
       //! Simulation world.
       Simulators::VSIM::World* m_world;
-      //! Simulated position (X,Y,Z).
-      IMC::SimulatedState m_sstate;
       //! Task arguments.
       Arguments m_args;
-      //! Stream velocity.
-      double m_svel[3];
 
       Task(const std::string& name, Tasks::Context& ctx):
         Periodic(name, ctx),
-        m_vehicle(NULL),
         m_world(NULL)
       {
         param("Time Multiplier", m_args.time_multiplier)
@@ -94,6 +114,31 @@ namespace Simulators
             .defaultValue("Stream Velocity Simulator")
             .description("Entity label of the stream velocity source.");
 
+        param("Fleet Systems", m_args.fleet)
+        .defaultValue("")
+        .description("Names of other systems simulated in the same world."
+                     " Their actuation messages are matched by source system"
+                     " and their simulated state is dispatched on their behalf"
+                     " once their origin is defined and the local vehicle is"
+                     " active. Stream velocity is only applied to the local"
+                     " vehicle");
+
+        param("Fleet Vehicle Types", m_args.fleet_models)
+        .defaultValue("")
+        .description("VSIM model of each fleet system, defaults to"
+                     " the local vehicle type");
+
+        param("Integration Scheme", m_args.integrator)
+        .values("Euler, RK4")
+        .defaultValue("Euler")
+        .description("Integration scheme of vehicle dynamics");
+
+        param("Worker Threads", m_args.threads)
+        .defaultValue("1")
+        .minimumValue("1")
+        .maximumValue("64")
+        .description("Number of threads used to step vehicles");
+
         // Register handler routines.
         bind<IMC::GpsFix>(this);
         bind<IMC::ServoPosition>(this);
@@ -115,11 +160,43 @@ namespace Simulators
       void
       onResourceRelease(void)
       {
-        Memory::clear(m_vehicle);
         Memory::clear(m_world);
+
+        for (unsigned i = 0; i < m_members.size(); ++i)
+          Memory::clear(m_members[i].vehicle);
+
+        m_members.clear();
+      }
+
+      //! Create a vehicle and add it to the world.
+      //! @param[in] name system name.
+      //! @param[in] id system identifier.
+      //! @param[in] vehicle simulation vehicle.
+      void
+      addMember(const std::string& name, unsigned id, Simulators::VSIM::Vehicle* vehicle)
+      {
+        if (!vehicle)
+          throw std::runtime_error(Utils::String::str(DTR("error loading vehicle parameters for %s."),
+                                                      name.c_str()));
+
+        if (m_args.integrator == "RK4")
+          vehicle->setIntegrator(Simulators::VSIM::Object::INTEGRATOR_RK4);
+
+        Member member;
+        member.name = name;
+        member.id = id;
+        member.vehicle = vehicle;
+        member.svel[0] = 0.0;
+        member.svel[1] = 0.0;
+        member.svel[2] = 0.0;
+        member.active = false;
+        member.sstate.setSource(id);
+
+        m_members.push_back(member);
+        m_world->addVehicle(vehicle);
       }
 
-      //! Initialize resources and add vehicle to the world.
+      //! Initialize resources and add vehicles to the world.
       void
       onResourceInitialization(void)
       {
@@ -128,34 +205,74 @@ namespace Simulators
         if (!m_world)
           throw std::runtime_error(DTR("error loading world parameters."));
 
-        m_vehicle = Factory::produceVehicle(m_ctx.config);
-        if (!m_vehicle)
-          throw std::runtime_error(DTR("error loading vehicle parameters."));
+        m_members.reserve(m_args.fleet.size() + 1);
+        addMember(getSystemName(), getSystemId(), Factory::produceVehicle(m_ctx.config));
+
+        for (unsigned i = 0; i < m_args.fleet.size(); ++i)
+        {
+          unsigned id = resolveSystemName(m_args.fleet[i]);
+          if (id == IMC::AddressResolver::invalid())
+            throw std::runtime_error(Utils::String::str(DTR("unknown fleet system %s."),
+                                                        m_args.fleet[i].c_str()));
+
+          Simulators::VSIM::Vehicle* vehicle = NULL;
+          if (i < m_args.fleet_models.size())
+            vehicle = Factory::produceVehicle(m_ctx.config, m_args.fleet_models[i]);
+          else
+            vehicle = Factory::produceVehicle(m_ctx.config);
+
+          addMember(m_args.fleet[i], id, vehicle);
+          m_members.back().sstate.setDestination(id);
+        }
 
-        m_world->addVehicle(m_vehicle);
         m_world->setTimeStep(1.0 / getFrequency());
+        m_world->setThreads(std::min(m_args.threads, (unsigned)m_members.size()));
 
-        m_svel[0] = 0.0;
-        m_svel[1] = 0.0;
-        m_svel[2] = 0.0;
+        if (m_members.size() > 1)
+          inf(DTR("simulating %u vehicles using %u threads"),
+              (unsigned)m_members.size(), m_world->getThreads());
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
+      //! Find simulated system.
+      //! @param[in] id system identifier.
+      //! @return simulated system or NULL if not simulated.
+      Member*
+      lookup(unsigned id)
+      {
+        for (unsigned i = 0; i < m_members.size(); ++i)
+        {
+          if (m_members[i].id == id)
+            return &m_members[i];
+        }
+
+        return NULL;
+      }
+
       void
       consume(const IMC::GpsFix* msg)
       {
         if (msg->type != IMC::GpsFix::GFT_MANUAL_INPUT)
           return;
 
+        Member* m = lookup(msg->getSource());
+        if (m == NULL)
+          return;
+
         // We assume vehicle starts at sea surface.
-        m_vehicle->setPosition(0, 0, 0);
-        m_vehicle->setOrientation(0, 0, msg->cog);
+        m->vehicle->setPosition(0, 0, 0);
+        m->vehicle->setOrientation(0, 0, msg->cog);
 
         // Define vehicle origin.
-        m_sstate.lat = msg->lat;
-        m_sstate.lon = msg->lon;
-        m_sstate.height = msg->height;
+        m->sstate.lat = msg->lat;
+        m->sstate.lon = msg->lon;
+        m->sstate.height = msg->height;
+        m->active = true;
+
+        // Only the local vehicle activates the simulation.
+        if (m->id != getSystemId())
+          return;
 
         requestActivation();
 
@@ -169,14 +286,22 @@ namespace Simulators
       void
       consume(const IMC::ServoPosition* msg)
       {
-        UUV* v = static_cast<UUV*>(m_vehicle);
+        Member* m = lookup(msg->getSource());
+        if (m == NULL)
+          return;
+
+        UUV* v = static_cast<UUV*>(m->vehicle);
         v->updateFin(msg->id, msg->value);
       }
 
       void
       consume(const IMC::SetThrusterActuation* msg)
       {
-        m_vehicle->updateEngine(msg->id, msg->value);
+        Member* m = lookup(msg->getSource());
+        if (m == NULL)
+          return;
+
+        m->vehicle->updateEngine(msg->id, msg->value);
       }
 
       void
@@ -187,63 +312,79 @@ namespace Simulators
             resolveEntity(msg->getSourceEntity()) != m_args.svlabel)
           return;
 
-        m_svel[0] = msg->x;
-        m_svel[1] = msg->y;
-        m_svel[2] = msg->z;
+        // Estimates refer to the local vehicle only.
+        Member& m = m_members[0];
+        m.svel[0] = msg->x;
+        m.svel[1] = msg->y;
+        m.svel[2] = msg->z;
 
         debug(DTR("Setting stream velocity: %f m/s N : %f m/s E : %f m/s D"),
-              m_svel[0],
-              m_svel[1],
-              m_svel[2]);
+              m.svel[0],
+              m.svel[1],
+              m.svel[2]);
       }
 
+      //! Fill and dispatch the simulated state of a system.
+      //! @param[in] m simulated system.
       void
-      task(void)
+      dispatchState(Member& m)
       {
-        if (!isActive())
-          return;
-
-        m_world->takeStep();
-
         // Fill position.
-        double* position = m_vehicle->getPosition();
+        double* position = m.vehicle->getPosition();
 
         // TODO
         // This is a temporary fix and this operation should probably be done
         // inside the Vehicle class.
         // Add stream velocity.
-        position[0] += m_world->getTimeStep() * m_svel[0];
-        position[1] += m_world->getTimeStep() * m_svel[1];
-        position[2] += m_world->getTimeStep() * m_svel[2];
+        position[0] += m_world->getTimeStep() * m.svel[0];
+        position[1] += m_world->getTimeStep() * m.svel[1];
+        position[2] += m_world->getTimeStep() * m.svel[2];
 
-        m_sstate.x = position[0];
-        m_sstate.y = position[1];
-        m_sstate.z = std::max(position[2], 0.0);
+        m.sstate.x = position[0];
+        m.sstate.y = position[1];
+        m.sstate.z = std::max(position[2], 0.0);
 
         // Fill attitude.
-        double* attitude = m_vehicle->getOrientation();
-        m_sstate.phi = Angles::normalizeRadian(attitude[0]);
-        m_sstate.theta = Angles::normalizeRadian(attitude[1]);
-        m_sstate.psi = Angles::normalizeRadian(attitude[2]);
+        double* attitude = m.vehicle->getOrientation();
+        m.sstate.phi = Angles::normalizeRadian(attitude[0]);
+        m.sstate.theta = Angles::normalizeRadian(attitude[1]);
+        m.sstate.psi = Angles::normalizeRadian(attitude[2]);
 
         // Fill angular velocity.
-        double* av = m_vehicle->getAngularVelocity();
-        m_sstate.p = av[0];
-        m_sstate.q = av[1];
-        m_sstate.r = av[2];
+        double* av = m.vehicle->getAngularVelocity();
+        m.sstate.p = av[0];
+        m.sstate.q = av[1];
+        m.sstate.r = av[2];
 
         // Fill linear velocity.
-        double* lv = m_vehicle->getLinearVelocity();
-        m_sstate.u = lv[0];
-        m_sstate.v = lv[1];
-        m_sstate.w = lv[2];
+        double* lv = m.vehicle->getLinearVelocity();
+        m.sstate.u = lv[0];
+        m.sstate.v = lv[1];
+        m.sstate.w = lv[2];
 
         // Fill stream velocity.
-        m_sstate.svx = m_svel[0];
-        m_sstate.svy = m_svel[1];
-        m_sstate.svz = m_svel[2];
+        m.sstate.svx = m.svel[0];
+        m.sstate.svy = m.svel[1];
+        m.sstate.svz = m.svel[2];
 
-        dispatch(m_sstate);
+        dispatch(m.sstate);
+      }
+
+      void
+      task(void)
+      {
+        if (!isActive())
+          return;
+
+        m_world->takeStep();
+
+        // The local vehicle is simulated whenever the task is active,
+        // fleet systems once their origin is known.
+        for (unsigned i = 0; i < m_members.size(); ++i)
+        {
+          if (i == 0 || m_members[i].active)
+            dispatchState(m_members[i]);
+        }
       }
     };
   }
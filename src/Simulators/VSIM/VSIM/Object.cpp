@@ -61,6 +61,8 @@ namespace Simulators
 
       m_body_id = 0;
       m_mass = 0;
+      m_integration_method = true;
+      m_integrator = INTEGRATOR_EULER;
     }
 
     void
@@ -165,7 +167,31 @@ namespace Simulators
     }
 
     void
-    Object::update(double ts)
+    Object::getState(double x[c_state_size]) const
+    {
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        x[i] = m_position[i];
+        x[i + 3] = m_orientation[i];
+        x[i + 6] = m_linear_velocity[i];
+        x[i + 9] = m_angular_velocity[i];
+      }
+    }
+
+    void
+    Object::setState(const double x[c_state_size])
+    {
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_position[i] = x[i];
+        m_orientation[i] = x[i + 3];
+        m_linear_velocity[i] = x[i + 6];
+        m_angular_velocity[i] = x[i + 9];
+      }
+    }
+
+    void
+    Object::derivatives(double dx[c_state_size])
     {
       // Initialize variables.
       double c1 = std::cos(m_orientation[0]);
@@ -185,12 +211,9 @@ namespace Simulators
       double q = m_angular_velocity[1];
       double r = m_angular_velocity[2];
 
-      double d_pos[6];
-      double d_vel[6];
-
       // Accelerations.
       for (unsigned i = 0; i < 6; ++i)
-        d_vel[i] = m_forces[i] / m_inertia[i];
+        dx[i + 6] = m_forces[i] / m_inertia[i];
 
       // Reset forces to zero.
       resetForces();
@@ -200,17 +223,69 @@ namespace Simulators
       //    J1=[ c3*c2   c3*s2*s1-s3*c1  s3*s1+c3*c1*s2
       //         s3*c2   c1*c3+s1*s2*s3  c1*s2*s3-c3*s1
       //          -s2        c2*s1           c1*c2     ];
-      d_pos[0] = (c3 * c2) * u + (c3 * s2 * s1 - s3 * c1) * v + (s3 * s1 + c3 * c1 * s2) * w;
-      d_pos[1] = (s3 * c2) * u + (c1 * c3 + s1 * s2 * s3) * v + (c1 * s2 * s3 - c3 * s1) * w;
-      d_pos[2] = (-s2) * u + (c2 * s1) * v + (c1 * c2) * w;
+      dx[0] = (c3 * c2) * u + (c3 * s2 * s1 - s3 * c1) * v + (s3 * s1 + c3 * c1 * s2) * w;
+      dx[1] = (s3 * c2) * u + (c1 * c3 + s1 * s2 * s3) * v + (c1 * s2 * s3 - c3 * s1) * w;
+      dx[2] = (-s2) * u + (c2 * s1) * v + (c1 * c2) * w;
 
       // Transformation Matrix: eta2dot = J1(eta2)*nu2
       //   J2=[ 1   s1*t2   c1*t2
       //        0    c1      -s1
       //        0   s1/c2   c1/c2 ];
-      d_pos[3] = p + (s1 * t2) * q + (c1 * t2) * r;
-      d_pos[4] = c1 * q + (-s1) * r;
-      d_pos[5] = (s1 / c2) * q + (c1 / c2) * r;
+      dx[3] = p + (s1 * t2) * q + (c1 * t2) * r;
+      dx[4] = c1 * q + (-s1) * r;
+      dx[5] = (s1 / c2) * q + (c1 / c2) * r;
+    }
+
+    void
+    Object::integrateRK4(double ts)
+    {
+      double x0[c_state_size];
+      double x[c_state_size];
+      double k[4][c_state_size];
+      // Fraction of the timestep at which each stage is evaluated.
+      static const double c_stage[3] = {0.5, 0.5, 1.0};
+
+      getState(x0);
+
+      // Forces at the initial state were applied by the world.
+      derivatives(k[0]);
+
+      for (unsigned s = 0; s < 3; ++s)
+      {
+        for (unsigned i = 0; i < c_state_size; ++i)
+          x[i] = x0[i] + c_stage[s] * ts * k[s][i];
+
+        setState(x);
+        applyForces();
+        derivatives(k[s + 1]);
+      }
+
+      for (unsigned i = 0; i < c_state_size; ++i)
+        x[i] = x0[i] + ts / 6.0 * (k[0][i] + 2.0 * k[1][i] + 2.0 * k[2][i] + k[3][i]);
+
+      for (unsigned i = 3; i < 6; ++i)
+        x[i] = x0[i] + Angles::minSignedAngle(x0[i], x[i]);
+
+      setState(x);
+
+      if (m_position[2] <= 0.0)
+        m_position[2] = 0.0;
+    }
+
+    void
+    Object::update(double ts)
+    {
+      if (m_integration_method && m_integrator == INTEGRATOR_RK4)
+      {
+        integrateRK4(ts);
+        return;
+      }
+
+      double d_state[c_state_size];
+      derivatives(d_state);
+
+      double* d_pos = d_state;
+      double* d_vel = d_state + 6;
 
       // Integrate using Euler's method.
       for (unsigned i = 0; i < 3; i++)
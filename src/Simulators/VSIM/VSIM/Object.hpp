@@ -53,6 +53,15 @@ namespace Simulators
         UGV
       };
 
+      //! Integration schemes.
+      enum Integrator
+      {
+        //! Explicit Euler.
+        INTEGRATOR_EULER,
+        //! Classical fourth order Runge-Kutta.
+        INTEGRATOR_RK4
+      };
+
       //! Constructor.
       Object(void);
 
@@ -85,6 +94,15 @@ namespace Simulators
         m_integration_method = method;
       }
 
+      //! Define integration scheme to be applied in update() function.
+      //! Only used with the regular velocity integration method.
+      //! @param[in] integrator integration scheme.
+      void
+      setIntegrator(Integrator integrator)
+      {
+        m_integrator = integrator;
+      }
+
       //! Insert object in virtual World.
       virtual void
       insertInWorld(void);
@@ -191,6 +209,34 @@ namespace Simulators
       double m_forces[6];
       //! Velocity Integration Method (true = regular)
       bool m_integration_method;
+      //! Integration scheme.
+      Integrator m_integrator;
+
+      //! Number of state variables: position, orientation, linear
+      //! and angular velocity.
+      static const unsigned c_state_size = 12;
+
+      //! Copy object state to a state vector.
+      //! @param[out] x state vector.
+      void
+      getState(double x[c_state_size]) const;
+
+      //! Copy a state vector to the object state.
+      //! @param[in] x state vector.
+      void
+      setState(const double x[c_state_size]);
+
+      //! Compute state derivatives from the current state and applied
+      //! forces, and reset forces.
+      //! @param[out] dx state derivatives.
+      void
+      derivatives(double dx[c_state_size]);
+
+      //! Integrate using fourth order Runge-Kutta, applying forces at
+      //! each intermediate state.
+      //! @param[in] timestep integration timestep.
+      void
+      integrateRK4(double timestep);
     };
   }
 }
@@ -28,6 +28,9 @@
 // Author: José Braga                                                       *
 //***************************************************************************
 
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+
 // VSIM headers.
 #include <VSIM/World.hpp>
 
@@ -35,15 +38,94 @@ namespace Simulators
 {
   namespace VSIM
   {
+    //! Vehicle stepping thread.
+    class World::Worker: public DUNE::Concurrency::Thread
+    {
+    public:
+      Worker(World& world, unsigned block):
+        m_world(world),
+        m_block(block)
+      { }
+
+    private:
+      //! Parent world.
+      World& m_world;
+      //! Block of vehicles stepped by this thread.
+      unsigned m_block;
+
+      void
+      run(void)
+      {
+        while (true)
+        {
+          m_world.m_start->wait();
+
+          if (m_world.m_stop)
+            break;
+
+          m_world.stepVehicles(m_block);
+          m_world.m_done->wait();
+        }
+      }
+    };
+
     World::World(int ident, double grv[3], double tstep):
-      m_timestep(tstep)
+      m_timestep(tstep),
+      m_start(NULL),
+      m_done(NULL),
+      m_stop(false)
     {
       m_world_id = ident;
       setGravity(grv[0], grv[1], grv[2]);
     }
 
     World::~World(void)
-    {  }
+    {
+      stopWorkers();
+    }
+
+    void
+    World::setThreads(unsigned count)
+    {
+      stopWorkers();
+
+      if (count <= 1)
+        return;
+
+      m_stop = false;
+      m_start = new DUNE::Concurrency::Barrier(count);
+      m_done = new DUNE::Concurrency::Barrier(count);
+
+      for (unsigned i = 1; i < count; ++i)
+      {
+        Worker* worker = new Worker(*this, i);
+        worker->start();
+        m_workers.push_back(worker);
+      }
+    }
+
+    void
+    World::stopWorkers(void)
+    {
+      if (m_workers.empty())
+        return;
+
+      // Release workers waiting for the next step.
+      m_stop = true;
+      m_start->wait();
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+      {
+        m_workers[i]->stopAndJoin();
+        delete m_workers[i];
+      }
+
+      m_workers.clear();
+      delete m_start;
+      delete m_done;
+      m_start = NULL;
+      m_done = NULL;
+    }
 
     void
     World::setGravity(double x, double y, double z)
@@ -73,10 +155,6 @@ namespace Simulators
       std::list<Object*>::iterator oitr = m_objects.begin();
       for (; oitr != m_objects.end(); ++oitr)
         (*oitr)->applyForces();
-
-      std::list<Vehicle*>::iterator vitr = m_vehicles.begin();
-      for (; vitr != m_vehicles.end(); ++vitr)
-        (*vitr)->applyForces();
     }
 
     void
@@ -85,20 +163,41 @@ namespace Simulators
       std::list<Object*>::iterator oitr = m_objects.begin();
       for (; oitr != m_objects.end(); ++oitr)
         (*oitr)->update(m_timestep);
+    }
 
-      std::list<Vehicle*>::iterator vitr = m_vehicles.begin();
-      for (; vitr != m_vehicles.end(); ++vitr)
-        (*vitr)->update(m_timestep);
+    void
+    World::stepVehicles(unsigned block)
+    {
+      size_t blocks = m_workers.size() + 1;
+      size_t first = m_vehicles.size() * block / blocks;
+      size_t last = m_vehicles.size() * (block + 1) / blocks;
+
+      // Vehicles do not interact, each one can be stepped on its own.
+      for (size_t i = first; i < last; ++i)
+      {
+        m_vehicles[i]->applyForces();
+        m_vehicles[i]->update(m_timestep);
+      }
     }
 
     void
     World::takeStep(void)
     {
-      // Apply forces to vehicle.
+      // Apply forces to objects.
       applyForces();
 
-      // Update vehicle state.
+      // Update object state.
       update();
+
+      if (m_workers.empty())
+      {
+        stepVehicles(0);
+        return;
+      }
+
+      m_start->wait();
+      stepVehicles(0);
+      m_done->wait();
     }
   }
 }
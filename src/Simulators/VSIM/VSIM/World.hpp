@@ -33,6 +33,10 @@
 
 // ISO C++ 98 headers.
 #include <list>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Barrier.hpp>
 
 // VSIM headers.
 #include <VSIM/Object.hpp>
@@ -78,11 +82,38 @@ namespace Simulators
       void
       addVehicle(Vehicle*);
 
+      //! Define the number of threads used to step vehicles. Vehicles
+      //! are split in contiguous blocks, one per thread, and the
+      //! calling thread steps the first block.
+      //! @param[in] count number of threads (including the caller).
+      void
+      setThreads(unsigned count);
+
+      //! Returns the number of threads used to step vehicles.
+      //! @return number of threads.
+      unsigned
+      getThreads(void) const
+      {
+        return m_workers.size() + 1;
+      }
+
       //! Simulation's tick.
       void
       takeStep(void);
 
     private:
+      //! Vehicle stepping thread.
+      class Worker;
+
+      //! Applies forces to and updates a block of vehicles.
+      //! @param[in] block block index.
+      void
+      stepVehicles(unsigned block);
+
+      //! Stop and release worker threads.
+      void
+      stopWorkers(void);
+
       //! Applies forces to all objects/vehicles.
       void
       applyForces(void);
@@ -105,9 +136,17 @@ namespace Simulators
       //! World's vehicles.
       std::list<Object*> m_objects;
       //! World's objects.
-      std::list<Vehicle*> m_vehicles;
+      std::vector<Vehicle*> m_vehicles;
       //! Integration timestep.
       double m_timestep;
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Barrier released at the start of each step.
+      DUNE::Concurrency::Barrier* m_start;
+      //! Barrier released when all blocks were stepped.
+      DUNE::Concurrency::Barrier* m_done;
+      //! True if workers must terminate.
+      bool m_stop;
     };
   }
 }
@@ -30,6 +30,9 @@
 
 // ISO C++ 98 headers.
 #include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -47,6 +50,37 @@ namespace Transports
       double timestamp;
     };
 
+    //! Communication links. Radio modems are not modelled:
+    //! Transports.Radio is driven by TelemetryMsg rather than
+    //! TransmissionRequest and IMC has no radio communication mean,
+    //! so there is no radio path for the router to rank.
+    enum LinkType
+    {
+      LINK_WIFI,
+      LINK_GSM,
+      LINK_SATELLITE,
+      LINK_ACOUSTIC,
+      LINK_TOTAL
+    };
+
+    //! Model of a communication link, used to rank the links that
+    //! can deliver a request.
+    struct LinkModel
+    {
+      //! Bandwidth in bytes per second.
+      double bandwidth;
+      //! Latency in seconds.
+      double latency;
+      //! Cost per byte. Used as a relative preference between links,
+      //! so equal costs are ranked by delivery time.
+      double cost;
+      //! Maximum payload of one transmission in bytes.
+      unsigned mtu;
+    };
+
+    //! Size of the header of an IMC message sent over Iridium.
+    static const unsigned c_iridium_header_size = 12;
+
     class Router
     {
 
@@ -59,6 +93,41 @@ namespace Transports
         m_iridium_entity_id = -1;
         m_reqid = 0;
         c_wifi_timeout = 15;
+        m_sat_aggregation = false;
+        m_sat_window = 0;
+
+        for (unsigned i = 0; i < LINK_TOTAL; ++i)
+        {
+          m_links[i].bandwidth = 1;
+          m_links[i].latency = 0;
+          m_links[i].cost = 0;
+          m_links[i].mtu = 0xffff;
+        }
+      }
+
+      //! Set the model of a link.
+      //! @param[in] type link type.
+      //! @param[in] model link model.
+      void
+      setLinkModel(LinkType type, const LinkModel& model)
+      {
+        m_links[type] = model;
+      }
+
+      //! Configure the aggregation of requests sent over satellite.
+      //! Inline messages to the same destination are held for up to
+      //! 'window' seconds, or until their deadline is close, and
+      //! packed together in a single transmission.
+      //! @param[in] enabled true to enable aggregation.
+      //! @param[in] window maximum holding time in seconds.
+      void
+      setSatelliteAggregation(bool enabled, double window)
+      {
+        m_sat_aggregation = enabled;
+        m_sat_window = window;
+
+        if (!enabled)
+          flushSatellite(true);
       }
 
       void
@@ -182,12 +251,247 @@ namespace Transports
            m_parent->inf("Transmission Request %d is expired by %f seconds", it->second->req_id, it->second->deadline - time);
             answer(it->second, "Transmission timed out.",
                    IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+            answerBatch(it->first, "Transmission timed out.",
+                        IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+            clearBatch(it->first);
             Memory::clear(it->second);
             m_transmission_requests.erase(it++);
           }
           else
             ++it;
         }
+
+        std::vector<PendingRequest>::iterator pit = m_sat_queue.begin();
+        while (pit != m_sat_queue.end())
+        {
+          if (pit->req->deadline <= time)
+          {
+            answer(pit->req, "Transmission timed out.",
+                   IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+            Memory::clear(pit->req);
+            pit = m_sat_queue.erase(pit);
+          }
+          else
+            ++pit;
+        }
+      }
+
+      //! Answer the requests sent together with another request.
+      //! @param[in] id internal identifier of the transmission.
+      //! @param[in] info status description.
+      //! @param[in] status transmission status.
+      void
+      answerBatch(uint16_t id, const std::string& info, int status)
+      {
+        BatchMap::iterator itr = m_batches.find(id);
+        if (itr == m_batches.end())
+          return;
+
+        for (size_t i = 0; i < itr->second.size(); ++i)
+          answer(itr->second[i], info, status);
+      }
+
+      //! Release the requests sent together with another request.
+      //! @param[in] id internal identifier of the transmission.
+      //! @param[out] retransmit if not NULL, list where copies of the
+      //! requests are added for retransmission.
+      void
+      clearBatch(uint16_t id, std::list<IMC::TransmissionRequest*>* retransmit = NULL)
+      {
+        BatchMap::iterator itr = m_batches.find(id);
+        if (itr == m_batches.end())
+          return;
+
+        for (size_t i = 0; i < itr->second.size(); ++i)
+        {
+          if (retransmit != NULL)
+            retransmit->push_back(itr->second[i]->clone());
+          Memory::clear(itr->second[i]);
+        }
+
+        m_batches.erase(itr);
+      }
+
+      //! Retrieve the number of payload bytes of a request.
+      //! @param[in] msg transmission request.
+      //! @return number of bytes.
+      static unsigned
+      getPayloadSize(const IMC::TransmissionRequest* msg)
+      {
+        switch (msg->data_mode)
+        {
+          case IMC::TransmissionRequest::DMODE_INLINEMSG:
+            if (msg->msg_data.isNull())
+              return 0;
+            return msg->msg_data.get()->getPayloadSerializationSize() + 2;
+          case IMC::TransmissionRequest::DMODE_TEXT:
+            return msg->txt_data.size();
+          case IMC::TransmissionRequest::DMODE_RAW:
+            return msg->raw_data.size();
+          default:
+            return 0;
+        }
+      }
+
+      //! Retrieve the number of bytes a request takes on a link.
+      //! @param[in] link link type.
+      //! @param[in] msg transmission request.
+      //! @return number of bytes.
+      static unsigned
+      getTransmissionSize(LinkType link, const IMC::TransmissionRequest* msg)
+      {
+        unsigned size = getPayloadSize(msg);
+
+        // Inline messages over Iridium carry a header in place of the
+        // message identifier.
+        if (link == LINK_SATELLITE
+            && msg->data_mode == IMC::TransmissionRequest::DMODE_INLINEMSG)
+          size += c_iridium_header_size - 2;
+
+        return size;
+      }
+
+      //! Select the link that delivers a request at the lowest cost
+      //! before its deadline or, if none can, the fastest one. Links
+      //! whose maximum payload is smaller than the request are not
+      //! considered.
+      //! @param[in] msg transmission request.
+      //! @param[in] candidates links able to deliver the request.
+      //! @return selected link or LINK_TOTAL if the request does not
+      //! fit in any of the candidates.
+      LinkType
+      selectLink(const IMC::TransmissionRequest* msg, const std::vector<LinkType>& candidates)
+      {
+        double time_left = msg->deadline - Time::Clock::getSinceEpoch();
+
+        LinkType best = LINK_TOTAL;
+        bool best_feasible = false;
+        double best_cost = 0;
+        double best_time = 0;
+
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+          const LinkModel& model = m_links[candidates[i]];
+          double size = getTransmissionSize(candidates[i], msg);
+          if (size > model.mtu)
+            continue;
+
+          double time = model.latency + size / std::max(model.bandwidth, 1e-3);
+          double cost = size * model.cost;
+          bool feasible = time <= time_left;
+
+          bool better = false;
+          if (best == LINK_TOTAL)
+            better = true;
+          else if (feasible != best_feasible)
+            better = feasible;
+          else if (feasible && cost != best_cost)
+            better = cost < best_cost;
+          else
+            better = time < best_time;
+
+          if (better)
+          {
+            best = candidates[i];
+            best_feasible = feasible;
+            best_cost = cost;
+            best_time = time;
+          }
+        }
+
+        return best;
+      }
+
+      //! Send a request over a given link.
+      //! @param[in] link link type.
+      //! @param[in] msg transmission request.
+      //! @param[in] plain_text send satellite texts as plain text.
+      void
+      sendVia(LinkType link, const IMC::TransmissionRequest* msg, bool plain_text)
+      {
+        switch (link)
+        {
+          case LINK_WIFI:
+            sendViaWifi(msg);
+            break;
+          case LINK_GSM:
+            sendViaGSM(msg);
+            break;
+          case LINK_SATELLITE:
+            sendViaSatellite(msg, plain_text);
+            break;
+          case LINK_ACOUSTIC:
+            sendViaAcoustic(msg);
+            break;
+          case LINK_TOTAL:
+            answer(msg, "Message is too large for the available communication modes",
+                   IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+            break;
+          default:
+            answerCommNotAvailable(msg);
+            break;
+        }
+      }
+
+      //! Send the queued satellite requests that are due. Requests are
+      //! sent earliest deadline first, packing the following ones with
+      //! the same destination while they fit in one transmission.
+      //! @param[in] force send all queued requests.
+      void
+      flushSatellite(bool force = false)
+      {
+        const LinkModel& model = m_links[LINK_SATELLITE];
+
+        while (!m_sat_queue.empty())
+        {
+          double now = Time::Clock::getSinceEpoch();
+          std::sort(m_sat_queue.begin(), m_sat_queue.end(), PendingRequest::earlier);
+
+          bool due = force;
+          for (size_t i = 0; i < m_sat_queue.size() && !due; ++i)
+          {
+            due = (now - m_sat_queue[i].queued >= m_sat_window)
+            || (m_sat_queue[i].req->deadline - now <= model.latency);
+          }
+
+          // Pick requests for one transmission.
+          const PendingRequest& head = m_sat_queue[0];
+          std::vector<size_t> picked(1, 0);
+          unsigned single = c_iridium_header_size + getPayloadSize(head.req) - 2;
+          unsigned size = c_iridium_header_size + 2 + getPayloadSize(head.req);
+          bool full = single >= model.mtu;
+
+          for (size_t i = 1; i < m_sat_queue.size() && !full; ++i)
+          {
+            const PendingRequest& p = m_sat_queue[i];
+            if (p.req->destination != head.req->destination
+                || p.req->getDestination() != head.req->getDestination()
+                || p.plain_text != head.plain_text)
+              continue;
+
+            unsigned next = size + getPayloadSize(p.req);
+            if (next > model.mtu)
+            {
+              full = true;
+              continue;
+            }
+
+            size = next;
+            picked.push_back(i);
+          }
+
+          if (!due && !full)
+            return;
+
+          std::vector<IMC::TransmissionRequest*> batch;
+          for (size_t i = picked.size(); i > 0; --i)
+          {
+            batch.insert(batch.begin(), m_sat_queue[picked[i - 1]].req);
+            m_sat_queue.erase(m_sat_queue.begin() + picked[i - 1]);
+          }
+
+          transmitSatelliteBatch(batch, head.plain_text);
+        }
       }
 
       void
@@ -269,6 +573,29 @@ namespace Transports
 
       void
       sendViaSatellite(const IMC::TransmissionRequest* msg, bool plain_text)
+      {
+        if (m_sat_aggregation && msg->data_mode == IMC::TransmissionRequest::DMODE_INLINEMSG
+            && !msg->msg_data.isNull())
+        {
+          m_parent->inf("Request to send data over satellite queued (%d)", msg->req_id);
+
+          PendingRequest p;
+          p.req = msg->clone();
+          p.queued = Time::Clock::getSinceEpoch();
+          p.plain_text = plain_text;
+          m_sat_queue.push_back(p);
+
+          answer(msg, "Queued for satellite transmission.",
+                 IMC::TransmissionStatus::TSTAT_IN_PROGRESS);
+          flushSatellite();
+          return;
+        }
+
+        transmitSatellite(msg, plain_text);
+      }
+
+      void
+      transmitSatellite(const IMC::TransmissionRequest* msg, bool plain_text)
       {
         m_parent->inf("Request to send data over satellite (%d)", msg->req_id);
 
@@ -337,6 +664,55 @@ namespace Transports
         m_parent->dispatch(tx);
       }
 
+      //! Send queued inline messages with the same destination in a
+      //! single satellite transmission. The first request is tracked
+      //! as usual and the remaining ones follow its status.
+      //! @param[in] batch requests to send (ownership is taken).
+      //! @param[in] plain_text send texts as plain text.
+      void
+      transmitSatelliteBatch(std::vector<IMC::TransmissionRequest*>& batch, bool plain_text)
+      {
+        if (batch.size() == 1)
+        {
+          transmitSatellite(batch[0], plain_text);
+          Memory::clear(batch[0]);
+          return;
+        }
+
+        const IMC::TransmissionRequest* head = batch[0];
+        m_parent->inf("Request to send %u messages over satellite (%d)",
+                      (unsigned)batch.size(), head->req_id);
+
+        IMC::MsgList list;
+        double deadline = head->deadline;
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+          list.msgs.push_back(*batch[i]->msg_data.get());
+          deadline = std::min(deadline, batch[i]->deadline);
+        }
+
+        IridiumMsgTx tx;
+        tx.destination = head->destination;
+        tx.ttl = deadline - Time::Clock::getSinceEpoch();
+        tx.setDestination(head->getDestination());
+        tx.setDestinationEntity(head->getDestinationEntity());
+
+        IMC::ImcIridiumMessage m;
+        m.destination = 0xFFFF;
+        m.source = m_parent->getSystemId();
+        m.msg = list.clone();
+        uint8_t buffer[65535];
+        int len = m.serialize(buffer);
+        tx.data.assign(buffer, buffer + len);
+        Memory::clear(m.msg);
+
+        uint16_t newId = createInternalId();
+        tx.req_id = newId;
+        m_transmission_requests[newId] = batch[0];
+        m_batches[newId].assign(batch.begin() + 1, batch.end());
+        m_parent->dispatch(tx);
+      }
+
       void
       sendViaAny(const IMC::TransmissionRequest* msg, bool plain_text)
       {
@@ -401,59 +777,47 @@ namespace Transports
 
             //only for satellite modem or gsm
           case IMC::TransmissionRequest::DMODE_TEXT:
-
-            if (visibleOverGSM(msg->destination, dest)
-                && checkGSMMessageSize(msg))
             {
-              sendViaGSM(msg);
-              return;
-            }
+              std::vector<LinkType> links;
+              if (visibleOverGSM(msg->destination, dest)
+                  && checkGSMMessageSize(msg))
+                links.push_back(LINK_GSM);
+              if (checkRSSISignal(IRIDIUM))
+                links.push_back(LINK_SATELLITE);
 
-            if (checkRSSISignal(IRIDIUM))
-            {
-              sendViaSatellite(msg, plain_text);
+              if (links.empty())
+              {
+                answerCommNotAvailable(msg);
+                return;
+              }
+
+              sendVia(selectLink(msg, links), msg, plain_text);
               return;
             }
-            answerCommNotAvailable(msg);
-            return;
 
             break;
 
           case IMC::TransmissionRequest::DMODE_INLINEMSG:
-            if (visibleOverWifi(msg->destination))
-            {
-              sendViaWifi(msg);
-              return;
-            }
-            if (visibleOverGSM(msg->destination, dest)
-                && checkGSMMessageSize(msg))
-            {
-              sendViaGSM(msg);
-              return;
-            }
-            if (m_medium != IMC::VehicleMedium::VM_WATER)
-            {
-              if (checkRSSISignal(IRIDIUM))
-              {
-                sendViaSatellite(msg, plain_text);
-                return;
-              }
-              answerCommNotAvailable(msg);
-              return;
-            }
-            else
             {
-              if (visibleOverAcoustic(msg->destination))
-              {
-                sendViaAcoustic(msg);
-                return;
-              }
+              std::vector<LinkType> links;
+              if (visibleOverWifi(msg->destination))
+                links.push_back(LINK_WIFI);
+              if (visibleOverGSM(msg->destination, dest)
+                  && checkGSMMessageSize(msg))
+                links.push_back(LINK_GSM);
+              if (m_medium == IMC::VehicleMedium::VM_WATER
+                  && visibleOverAcoustic(msg->destination))
+                links.push_back(LINK_ACOUSTIC);
               if (checkRSSISignal(IRIDIUM))
+                links.push_back(LINK_SATELLITE);
+
+              if (links.empty())
               {
-                sendViaSatellite(msg, plain_text);
+                answerCommNotAvailable(msg);
                 return;
               }
-              answerCommNotAvailable(msg);
+
+              sendVia(selectLink(msg, links), msg, plain_text);
               return;
             }
 
@@ -754,6 +1118,11 @@ namespace Transports
 
       ~Router()
       {
+        for (size_t i = 0; i < m_sat_queue.size(); ++i)
+          Memory::clear(m_sat_queue[i].req);
+
+        while (!m_batches.empty())
+          clearBatch(m_batches.begin()->first);
       }
 
     private:
@@ -782,6 +1151,36 @@ namespace Transports
 
       uint16_t c_wifi_timeout;
 
+      //! Request waiting to be sent over satellite.
+      struct PendingRequest
+      {
+        //! Transmission request.
+        IMC::TransmissionRequest* req;
+        //! Time at which the request was queued.
+        double queued;
+        //! Send texts as plain text.
+        bool plain_text;
+
+        static bool
+        earlier(const PendingRequest& a, const PendingRequest& b)
+        {
+          return a.req->deadline < b.req->deadline;
+        }
+      };
+
+      //! Link models.
+      LinkModel m_links[LINK_TOTAL];
+      //! Satellite aggregation enabled.
+      bool m_sat_aggregation;
+      //! Satellite aggregation window.
+      double m_sat_window;
+      //! Requests waiting to be sent over satellite.
+      std::vector<PendingRequest> m_sat_queue;
+
+      typedef std::map<uint16_t, std::vector<IMC::TransmissionRequest*> > BatchMap;
+      //! Requests sent together with another request.
+      BatchMap m_batches;
+
       enum RSSIType
       {
         GSM, IRIDIUM
@@ -60,6 +60,24 @@ namespace Transports
       std::string acoustic_addr_section;
       //! Send Iridium text messages as plain text
       bool iridium_plain_texts;
+      //! Link models (bandwidth, latency, cost per byte, MTU).
+      std::vector<double> links[LINK_TOTAL];
+      //! Pack queued inline messages in a single Iridium transmission.
+      bool sat_aggregation;
+      //! Maximum time to hold a message for aggregation.
+      double sat_window;
+    };
+
+    //! Names of the links, in the order of LinkType.
+    static const char* c_link_names[] = {"Wi-Fi", "GSM", "Satellite", "Acoustic"};
+    //! Default link models, in the order of LinkType. Costs keep the
+    //! preference order Wi-Fi, GSM, acoustic and satellite.
+    static const char* c_link_defaults[] =
+    {
+      "100000, 0.1, 0, 65535",
+      "20, 10, 0.0001, 160",
+      "30, 60, 0.004, 340",
+      "10, 5, 0.0002, 1024"
     };
 
     //! Config section from where to fetch emergency sms number
@@ -124,6 +142,28 @@ namespace Transports
             .description("Send Iridium text messages as plain text (and not IMC)")
             .defaultValue("1");
 
+        for (unsigned i = 0; i < LINK_TOTAL; ++i)
+        {
+          param(String::str("Link Model - %s", c_link_names[i]), m_args.links[i])
+          .defaultValue(c_link_defaults[i])
+          .size(4)
+          .description("Bandwidth (bytes/s), latency (s), cost per byte and"
+                       " maximum payload (bytes) used to choose among the"
+                       " links able to deliver a request");
+        }
+
+        param("Satellite Aggregation", m_args.sat_aggregation)
+            .defaultValue("false")
+            .description("Pack inline messages with the same destination in a"
+                         " single Iridium transmission");
+
+        param("Satellite Aggregation Window", m_args.sat_window)
+            .defaultValue("30")
+            .units(Units::Second)
+            .description("Maximum time to hold a message waiting for others to"
+                         " be sent with it. Messages closer to their deadline"
+                         " than the satellite latency are sent immediately");
+
         bind<IMC::AcousticOperation>(this);
         bind<IMC::AcousticStatus>(this);
         bind<IMC::Announce>(this);
@@ -217,6 +257,18 @@ namespace Transports
       onUpdateParameters(void)
       {
         m_iridium_timer.setTop(m_args.iridium_period);
+
+        for (unsigned i = 0; i < LINK_TOTAL; ++i)
+        {
+          LinkModel model;
+          model.bandwidth = m_args.links[i][0];
+          model.latency = m_args.links[i][1];
+          model.cost = m_args.links[i][2];
+          model.mtu = (unsigned)m_args.links[i][3];
+          m_router.setLinkModel((LinkType)i, model);
+        }
+
+        m_router.setSatelliteAggregation(m_args.sat_aggregation, m_args.sat_window);
       }
 
       void
@@ -313,28 +365,42 @@ namespace Transports
               m_router.answer(
                   req, "Message has been queued for Satellite transmission.",
                   IMC::TransmissionStatus::TSTAT_IN_PROGRESS);
+              m_router.answerBatch(
+                  msg->req_id, "Message has been queued for Satellite transmission.",
+                  IMC::TransmissionStatus::TSTAT_IN_PROGRESS);
               break;
             case (IMC::IridiumTxStatus::TXSTATUS_TRANSMIT):
               m_router.answer(req, "Message is being transmitted.",
                               IMC::TransmissionStatus::TSTAT_IN_PROGRESS);
+              m_router.answerBatch(msg->req_id, "Message is being transmitted.",
+                                   IMC::TransmissionStatus::TSTAT_IN_PROGRESS);
               break;
             case (IMC::IridiumTxStatus::TXSTATUS_OK):
               m_router.answer(req, "Message has been sent via Iridium.",
                               IMC::TransmissionStatus::TSTAT_SENT);
+              m_router.answerBatch(msg->req_id, "Message has been sent via Iridium.",
+                                   IMC::TransmissionStatus::TSTAT_SENT);
+              m_router.clearBatch(msg->req_id);
               Memory::clear(req);
               tr_list->erase(msg->req_id);
               break;
             case (IMC::IridiumTxStatus::TXSTATUS_ERROR):
               m_router.answer(req, "Error while trying to transmit message.",
                               IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+              m_router.answerBatch(msg->req_id, "Error while trying to transmit message.",
+                                   IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
               tr_list->erase(msg->req_id);
               m_retransmission_list.push_back(req->clone());
+              m_router.clearBatch(msg->req_id, &m_retransmission_list);
               Memory::clear(req);
 
               break;
             case (IMC::IridiumTxStatus::TXSTATUS_EXPIRED):
               m_router.answer(req, "Timeout while trying to transmit message.",
                               IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+              m_router.answerBatch(msg->req_id, "Timeout while trying to transmit message.",
+                                   IMC::TransmissionStatus::TSTAT_TEMPORARY_FAILURE);
+              m_router.clearBatch(msg->req_id);
               Memory::clear(req);
               tr_list->erase(msg->req_id);
               break;
@@ -889,6 +955,8 @@ namespace Transports
             m_clean_timer.reset();
           }
 
+          m_router.flushSatellite();
+
           if (m_args.iridium_period > 0 && m_iridium_timer.overflow())
           {
             if (m_vmedium != NULL && m_vmedium->medium == IMC::VehicleMedium::VM_WATER)
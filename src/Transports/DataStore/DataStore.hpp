@@ -37,6 +37,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Storage.hpp"
+
 namespace Transports
 {
   namespace DataStore
@@ -80,14 +83,58 @@ namespace Transports
       }
     };
 
-    class CompareSamples
+    //! Size of the fields of a stored sample preceding the message.
+    static const unsigned c_sample_fields_size = 3 * sizeof(double) + sizeof(int32_t);
+
+    //! Serialize a sample (without priority and timestamp, which are
+    //! kept by the storage).
+    void
+    encode(const DataSample* sample, Utils::ByteBuffer& bfr)
     {
-    public:
-      bool operator()(const DataSample* p1, const DataSample* p2) const
+      IMC::Packet::serialize(sample->sample, bfr);
+      unsigned length = bfr.getSize();
+      bfr.setSize(c_sample_fields_size + length);
+
+      uint8_t* ptr = bfr.getBuffer();
+      std::memmove(ptr + c_sample_fields_size, ptr, length);
+      std::memcpy(ptr, &sample->latDegs, sizeof(double));
+      std::memcpy(ptr + 8, &sample->lonDegs, sizeof(double));
+      std::memcpy(ptr + 16, &sample->zMeters, sizeof(double));
+      int32_t source = sample->source;
+      std::memcpy(ptr + 24, &source, sizeof(int32_t));
+    }
+
+    //! Deserialize a stored sample.
+    //! @return sample or NULL if the message cannot be parsed.
+    DataSample*
+    decode(const uint8_t* data, uint32_t length, int priority, double timestamp)
+    {
+      if (length <= c_sample_fields_size)
+        return NULL;
+
+      IMC::Message* msg = NULL;
+      try
       {
-        return p1->priority <= p2->priority && p1->timestamp < p2->timestamp;
+        msg = IMC::Packet::deserialize(data + c_sample_fields_size,
+                                       length - c_sample_fields_size);
+      }
+      catch (std::exception&)
+      {
+        return NULL;
       }
-    };
+
+      DataSample* s = new DataSample();
+      int32_t source;
+      std::memcpy(&s->latDegs, data, sizeof(double));
+      std::memcpy(&s->lonDegs, data + 8, sizeof(double));
+      std::memcpy(&s->zMeters, data + 16, sizeof(double));
+      std::memcpy(&source, data + 24, sizeof(int32_t));
+      s->source = source;
+      s->priority = priority;
+      s->timestamp = timestamp;
+      s->sample = msg;
+      return s;
+    }
 
     //! Translate a (global coordinates) Data Sample into an IMC HistoricSample message
     HistoricSample*
@@ -146,7 +193,8 @@ namespace Transports
       }
     }
 
-    //! This class is used to store samples locally until they are forwarded to other node
+    //! This class is used to store samples locally until they are forwarded to other node.
+    //! Samples are kept in a storage file, so they survive restarts.
     class DataStore
     {
     public:
@@ -156,21 +204,59 @@ namespace Transports
 
       ~DataStore(void)
       {
-        Concurrency::ScopedRWLock(m_lock, true);
-        while (!m_samples.empty())
+        Concurrency::ScopedRWLock l(m_lock, true);
+        m_storage.close();
+      }
+
+      //! Open the storage file.
+      //! @param[in] path storage file.
+      //! @param[in] max_size maximum size of stored samples in bytes.
+      //! @return number of samples recovered from the file.
+      size_t
+      open(const Path& path, uint64_t max_size)
+      {
+        Concurrency::ScopedRWLock l(m_lock, true);
+        m_storage.setMaxSize(max_size);
+        if (!m_storage.isOpen() || m_path != path)
         {
-          delete m_samples.top();
-          m_samples.pop();
+          m_storage.open(path);
+          m_path = path;
         }
+
+        return m_storage.size();
       }
 
-      //! Add sample to this store
+      //! Write pending changes to disk and reclaim the space of
+      //! forwarded samples.
+      void
+      sync(void)
+      {
+        Concurrency::ScopedRWLock l(m_lock, true);
+        m_storage.compact();
+        m_storage.sync();
+      }
+
+      //! Number of stored samples.
+      size_t
+      size(void)
+      {
+        Concurrency::ScopedRWLock l(m_lock, false);
+        return m_storage.size();
+      }
+
+      //! Add sample to this store (the sample is deleted)
       void
       addSample(DataSample* sample)
       {
-        Concurrency::ScopedRWLock(m_lock, true);
+        Utils::ByteBuffer bfr;
+        encode(sample, bfr);
+
+        Concurrency::ScopedRWLock l(m_lock, true);
         m_task->debug("Adding sample %d/%f", sample->sample->getId(), sample->timestamp);
-        m_samples.push(sample);
+        if (!m_storage.add(sample->priority, sample->timestamp, sample->serializationSize(),
+                           bfr.getBuffer(), bfr.getSize()))
+          m_task->debug("Dropping sample %d/%f: storage is full", sample->sample->getId(), sample->timestamp);
+        delete sample;
       }
 
       //! Add a series of historic samples packed as an HistoricData message
@@ -255,38 +341,41 @@ namespace Transports
         size -= BASE_HISTORY_SIZE; // base fields from HistoricData
         IMC::HistoricData* ret = new IMC::HistoricData();
 
-        std::vector<DataSample*> added, rejected;
+        std::vector<DataSample*> added;
 
-        Concurrency::ScopedRWLock(m_lock, true);
-        while (!m_samples.empty() && size > MINIMUM_SAMPLE_SIZE)
         {
-          // pop next sample
-          DataSample* sample = m_samples.top();
-          m_samples.pop();
-
-          // check if there is space left for this sample
-          int sample_size = sample->serializationSize();
-          if (sample_size > size)
+          Concurrency::ScopedRWLock l(m_lock, true);
+          Storage::const_iterator itr = m_storage.begin();
+          while (itr != m_storage.end() && size > MINIMUM_SAMPLE_SIZE)
           {
-            rejected.push_back(sample);
-          }
-          else
-          {
-            size -= sample_size;
-            added.push_back(sample);
-          }
-        }
+            // check if there is space left for this sample
+            int sample_size = itr->cost;
+            if (sample_size > size)
+            {
+              ++itr;
+              continue;
+            }
 
-        // add back samples that didn't fit on the message
-        std::vector<DataSample *>::iterator it;
-        for (it = rejected.begin(); it != rejected.end(); it++)
-        {
-          m_samples.push(*it);
+            DataSample* sample = decode(m_storage.getData(itr), itr->length,
+                                        itr->priority, itr->timestamp);
+            if (sample != NULL)
+            {
+              size -= sample_size;
+              added.push_back(sample);
+            }
+
+            itr = m_storage.remove(itr);
+          }
         }
 
         // no data can be added
         if (added.empty())
+        {
+          delete ret;
           return NULL;
+        }
+
+        std::vector<DataSample *>::iterator it;
 
         ret->base_lat = added.at(0)->latDegs;
         ret->base_lon = added.at(0)->lonDegs;
@@ -304,7 +393,8 @@ namespace Transports
       }
 
     private:
-      std::priority_queue<DataSample *, std::vector<DataSample *> , CompareSamples> m_samples;
+      Storage m_storage;
+      Path m_path;
       std::vector<RemoteCommand* > m_commands;
       Concurrency::RWLock m_lock;
       Task* m_task;
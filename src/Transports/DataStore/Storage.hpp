@@ -0,0 +1,575 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_DATASTORE_STORAGE_HPP_INCLUDED_
+#define TRANSPORTS_DATASTORE_STORAGE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <set>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_STAT_H)
+#  include <sys/stat.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+namespace Transports
+{
+  namespace DataStore
+  {
+    using DUNE_NAMESPACES;
+
+    //! Storage file header.
+    static const char c_file_magic[] = "DUNE-DataStore-1";
+    //! Size of storage file header.
+    static const uint64_t c_file_header_size = 16;
+    //! Record magic.
+    static const uint32_t c_record_magic = 0x52534444;
+    //! Size of record header.
+    static const uint64_t c_record_header_size = 28;
+    //! Minimum storage file growth.
+    static const uint64_t c_growth = 256 * 1024;
+    //! Maximum storage file growth.
+    static const uint64_t c_growth_max = 16 * 1024 * 1024;
+
+    //! Append-only storage file for prioritized records.
+    //!
+    //! Records are appended to a memory mapped file and never moved
+    //! in place. Where memory mapping is not available, the file is
+    //! kept in memory and every change is written through to disk.
+    //! Removing a record clears its 'live' flag; the space of removed
+    //! records is reclaimed by compact(), which rewrites the live
+    //! records to a new file and atomically replaces the old one. An
+    //! in-memory index ordered by priority (highest first) and
+    //! timestamp (newest first) is rebuilt when the file is opened,
+    //! so records survive restarts. A record torn by a crash fails
+    //! its checksum and ends the scan.
+    //!
+    //! The index holds one entry per live record, so its memory grows
+    //! linearly with the number of records (about 64 bytes each with
+    //! the set node). It is bounded through setMaxSize(): every live
+    //! record counts at least its 28 byte header against the limit,
+    //! so the index stays within about 2.5 times the maximum size.
+    //!
+    //! Record layout (host byte order):
+    //!  - magic (4 bytes)
+    //!  - data length (4 bytes)
+    //!  - CRC-16 of the fields below and data (2 bytes)
+    //!  - live flag (1 byte) and padding (1 byte)
+    //!  - priority (4 bytes)
+    //!  - cost (4 bytes)
+    //!  - timestamp (8 bytes)
+    //!  - data
+    class Storage
+    {
+    public:
+      //! Index entry.
+      struct Entry
+      {
+        //! Record priority.
+        int32_t priority;
+        //! Record timestamp.
+        double timestamp;
+        //! Caller defined cost of the record.
+        uint32_t cost;
+        //! Offset of the record in the file.
+        uint64_t offset;
+        //! Size of the record data.
+        uint32_t length;
+
+        bool
+        operator<(const Entry& other) const
+        {
+          if (priority != other.priority)
+            return priority > other.priority;
+          if (timestamp != other.timestamp)
+            return timestamp > other.timestamp;
+          return offset < other.offset;
+        }
+      };
+
+      typedef std::set<Entry> Index;
+      typedef Index::const_iterator const_iterator;
+
+      Storage(void):
+        m_fd(-1),
+        m_file(NULL),
+        m_map(NULL),
+        m_capacity(0),
+        m_tail(0),
+        m_live(0),
+        m_dead(0),
+        m_max_size(0)
+      { }
+
+      ~Storage(void)
+      {
+        close();
+      }
+
+      //! Open (or create) a storage file and index its records.
+      //! @param[in] path file path.
+      //! @return number of records recovered.
+      size_t
+      open(const Path& path)
+      {
+        close();
+        m_path = path;
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_fd < 0)
+          throw System::Error(errno, DTR("unable to open storage file"));
+
+        struct stat st;
+        if (fstat(m_fd, &st) < 0)
+          throw System::Error(errno, DTR("unable to stat storage file"));
+
+        uint64_t file_size = st.st_size;
+        map(std::max(file_size, c_growth));
+#else
+        m_file = std::fopen(path.c_str(), "r+b");
+        if (m_file == NULL)
+          m_file = std::fopen(path.c_str(), "w+b");
+        if (m_file == NULL)
+          throw System::Error(errno, DTR("unable to open storage file"));
+
+        std::fseek(m_file, 0, SEEK_END);
+        long end = std::ftell(m_file);
+        uint64_t file_size = end > 0 ? (uint64_t)end : 0;
+        map(std::max(file_size, c_growth));
+
+        std::rewind(m_file);
+        if (std::fread(m_map, 1, file_size, m_file) != file_size)
+          throw System::Error(errno, DTR("unable to read storage file"));
+#endif
+
+        bool empty = file_size < c_file_header_size;
+        if (empty || std::memcmp(m_map, c_file_magic, c_file_header_size) != 0)
+        {
+          std::memset(m_map, 0, m_capacity);
+          std::memcpy(m_map, c_file_magic, c_file_header_size);
+          persist(0, file_size > c_file_header_size ? file_size : c_file_header_size);
+        }
+
+        scan();
+        return m_index.size();
+      }
+
+      //! Flush and close the storage file.
+      void
+      close(void)
+      {
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+        if (m_map != NULL)
+        {
+          msync(m_map, m_capacity, MS_SYNC);
+          munmap(m_map, m_capacity);
+          m_map = NULL;
+        }
+
+        if (m_fd >= 0)
+        {
+          ::close(m_fd);
+          m_fd = -1;
+        }
+#else
+        if (m_file != NULL)
+        {
+          std::fclose(m_file);
+          m_file = NULL;
+        }
+
+        m_map = NULL;
+        std::vector<uint8_t>().swap(m_buffer);
+#endif
+
+        m_index.clear();
+        m_capacity = 0;
+        m_tail = 0;
+        m_live = 0;
+        m_dead = 0;
+      }
+
+      //! Check if the storage file is open.
+      bool
+      isOpen(void) const
+      {
+        return m_map != NULL;
+      }
+
+      //! Set the maximum number of bytes taken by live records. When
+      //! exceeded, the lowest ranked records are dropped.
+      //! @param[in] size maximum size in bytes (0 for unlimited).
+      void
+      setMaxSize(uint64_t size)
+      {
+        m_max_size = size;
+      }
+
+      //! Append a record.
+      //! @param[in] priority record priority.
+      //! @param[in] timestamp record timestamp.
+      //! @param[in] cost caller defined cost.
+      //! @param[in] data record data.
+      //! @param[in] length size of record data.
+      //! @return true if the record was stored, false if it ranks
+      //! below all stored records and there is no space left.
+      bool
+      add(int32_t priority, double timestamp, uint32_t cost, const uint8_t* data, uint32_t length)
+      {
+        if (!isOpen())
+          return false;
+
+        Entry entry;
+        entry.priority = priority;
+        entry.timestamp = timestamp;
+        entry.cost = cost;
+        entry.offset = m_tail;
+        entry.length = length;
+
+        uint64_t size = c_record_header_size + length;
+        while (m_max_size > 0 && m_live + size > m_max_size)
+        {
+          if (m_index.empty())
+            return false;
+
+          const_iterator last = --m_index.end();
+          if (!(entry < *last))
+            return false;
+
+          remove(last);
+        }
+
+        if (m_tail + size > m_capacity)
+          map(m_capacity + std::max(size, std::min(m_capacity, c_growth_max)));
+
+        uint8_t* rec = m_map + m_tail;
+        std::memcpy(rec + 12, &priority, 4);
+        std::memcpy(rec + 16, &cost, 4);
+        std::memcpy(rec + 20, &timestamp, 8);
+        std::memcpy(rec + c_record_header_size, data, length);
+
+        uint16_t crc = Algorithms::CRC16::compute(rec + 12, c_record_header_size - 12);
+        for (uint32_t done = 0; done < length; done += 0x8000)
+          crc = Algorithms::CRC16::compute(data + done, std::min(length - done, (uint32_t)0x8000), crc);
+
+        std::memcpy(rec + 4, &length, 4);
+        std::memcpy(rec + 8, &crc, 2);
+        rec[10] = 1;
+        rec[11] = 0;
+        // Magic goes last: a record is only valid once complete.
+        std::memcpy(rec, &c_record_magic, 4);
+        persist(m_tail, size);
+
+        m_tail += size;
+        m_live += size;
+        m_index.insert(entry);
+        return true;
+      }
+
+      //! Retrieve the data of a record.
+      //! @param[in] itr index iterator.
+      //! @return pointer to record data (valid until the next
+      //! modification of the storage).
+      const uint8_t*
+      getData(const_iterator itr) const
+      {
+        return m_map + itr->offset + c_record_header_size;
+      }
+
+      //! Remove a record.
+      //! @param[in] itr index iterator.
+      //! @return iterator to the next record.
+      const_iterator
+      remove(const_iterator itr)
+      {
+        uint64_t size = c_record_header_size + itr->length;
+        m_map[itr->offset + 10] = 0;
+        persist(itr->offset + 10, 1);
+        m_live -= size;
+        m_dead += size;
+        m_index.erase(itr++);
+        return itr;
+      }
+
+      //! First (highest ranked) record.
+      const_iterator
+      begin(void) const
+      {
+        return m_index.begin();
+      }
+
+      //! End of records.
+      const_iterator
+      end(void) const
+      {
+        return m_index.end();
+      }
+
+      //! Number of stored records.
+      size_t
+      size(void) const
+      {
+        return m_index.size();
+      }
+
+      //! Bytes taken by live records.
+      uint64_t
+      getLiveBytes(void) const
+      {
+        return m_live;
+      }
+
+      //! Bytes taken by removed records.
+      uint64_t
+      getDeadBytes(void) const
+      {
+        return m_dead;
+      }
+
+      //! Schedule the write of modified pages to disk.
+      //! @param[in] wait wait for completion.
+      void
+      sync(bool wait = false)
+      {
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+        if (m_map != NULL)
+          msync(m_map, m_capacity, wait ? MS_SYNC : MS_ASYNC);
+#else
+        if (m_file == NULL)
+          return;
+
+        std::fflush(m_file);
+#  if defined(DUNE_SYS_HAS_UNISTD_H)
+        if (wait)
+          fsync(fileno(m_file));
+#  else
+        (void)wait;
+#  endif
+#endif
+      }
+
+      //! Reclaim the space of removed records. Invalidates iterators.
+      //! @param[in] force compact even if there is little to reclaim.
+      //! @return true if the file was compacted.
+      bool
+      compact(bool force = false)
+      {
+        if (!isOpen() || m_dead == 0)
+          return false;
+
+        if (!force && (m_dead < c_growth || m_dead < m_live))
+          return false;
+
+        Path tmp = m_path.str() + ".tmp";
+        std::FILE* fd = std::fopen(tmp.c_str(), "wb");
+        if (fd == NULL)
+          return false;
+
+        bool ok = std::fwrite(m_map, c_file_header_size, 1, fd) == 1;
+        for (uint64_t pos = c_file_header_size; ok && pos < m_tail; )
+        {
+          uint32_t length;
+          std::memcpy(&length, m_map + pos + 4, 4);
+          uint64_t size = c_record_header_size + length;
+          if (m_map[pos + 10])
+            ok = std::fwrite(m_map + pos, size, 1, fd) == 1;
+          pos += size;
+        }
+
+        ok = ok && std::fflush(fd) == 0;
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+        ok = ok && fsync(fileno(fd)) == 0;
+#endif
+        ok = (std::fclose(fd) == 0) && ok;
+
+        if (!ok)
+        {
+          std::remove(tmp.c_str());
+          return false;
+        }
+
+        Path path = m_path;
+        close();
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+          std::remove(tmp.c_str());
+        open(path);
+        return true;
+      }
+
+    private:
+      //! File path.
+      Path m_path;
+      //! File descriptor.
+      int m_fd;
+      //! File stream, when memory mapping is not available.
+      std::FILE* m_file;
+      //! In-memory copy of the file, when memory mapping is not
+      //! available.
+      std::vector<uint8_t> m_buffer;
+      //! Mapped file.
+      uint8_t* m_map;
+      //! Mapped size.
+      uint64_t m_capacity;
+      //! Offset where the next record is written.
+      uint64_t m_tail;
+      //! Bytes taken by live records.
+      uint64_t m_live;
+      //! Bytes taken by removed records.
+      uint64_t m_dead;
+      //! Maximum size of live records.
+      uint64_t m_max_size;
+      //! Record index.
+      Index m_index;
+
+      //! Resize the file and map it.
+      //! @param[in] capacity new size.
+      void
+      map(uint64_t capacity)
+      {
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+        capacity = ((capacity + c_growth - 1) / c_growth) * c_growth;
+
+        if (m_map != NULL)
+          munmap(m_map, m_capacity);
+        m_map = NULL;
+
+        if (ftruncate(m_fd, capacity) < 0)
+          throw System::Error(errno, DTR("unable to resize storage file"));
+
+        void* ptr = mmap(0, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (ptr == MAP_FAILED)
+          throw System::Error(errno, DTR("unable to map storage file"));
+
+        m_map = static_cast<uint8_t*>(ptr);
+        m_capacity = capacity;
+#else
+        capacity = ((capacity + c_growth - 1) / c_growth) * c_growth;
+        m_buffer.resize(capacity, 0);
+        m_map = &m_buffer[0];
+        m_capacity = capacity;
+#endif
+      }
+
+      //! Write a modified range of the file image to disk. Mapped
+      //! files need nothing else.
+      //! @param[in] offset start of the range.
+      //! @param[in] size size of the range.
+      void
+      persist(uint64_t offset, uint64_t size)
+      {
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+        (void)offset;
+        (void)size;
+#else
+        if (std::fseek(m_file, (long)offset, SEEK_SET) != 0
+            || std::fwrite(m_map + offset, 1, size, m_file) != size)
+          throw System::Error(errno, DTR("unable to write storage file"));
+#endif
+      }
+
+      //! Index the records of the mapped file.
+      void
+      scan(void)
+      {
+        uint64_t pos = c_file_header_size;
+
+        while (pos + c_record_header_size <= m_capacity)
+        {
+          const uint8_t* rec = m_map + pos;
+          uint32_t magic;
+          Entry entry;
+          uint16_t crc;
+
+          std::memcpy(&magic, rec, 4);
+          std::memcpy(&entry.length, rec + 4, 4);
+          std::memcpy(&crc, rec + 8, 2);
+          std::memcpy(&entry.priority, rec + 12, 4);
+          std::memcpy(&entry.cost, rec + 16, 4);
+          std::memcpy(&entry.timestamp, rec + 20, 8);
+          entry.offset = pos;
+
+          uint64_t size = c_record_header_size + entry.length;
+          if (magic != c_record_magic || pos + size > m_capacity)
+            break;
+
+          uint16_t check = Algorithms::CRC16::compute(rec + 12, c_record_header_size - 12);
+          const uint8_t* data = rec + c_record_header_size;
+          for (uint32_t done = 0; done < entry.length; done += 0x8000)
+            check = Algorithms::CRC16::compute(data + done, std::min(entry.length - done, (uint32_t)0x8000), check);
+
+          if (check != crc)
+            break;
+
+          if (rec[10])
+          {
+            m_index.insert(entry);
+            m_live += size;
+          }
+          else
+          {
+            m_dead += size;
+          }
+
+          pos += size;
+        }
+
+        m_tail = pos;
+
+        // Clear the remains of a torn record.
+        if (m_tail + 4 <= m_capacity && std::memcmp(m_map + m_tail, "\0\0\0\0", 4) != 0)
+        {
+          uint64_t torn = std::min(m_capacity - m_tail, c_record_header_size + 0x20000);
+          std::memset(m_map + m_tail, 0, torn);
+          persist(m_tail, torn);
+        }
+      }
+    };
+
+  }
+}
+
+#endif
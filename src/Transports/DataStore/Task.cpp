@@ -71,6 +71,12 @@ namespace Transports
       //! Variable priorities will result in older
       //! data being sent through low bandwidth connections
       bool variable_priorities;
+
+      //! Storage file, relative to the database folder
+      std::string storage_file;
+
+      //! Maximum size of stored samples in MiB
+      double storage_size;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -156,6 +162,16 @@ namespace Transports
         .description("Apply variable priorities to local samples")
         .defaultValue("true");
 
+        param("Storage File", m_args.storage_file)
+        .description("File, relative to the database folder, where samples are kept until forwarded")
+        .defaultValue("DataStore.dat");
+
+        param("Maximum Storage Size", m_args.storage_size)
+        .units(Units::Mebibyte)
+        .minimumValue("0")
+        .description("Maximum size of stored samples. When exceeded, lowest priority samples are dropped. 0 means unlimited")
+        .defaultValue("256");
+
         m_wifi_forward_timer.setTop(m_args.wifi_forward_period);
         m_acoustic_forward_timer.setTop(m_args.acoustic_forward_period);
         m_any_forward_timer.setTop(m_args.any_forward_period);
@@ -208,6 +224,15 @@ namespace Transports
         m_iridium_upload_timer.setTop(m_args.iridium_upload_period);
       }
 
+      void
+      onResourceAcquisition(void)
+      {
+        size_t count = m_store.open(m_ctx.dir_db / m_args.storage_file,
+                                    (uint64_t)(m_args.storage_size * 1024 * 1024));
+        if (count > 0)
+          inf(DTR("recovered %u samples from storage"), (unsigned)count);
+      }
+
       void
       onResourceInitialization(void)
       {
@@ -488,6 +513,7 @@ namespace Transports
         while (!stopping())
         {
           waitForMessages(1.0);
+          m_store.sync();
 
           std::stringstream ss;
 
@@ -0,0 +1,132 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_FTP_DEFLATER_HPP_INCLUDED_
+#define TRANSPORTS_FTP_DEFLATER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Zlib headers.
+#include <zlib/zlib.h>
+
+namespace Transports
+{
+  namespace FTP
+  {
+    //! Streaming deflate encoder used by transfer mode Z. Data written
+    //! to this object is compressed on the fly and sent to the data
+    //! connection as a single zlib stream.
+    class Deflater
+    {
+    public:
+      //! Constructor.
+      //! @param[in] sock data connection.
+      //! @param[in] level compression level (0-9).
+      Deflater(DUNE::Network::TCPSocket* sock, int level):
+        m_sock(sock)
+      {
+        std::memset(&m_stream, 0, sizeof(m_stream));
+        if (deflateInit(&m_stream, level) != Z_OK)
+          throw std::runtime_error("failed to initialize deflate stream");
+      }
+
+      //! Destructor.
+      ~Deflater(void)
+      {
+        deflateEnd(&m_stream);
+      }
+
+      //! Compress and send data.
+      //! @param[in] data data.
+      //! @param[in] size data size.
+      void
+      write(const char* data, size_t size)
+      {
+        m_stream.next_in = (Bytef*)data;
+        m_stream.avail_in = (uInt)size;
+        pump(Z_NO_FLUSH);
+      }
+
+      //! Terminate the stream and send any pending data.
+      void
+      finish(void)
+      {
+        m_stream.next_in = NULL;
+        m_stream.avail_in = 0;
+        pump(Z_FINISH);
+      }
+
+      //! Send a buffer through a socket, handling short writes.
+      //! @param[in] sock socket.
+      //! @param[in] data data.
+      //! @param[in] size data size.
+      static void
+      writeAll(DUNE::Network::TCPSocket* sock, const char* data, size_t size)
+      {
+        while (size > 0)
+        {
+          size_t rv = sock->write(data, size);
+          data += rv;
+          size -= rv;
+        }
+      }
+
+    private:
+      //! Data connection.
+      DUNE::Network::TCPSocket* m_sock;
+      //! Deflate stream.
+      z_stream m_stream;
+      //! Output buffer.
+      char m_bfr[16384];
+
+      void
+      pump(int flush)
+      {
+        int rv = Z_OK;
+        do
+        {
+          m_stream.next_out = (Bytef*)m_bfr;
+          m_stream.avail_out = sizeof(m_bfr);
+
+          rv = deflate(&m_stream, flush);
+          if (rv == Z_STREAM_ERROR)
+            throw std::runtime_error("deflate stream error");
+
+          writeAll(m_sock, m_bfr, sizeof(m_bfr) - m_stream.avail_out);
+        }
+        while (m_stream.avail_out == 0 || (flush == Z_FINISH && rv != Z_STREAM_END));
+      }
+    };
+  }
+}
+
+#endif
@@ -28,6 +28,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <fstream>
 #include <sstream>
 
 // DUNE headers.
@@ -35,6 +36,7 @@
 
 // Local headers.
 #include "Session.hpp"
+#include "Deflater.hpp"
 
 namespace Transports
 {
@@ -79,14 +81,20 @@ namespace Transports
       "----------"
     };
 
+    //! Size of file blocks compressed in MODE Z.
+    static const size_t c_file_block_size = 65536;
+
     Session::Session(Tasks::Task* task, const FileSystem::Path& root,
-                     TCPSocket* sock, const Address& local_addr, double timeout):
+                     TCPSocket* sock, const Address& local_addr, double timeout,
+                     int compression_level):
       m_task(task),
       m_sock(sock),
       m_local_addr(local_addr),
       m_data_pasv(false),
       m_rest_offset(-1),
-      m_timer(timeout)
+      m_timer(timeout),
+      m_mode_z(false),
+      m_z_level(compression_level)
     {
       m_root = root;
       m_path = "/";
@@ -138,7 +146,7 @@ namespace Transports
     }
 
     void
-    Session::sendFileInfoMLSD(const Path& path, TCPSocket* sock)
+    Session::formatFileInfoMLSD(const Path& path, std::string& out)
     {
       Path::Type type = path.type();
       int64_t size = 0;
@@ -159,11 +167,11 @@ namespace Transports
       }
 
       os << " " << path.basename() << "\r\n";
-      sock->write(os.str().c_str(), os.str().size());
+      out.append(os.str());
     }
 
     void
-    Session::sendFileInfo(const Path& path, TCPSocket* sock, Time::BrokenDown& time_ref)
+    Session::formatFileInfo(const Path& path, std::string& out, Time::BrokenDown& time_ref)
     {
       Path::Type type = path.type();
       int64_t size = 0;
@@ -212,7 +220,64 @@ namespace Transports
                        path_name.c_str());
                        }
 
-      sock->write(m_bfr, strlen(m_bfr));
+      out.append(m_bfr);
+    }
+
+    void
+    Session::sendData(TCPSocket* sock, const std::string& data)
+    {
+      if (m_mode_z)
+      {
+        Deflater z(sock, m_z_level);
+        z.write(data.c_str(), data.size());
+        z.finish();
+      }
+      else
+      {
+        Deflater::writeAll(sock, data.c_str(), data.size());
+      }
+    }
+
+    bool
+    Session::sendFile(TCPSocket* sock, const Path& path, int64_t offset)
+    {
+      if (!m_mode_z)
+        return sock->writeFile(path.c_str(), path.size() - 1, offset);
+
+      try
+      {
+        std::ifstream ifs(path.c_str(), std::ios::binary);
+        if (!ifs)
+          return false;
+
+        if (offset > 0)
+          ifs.seekg(offset, std::ios::beg);
+
+        std::vector<char> bfr(c_file_block_size);
+        Deflater z(sock, m_z_level);
+        while (ifs)
+        {
+          ifs.read(&bfr[0], bfr.size());
+          if (ifs.gcount() > 0)
+            z.write(&bfr[0], ifs.gcount());
+        }
+
+        // A read error must not end the stream as if it were complete.
+        if (ifs.bad())
+        {
+          m_task->debug("compressed transfer of %s failed: read error", path.c_str());
+          return false;
+        }
+
+        z.finish();
+      }
+      catch (std::exception& e)
+      {
+        m_task->debug("compressed transfer of %s failed: %s", path.c_str(), e.what());
+        return false;
+      }
+
+      return true;
     }
 
     void
@@ -288,11 +353,12 @@ namespace Transports
 
       sendReply(150, "File status okay; about to open data connection.");
 
+      // Build the whole listing before sending it in one go.
       Time::BrokenDown time_ref;
-      TCPSocket* data = openDataConnection();
+      std::string listing;
       if (type == Path::PT_FILE)
       {
-        sendFileInfo(path, data, time_ref);
+        formatFileInfo(path, listing, time_ref);
       }
       else
       {
@@ -300,10 +366,12 @@ namespace Transports
         const char* entry = NULL;
         while ((entry = dir.readEntry(Directory::RD_FULL_NAME)))
         {
-          sendFileInfo(entry, data, time_ref);
+          formatFileInfo(entry, listing, time_ref);
         }
       }
 
+      TCPSocket* data = openDataConnection();
+      sendData(data, listing);
       closeDataConnection(data);
     }
 
@@ -336,7 +404,7 @@ namespace Transports
 
       if (path.isFile())
       {
-        sendReply(212, String::str("%llu", path.size()));
+        sendReply(213, String::str("%llu", path.size()));
       }
       else
       {
@@ -357,23 +425,40 @@ namespace Transports
         return;
       }
 
+      // Restarting past the end means the client's copy is stale.
+      if (rest_offset > path.size())
+      {
+        sendReply(554, "Requested action not taken: invalid REST parameter.");
+        return;
+      }
+
       sendReply(150, "File status okay; about to open data connection.");
 
       TCPSocket* data = openDataConnection();
 
-      if (!data->writeFile(path.c_str(), path.size() - 1, rest_offset))
+      if (!sendFile(data, path, rest_offset))
+      {
+        delete data;
+        sendReply(426, "Connection closed; transfer aborted.");
         return;
+      }
 
       closeDataConnection(data);
-      m_rest_offset = 0;
     }
 
     void
     Session::handleREST(const std::string& arg)
     {
       std::istringstream is(arg);
-      is >> m_rest_offset;
+      int64_t offset = -1;
+      if (!(is >> offset) || offset < 0)
+      {
+        m_rest_offset = -1;
+        sendReply(501, "Syntax error in parameters or arguments.");
+        return;
+      }
 
+      m_rest_offset = offset;
       sendReply(350, "Requested file action pending further information.");
     }
 
@@ -441,9 +526,79 @@ namespace Transports
     Session::handleMODE(const std::string& arg)
     {
       if (arg == "S")
+      {
+        m_mode_z = false;
+        sendOK();
+      }
+      else if (arg == "Z")
+      {
+        m_mode_z = true;
         sendOK();
+      }
       else
+      {
         sendReply(504, "Command not implemented for that parameter.");
+      }
+    }
+
+    void
+    Session::handleMDTM(const std::string& arg)
+    {
+      Path path = getAbsolutePath(arg);
+
+      if (!path.isFile())
+      {
+        sendReply(550, "Could not get file modification time.");
+        return;
+      }
+
+      Time::BrokenDown bdt(path.getLastModifiedTime());
+      sendReply(213, String::str("%04u%02u%02u%02u%02u%02u",
+                                 bdt.year, bdt.month, bdt.day,
+                                 bdt.hour, bdt.minutes, bdt.seconds));
+    }
+
+    void
+    Session::handleFEAT(const std::string& arg)
+    {
+      (void)arg;
+
+      static const char* c_features =
+        "211-Features:\r\n"
+        " MDTM\r\n"
+        " MLSD\r\n"
+        " MODE Z\r\n"
+        " REST STREAM\r\n"
+        " SIZE\r\n"
+        "211 End\r\n";
+
+      m_sock->write(c_features, std::strlen(c_features));
+    }
+
+    void
+    Session::handleOPTS(const std::string& arg)
+    {
+      unsigned level = 0;
+
+      if (std::sscanf(arg.c_str(), "MODE Z LEVEL %u", &level) == 1)
+      {
+        if (level > 9)
+        {
+          sendReply(501, "Invalid compression level.");
+          return;
+        }
+
+        m_z_level = (int)level;
+        sendOK();
+      }
+      else if (String::startsWith(arg, "UTF8"))
+      {
+        sendOK();
+      }
+      else
+      {
+        sendReply(501, "Option not understood.");
+      }
     }
 
     void
@@ -485,11 +640,10 @@ namespace Transports
 
       sendReply(150, "File status okay; about to open data connection.");
 
-      Time::BrokenDown time_ref;
-      TCPSocket* data = openDataConnection();
+      std::string listing;
       if (type == Path::PT_FILE)
       {
-        sendFileInfoMLSD(path, data);
+        formatFileInfoMLSD(path, listing);
       }
       else
       {
@@ -497,10 +651,12 @@ namespace Transports
         const char* entry = NULL;
         while ((entry = dir.readEntry(Directory::RD_FULL_NAME)))
         {
-          sendFileInfoMLSD(entry, data);
+          formatFileInfoMLSD(entry, listing);
         }
       }
 
+      TCPSocket* data = openDataConnection();
+      sendData(data, listing);
       closeDataConnection(data);
     }
 
@@ -575,6 +731,12 @@ namespace Transports
         handleTYPE(arg);
       else if (cmd == "MODE")
         handleMODE(arg);
+      else if (cmd == "MDTM")
+        handleMDTM(arg);
+      else if (cmd == "FEAT")
+        handleFEAT(arg);
+      else if (cmd == "OPTS")
+        handleOPTS(arg);
       else if (cmd == "SIZE")
         handleSIZE(arg);
       else if (cmd == "RETR")
@@ -51,7 +51,8 @@ namespace Transports
               const DUNE::FileSystem::Path& root,
               DUNE::Network::TCPSocket* sock,
               const DUNE::Network::Address& local_addr,
-              double timeout);
+              double timeout,
+              int compression_level);
 
       ~Session(void);
 
@@ -82,6 +83,10 @@ namespace Transports
       int64_t m_rest_offset;
       //! Idle timer.
       DUNE::Time::Counter<double> m_timer;
+      //! True if data transfers are deflate compressed (MODE Z).
+      bool m_mode_z;
+      //! Compression level used in MODE Z.
+      int m_z_level;
 
       DUNE::FileSystem::Path
       getAbsolutePath(const std::string& path);
@@ -93,10 +98,16 @@ namespace Transports
       sendOK(void);
 
       void
-      sendFileInfo(const DUNE::FileSystem::Path& path, DUNE::Network::TCPSocket* sock, DUNE::Time::BrokenDown& time_ref);
+      formatFileInfo(const DUNE::FileSystem::Path& path, std::string& out, DUNE::Time::BrokenDown& time_ref);
 
       void
-      sendFileInfoMLSD(const DUNE::FileSystem::Path& path, DUNE::Network::TCPSocket* sock);
+      formatFileInfoMLSD(const DUNE::FileSystem::Path& path, std::string& out);
+
+      void
+      sendData(DUNE::Network::TCPSocket* sock, const std::string& data);
+
+      bool
+      sendFile(DUNE::Network::TCPSocket* sock, const DUNE::FileSystem::Path& path, int64_t offset);
 
       void
       closeControlConnection(void);
@@ -146,6 +157,15 @@ namespace Transports
       void
       handleMODE(const std::string& arg);
 
+      void
+      handleMDTM(const std::string& arg);
+
+      void
+      handleFEAT(const std::string& arg);
+
+      void
+      handleOPTS(const std::string& arg);
+
       void
       handleDELE(const std::string& arg);
 
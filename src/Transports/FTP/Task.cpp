@@ -53,6 +53,8 @@ namespace Transports
       uint16_t control_port;
       //! Session timeout.
       double session_tout;
+      //! Default compression level of MODE Z transfers.
+      int compression_level;
     };
 
     struct Task: public Tasks::Task
@@ -85,6 +87,13 @@ namespace Transports
         .units(Units::Second)
         .defaultValue("120")
         .description("Timeout period of a session");
+
+        param("Compression Level", m_args.compression_level)
+        .defaultValue("6")
+        .minimumValue("0")
+        .maximumValue("9")
+        .description("Default deflate level of compressed (MODE Z) transfers."
+                     " Clients can change it with OPTS MODE Z LEVEL");
       }
 
       ~Task(void)
@@ -180,7 +189,7 @@ namespace Transports
 
           debug("accepted connection from '%s'", addr.c_str());
           Session* handler = new Session(this, m_ctx.dir_log, client, local_addr,
-                                         m_args.session_tout);
+                                         m_args.session_tout, m_args.compression_level);
           handler->start();
           m_busy_list.push_back(handler);
         }
@@ -29,7 +29,7 @@
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
-#include <DUNE/Network/FragmentedMessage.hpp>
+#include <DUNE/Network/FragmentReassembler.hpp>
 
 namespace Transports
 {
@@ -41,11 +41,30 @@ namespace Transports
     {
       // Reception timeout.
       float max_age_secs;
+      // Maximum memory used by incomplete messages, in KiB.
+      unsigned max_memory;
+      // Request missing fragments.
+      bool nack;
+      // Time without new fragments before requesting missing ones.
+      float nack_delay;
+    };
+
+    //! Fragments of a locally originated message, kept to answer
+    //! requests for missing fragments.
+    struct Outgoing
+    {
+      //! Fragments by number.
+      std::map<uint8_t, IMC::MessagePart> parts;
+      //! Time of the last fragment.
+      double time;
     };
 
     struct Task: public DUNE::Tasks::Task
     {
-      std::map<uint32_t, FragmentedMessage> m_incoming;
+      //! Reassembly engine.
+      FragmentReassembler m_reassembler;
+      //! Fragments of locally originated messages, by identifier.
+      std::map<uint8_t, Outgoing> m_outgoing;
       Time::Counter<float> m_gc_counter;
       Arguments m_args;
 
@@ -54,39 +73,125 @@ namespace Transports
       {
         param("Reception timeout", m_args.max_age_secs)
         .defaultValue("1800")
+        .units(Units::Second)
         .description("Maximum amount of seconds to wait for missing fragments in incoming messages");
 
+        param("Maximum Reassembly Memory", m_args.max_memory)
+        .defaultValue("1024")
+        .units(Units::Kibibyte)
+        .description("Maximum amount of memory held by incomplete messages;"
+                     " the oldest ones are dropped first");
+
+        param("Request Missing Fragments", m_args.nack)
+        .defaultValue("false")
+        .description("Send negative acknowledgements listing the missing"
+                     " fragments of incomplete messages and retransmit"
+                     " local fragments requested by peers");
+
+        param("Missing Fragments Delay", m_args.nack_delay)
+        .defaultValue("60")
+        .units(Units::Second)
+        .description("Amount of time without new fragments before missing"
+                     " fragments are requested");
+
         bind<IMC::MessagePart>(this);
         m_gc_counter.setTop(120);
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_reassembler.setMaxAge(m_args.max_age_secs);
+        m_reassembler.setMaxMemory(m_args.max_memory * 1024);
+      }
+
       void
       onResourceRelease(void)
       {
-        m_incoming.clear();
+        m_reassembler.clear();
+        m_outgoing.clear();
       }
 
       void
       consume(const IMC::MessagePart* msg)
       {
-        int hash = (msg->uid << 16) | msg->getSource();
+        FragmentReassembler::Nack nack;
+        if (FragmentReassembler::parseNack(msg, nack))
+        {
+          if (nack.src == getSystemId())
+            retransmit(nack);
+          return;
+        }
 
-        if (m_incoming.find(hash) == m_incoming.end())
+        // Keep local fragments for retransmission.
+        if (msg->getSource() == getSystemId())
         {
-          FragmentedMessage incMsg;
-          incMsg.setParentTask(this);
-          m_incoming[hash] = incMsg;
+          if (m_args.nack)
+          {
+            Outgoing& out = m_outgoing[msg->uid];
+            if (!out.parts.empty() && out.parts.begin()->second.num_frags != msg->num_frags)
+              out.parts.clear();
+            out.parts[msg->frag_number] = *msg;
+            out.time = Clock::get();
+          }
+          return;
         }
 
+        IMC::Message* res = m_reassembler.add(msg, Clock::get());
+
         debug("Incoming message fragment (%d still missing)",
-              m_incoming[hash].getFragmentsMissing());
+              m_reassembler.getFragmentsMissing(msg->getSource(), msg->uid));
 
-        IMC::Message * res = m_incoming[hash].setFragment(msg);
         if (res != NULL)
         {
           dispatch(res);
-          m_incoming.erase(hash);
+          delete res;
+        }
+      }
+
+      //! Dispatch again the requested fragments of a local message.
+      void
+      retransmit(const FragmentReassembler::Nack& nack)
+      {
+        std::map<uint8_t, Outgoing>::iterator itr = m_outgoing.find(nack.uid);
+        if (itr == m_outgoing.end())
+        {
+          debug("missing fragments requested for unknown message %u", nack.uid);
+          return;
+        }
+
+        unsigned count = 0;
+        for (size_t i = 0; i < nack.missing.size(); ++i)
+        {
+          std::map<uint8_t, IMC::MessagePart>::iterator p = itr->second.parts.find(nack.missing[i]);
+          if (p == itr->second.parts.end())
+            continue;
+
+          dispatch(p->second, DF_KEEP_TIME);
+          ++count;
+        }
+
+        itr->second.time = Clock::get();
+        debug("retransmitted %u of %u requested fragments of message %u",
+              count, (unsigned)nack.missing.size(), nack.uid);
+      }
+
+      void
+      requestMissing(void)
+      {
+        std::vector<FragmentReassembler::Nack> nacks;
+        m_reassembler.getNacks(Clock::get(), m_args.nack_delay, nacks);
+
+        for (size_t i = 0; i < nacks.size(); ++i)
+        {
+          debug("requesting %u missing fragments of message %u from %s",
+                (unsigned)nacks[i].missing.size(), nacks[i].uid,
+                resolveSystemId(nacks[i].src));
+
+          IMC::MessagePart* part = FragmentReassembler::createNack(nacks[i]);
+          dispatch(part);
+          delete part;
         }
       }
 
@@ -95,22 +200,31 @@ namespace Transports
       {
         debug("ripping old messages");
 
-        std::map<uint32_t, FragmentedMessage>::iterator it = m_incoming.begin();
-        std::vector<uint32_t> remove;
-        for ( ; it != m_incoming.end(); ++it)
+        unsigned count = m_reassembler.expire(Clock::get());
+        if (count > 0)
         {
-          if (it->second.getAge() > m_args.max_age_secs)
-          {
-            remove.push_back(it->first);
+          // message has died of natural causes...
+          war(DTR("Removed %u incomplete incoming messages from memory."), count);
+        }
 
-            // message has died of natural causes...
-            war(DTR("Removed incoming message from memory (%d fragments were still missing)."),
-                it->second.getFragmentsMissing());
-          }
+        double now = Clock::get();
+        std::map<uint8_t, Outgoing>::iterator itr = m_outgoing.begin();
+        while (itr != m_outgoing.end())
+        {
+          if (now - itr->second.time > m_args.max_age_secs)
+            m_outgoing.erase(itr++);
+          else
+            ++itr;
         }
 
-        for (size_t i = 0; i < remove.size(); ++i)
-          m_incoming.erase(remove[i]);
+        const FragmentReassembler::Statistics& stats = m_reassembler.getStatistics();
+        debug("fragments: %llu accepted, %llu duplicate, %llu invalid; messages:"
+              " %llu completed, %llu expired, %llu evicted; %llu NACKs, %u KiB in use",
+              (unsigned long long)stats.fragments, (unsigned long long)stats.duplicates,
+              (unsigned long long)stats.invalid, (unsigned long long)stats.completed,
+              (unsigned long long)stats.expired, (unsigned long long)stats.evicted,
+              (unsigned long long)stats.nacks,
+              (unsigned)(m_reassembler.getMemoryUsage() / 1024));
       }
 
       void
@@ -120,6 +234,9 @@ namespace Transports
         {
           waitForMessages(1.0);
 
+          if (m_args.nack)
+            requestMissing();
+
           if (m_gc_counter.overflow())
           {
             messageRipper();
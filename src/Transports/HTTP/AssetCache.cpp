@@ -0,0 +1,269 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "AssetCache.hpp"
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Files larger than this fraction of the capacity are not cached.
+    static const size_t c_max_asset_fraction = 4;
+
+    AssetCache::AssetCache(size_t capacity, double check_period):
+      m_size(0),
+      m_capacity(capacity),
+      m_check_period(check_period),
+      m_uses(0)
+    { }
+
+    AssetCache::~AssetCache(void)
+    {
+      for (AssetMap::iterator itr = m_assets.begin(); itr != m_assets.end(); ++itr)
+        delete itr->second;
+    }
+
+    void
+    AssetCache::setCapacity(size_t capacity)
+    {
+      ScopedMutex l(m_mutex);
+      m_capacity = capacity;
+      evict(0);
+    }
+
+    std::string
+    AssetCache::getContentType(const Path& file)
+    {
+      std::string ext = file.extension();
+      String::toLowerCase(ext);
+
+      if (ext == "html" || ext == "htm")
+        return "text/html";
+      if (ext == "css")
+        return "text/css";
+      if (ext == "js")
+        return "text/javascript";
+      if (ext == "json")
+        return "application/json";
+      if (ext == "txt")
+        return "text/plain";
+      if (ext == "xml")
+        return "application/xml";
+      if (ext == "svg")
+        return "image/svg+xml";
+      if (ext == "png")
+        return "image/png";
+      if (ext == "jpg" || ext == "jpeg")
+        return "image/jpeg";
+      if (ext == "gif")
+        return "image/gif";
+      if (ext == "ico")
+        return "image/x-icon";
+
+      return "";
+    }
+
+    bool
+    AssetCache::isCompressible(const std::string& type)
+    {
+      return (type.compare(0, 5, "text/") == 0)
+      || (type == "application/json")
+      || (type == "application/xml")
+      || (type == "image/svg+xml");
+    }
+
+    bool
+    AssetCache::readFile(const Path& file, std::string& data)
+    {
+      std::ifstream ifs(file.c_str(), std::ios::binary);
+      if (!ifs)
+        return false;
+
+      std::ostringstream os;
+      os << ifs.rdbuf();
+      data = os.str();
+      return !ifs.bad();
+    }
+
+    AssetCache::Asset*
+    AssetCache::load(const Path& file)
+    {
+      Asset* a = new Asset;
+      a->mtime = file.getLastModifiedTime();
+      a->size = file.size();
+      a->type = getContentType(file);
+      a->checked = Clock::get();
+      a->used = 0;
+
+      if (!readFile(file, a->data) || (int64_t)a->data.size() != a->size)
+      {
+        delete a;
+        return NULL;
+      }
+
+      uint8_t digest[16];
+      MD5::compute((const uint8_t*)a->data.data(), a->data.size(), digest);
+      std::ostringstream os;
+      os << '"' << std::hex << std::setfill('0');
+      for (unsigned i = 0; i < 8; ++i)
+        os << std::setw(2) << (unsigned)digest[i];
+      os << '"';
+      a->etag = os.str();
+
+      if (!isCompressible(a->type))
+        return a;
+
+      // Prefer a precompressed variant, if it is up to date.
+      Path gz = file.str() + ".gz";
+      if (gz.isFile() && gz.getLastModifiedTime() >= a->mtime)
+      {
+        if (readFile(gz, a->gzip))
+          return a;
+        a->gzip.clear();
+      }
+
+      ByteBuffer bfr;
+      GzipCompressor cmp(9);
+      cmp.compress(bfr, (char*)a->data.data(), (unsigned long)a->data.size());
+
+      // Only keep the compressed variant if it pays off.
+      if (bfr.getSize() < a->data.size())
+        a->gzip.assign(bfr.getBufferSigned(), bfr.getSize());
+
+      return a;
+    }
+
+    void
+    AssetCache::getRepresentation(const Asset* a, bool accept_gzip, Representation& rep)
+    {
+      rep.gzip = accept_gzip && !a->gzip.empty();
+      rep.data = rep.gzip ? a->gzip : a->data;
+      rep.etag = a->etag;
+      rep.type = a->type;
+
+      // Entity tags must differ between content encodings.
+      if (rep.gzip)
+        rep.etag.insert(rep.etag.size() - 1, "-gz");
+    }
+
+    void
+    AssetCache::erase(AssetMap::iterator itr)
+    {
+      m_size -= itr->second->data.size() + itr->second->gzip.size();
+      delete itr->second;
+      m_assets.erase(itr);
+    }
+
+    void
+    AssetCache::evict(size_t needed)
+    {
+      // Remove least recently used assets.
+      while (!m_assets.empty() && (m_size + needed > m_capacity))
+      {
+        AssetMap::iterator lru = m_assets.begin();
+        for (AssetMap::iterator itr = m_assets.begin(); itr != m_assets.end(); ++itr)
+        {
+          if (itr->second->used < lru->second->used)
+            lru = itr;
+        }
+
+        erase(lru);
+      }
+    }
+
+    bool
+    AssetCache::get(const Path& file, bool accept_gzip, Representation& rep)
+    {
+      double now = Clock::get();
+
+      {
+        ScopedMutex l(m_mutex);
+
+        if (m_capacity == 0)
+          return false;
+
+        AssetMap::iterator itr = m_assets.find(file.str());
+        if (itr != m_assets.end())
+        {
+          Asset* a = itr->second;
+
+          bool stale = false;
+          if (now - a->checked >= m_check_period)
+          {
+            a->checked = now;
+            stale = (file.getLastModifiedTime() != a->mtime) || (file.size() != a->size);
+          }
+
+          if (!stale)
+          {
+            a->used = ++m_uses;
+            getRepresentation(a, accept_gzip, rep);
+            return true;
+          }
+
+          erase(itr);
+        }
+
+        int64_t size = file.size();
+        if (size < 0 || !file.isFile() || (size_t)size > m_capacity / c_max_asset_fraction)
+          return false;
+      }
+
+      // Load without holding the lock.
+      Asset* a = load(file);
+      if (a == NULL)
+        return false;
+
+      ScopedMutex l(m_mutex);
+
+      AssetMap::iterator itr = m_assets.find(file.str());
+      if (itr != m_assets.end())
+        erase(itr);
+
+      size_t bytes = a->data.size() + a->gzip.size();
+      evict(bytes);
+
+      a->used = ++m_uses;
+      m_assets[file.str()] = a;
+      m_size += bytes;
+
+      getRepresentation(a, accept_gzip, rep);
+      return true;
+    }
+  }
+}
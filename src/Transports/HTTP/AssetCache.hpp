@@ -0,0 +1,152 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_HTTP_ASSET_CACHE_HPP_INCLUDED_
+#define TRANSPORTS_HTTP_ASSET_CACHE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <ctime>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    //! In-memory cache of static files. Files are kept along with
+    //! their gzip variant and an entity tag, and are reloaded when
+    //! they change on disk.
+    class AssetCache
+    {
+    public:
+      //! Representation of a cached file.
+      struct Representation
+      {
+        //! Contents.
+        std::string data;
+        //! Strong entity tag, including quotes.
+        std::string etag;
+        //! MIME type.
+        std::string type;
+        //! True if contents are gzip compressed.
+        bool gzip;
+      };
+
+      //! Constructor.
+      //! @param capacity maximum number of bytes kept in memory.
+      //! @param check_period minimum time in seconds between checks
+      //! for modifications of a cached file.
+      AssetCache(size_t capacity = 0, double check_period = 1.0);
+
+      //! Destructor.
+      ~AssetCache(void);
+
+      //! Change the maximum number of bytes kept in memory. A value
+      //! of zero disables the cache.
+      //! @param capacity capacity in bytes.
+      void
+      setCapacity(size_t capacity);
+
+      //! Retrieve a representation of a file.
+      //! @param file file path.
+      //! @param accept_gzip true if the client accepts gzip content.
+      //! @param rep output representation.
+      //! @return true if the file is cached, false if it does not
+      //! exist or cannot be cached.
+      bool
+      get(const DUNE::FileSystem::Path& file, bool accept_gzip, Representation& rep);
+
+      //! Retrieve the MIME type of a file.
+      //! @param file file path.
+      //! @return MIME type, or an empty string if not known.
+      static std::string
+      getContentType(const DUNE::FileSystem::Path& file);
+
+    private:
+      //! Cached file.
+      struct Asset
+      {
+        //! Contents.
+        std::string data;
+        //! Compressed contents, empty if not worth it.
+        std::string gzip;
+        //! Entity tag of the contents.
+        std::string etag;
+        //! MIME type.
+        std::string type;
+        //! Modification time of the file.
+        std::time_t mtime;
+        //! Size of the file.
+        int64_t size;
+        //! Time of the last check for modifications.
+        double checked;
+        //! Sequence number of the last use.
+        uint64_t used;
+      };
+
+      //! Cached files by path.
+      typedef std::map<std::string, Asset*> AssetMap;
+
+      //! Cached files.
+      AssetMap m_assets;
+      //! Bytes kept in memory.
+      size_t m_size;
+      //! Maximum number of bytes kept in memory.
+      size_t m_capacity;
+      //! Minimum time between checks for modifications.
+      double m_check_period;
+      //! Use sequence number.
+      uint64_t m_uses;
+      //! Lock protecting the cache.
+      DUNE::Concurrency::Mutex m_mutex;
+
+      static Asset*
+      load(const DUNE::FileSystem::Path& file);
+
+      static bool
+      readFile(const DUNE::FileSystem::Path& file, std::string& data);
+
+      static bool
+      isCompressible(const std::string& type);
+
+      static void
+      getRepresentation(const Asset* a, bool accept_gzip, Representation& rep);
+
+      void
+      erase(AssetMap::iterator itr);
+
+      void
+      evict(size_t needed);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,271 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <sstream>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "EventStream.hpp"
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Maximum time a single transmission may block.
+    static const double c_send_timeout = 0.02;
+    //! Time without accepting data after which a client is dropped.
+    static const double c_stall_timeout = 5.0;
+    //! Maximum amount of queued data per client.
+    static const size_t c_max_queue = 256 * 1024;
+    //! Response header.
+    static const char c_header[] = "HTTP/1.1 200 OK\r\n"
+    "Server: DUNE/" DUNE_VERSION_STR "\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "retry: 1000\n\n";
+
+    EventStream::EventStream(double ping_period):
+      m_ping_period(ping_period)
+    {
+      start();
+    }
+
+    EventStream::~EventStream(void)
+    {
+      stop();
+      m_cond.lock();
+      m_cond.signal();
+      m_cond.unlock();
+      join();
+
+      for (std::list<Client>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+        delete itr->sock;
+    }
+
+    //! Send as much data as the client accepts without blocking for
+    //! longer than the send timeout.
+    //! @return number of bytes sent, or -1 if the connection is closed.
+    int
+    EventStream::send(TCPSocket* sock, const std::string& data)
+    {
+      try
+      {
+        return (int)sock->write(data.c_str(), data.size());
+      }
+      catch (ConnectionClosed&)
+      {
+        return -1;
+      }
+      catch (std::exception&)
+      {
+        // Send timeout without any data accepted.
+        return 0;
+      }
+    }
+
+    void
+    EventStream::queue(Client& client, const std::string& data, double now)
+    {
+      if (client.closed)
+        return;
+
+      if (client.queue.size() + data.size() > c_max_queue)
+      {
+        client.queue.clear();
+        client.closed = true;
+        return;
+      }
+
+      if (client.queue.empty())
+        client.last_progress = now;
+
+      client.queue += data;
+      client.last_queued = now;
+    }
+
+    void
+    EventStream::add(TCPSocket* sock, const std::set<uint32_t>& ids)
+    {
+      try
+      {
+        sock->setSendTimeout(c_send_timeout);
+      }
+      catch (std::exception&)
+      { }
+
+      Client c;
+      c.sock = sock;
+      c.ids = ids;
+      c.queue = c_header;
+      c.last_queued = Clock::get();
+      c.last_progress = c.last_queued;
+      c.closed = false;
+
+      m_cond.lock();
+      m_clients.push_back(c);
+      m_cond.signal();
+      m_cond.unlock();
+    }
+
+    void
+    EventStream::publish(const IMC::Message* msg)
+    {
+      ScopedCondition l(m_cond);
+
+      // Serialized on demand, at most once.
+      std::string event;
+      double now = Clock::get();
+
+      for (std::list<Client>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+      {
+        if (!itr->ids.empty() && itr->ids.find(msg->getId()) == itr->ids.end())
+          continue;
+
+        if (event.empty())
+        {
+          std::ostringstream os;
+          msg->toJSON(os);
+
+          // Event data must not span lines.
+          std::string data = os.str();
+          std::replace(data.begin(), data.end(), '\n', ' ');
+          event = "event: " + std::string(msg->getName()) + "\ndata: " + data + "\n\n";
+        }
+
+        queue(*itr, event, now);
+      }
+
+      if (!event.empty())
+        m_cond.signal();
+    }
+
+    void
+    EventStream::ping(void)
+    {
+      ScopedCondition l(m_cond);
+
+      double now = Clock::get();
+
+      for (std::list<Client>::iterator itr = m_clients.begin(); itr != m_clients.end(); ++itr)
+      {
+        if (itr->queue.empty() && now - itr->last_queued >= m_ping_period)
+          queue(*itr, ":\n\n", now);
+      }
+
+      m_cond.signal();
+    }
+
+    size_t
+    EventStream::size(void)
+    {
+      ScopedCondition l(m_cond);
+      return m_clients.size();
+    }
+
+    void
+    EventStream::run(void)
+    {
+      std::string data;
+
+      m_cond.lock();
+
+      while (!isStopping())
+      {
+        bool idle = true;
+        bool pending = false;
+
+        // Only this thread removes clients, so iterators remain
+        // valid while the lock is released.
+        std::list<Client>::iterator itr = m_clients.begin();
+        while (itr != m_clients.end())
+        {
+          if (itr->closed)
+          {
+            delete itr->sock;
+            itr = m_clients.erase(itr);
+            continue;
+          }
+
+          if (!itr->queue.empty())
+          {
+            data.swap(itr->queue);
+
+            m_cond.unlock();
+            int rv = send(itr->sock, data);
+            m_cond.lock();
+
+            double now = Clock::get();
+
+            if (rv < 0)
+            {
+              itr->closed = true;
+            }
+            else
+            {
+              // Keep what was not sent ahead of newly queued data.
+              itr->queue.insert(0, data, rv, std::string::npos);
+
+              if (rv > 0)
+              {
+                idle = false;
+                itr->last_progress = now;
+              }
+
+              if (!itr->queue.empty())
+              {
+                pending = true;
+                if (now - itr->last_progress > c_stall_timeout)
+                {
+                  itr->queue.clear();
+                  itr->closed = true;
+                }
+              }
+            }
+
+            data.clear();
+          }
+
+          ++itr;
+        }
+
+        // Clients that are not accepting data are retried shortly.
+        if (idle)
+          m_cond.wait(pending ? c_send_timeout : 1.0);
+      }
+
+      m_cond.unlock();
+    }
+  }
+}
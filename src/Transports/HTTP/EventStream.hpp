@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_HTTP_EVENT_STREAM_HPP_INCLUDED_
+#define TRANSPORTS_HTTP_EVENT_STREAM_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <list>
+#include <set>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    //! Server-sent events stream. Connections handed to this class
+    //! receive selected messages, in JSON, as soon as they are
+    //! published. Events are queued per client and written by a
+    //! dedicated thread, so slow clients never block publishers.
+    class EventStream: public DUNE::Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param ping_period period in seconds of the comments sent to
+      //! idle connections to detect closed clients.
+      EventStream(double ping_period = 15.0);
+
+      //! Destructor.
+      ~EventStream(void);
+
+      //! Add a client connection, taking its ownership. The response
+      //! header is queued immediately.
+      //! @param sock connection socket.
+      //! @param ids identification numbers of the messages to
+      //! stream, or an empty set to stream all messages.
+      void
+      add(DUNE::Network::TCPSocket* sock, const std::set<uint32_t>& ids);
+
+      //! Queue a message for all interested clients. Clients that
+      //! cannot keep up are disconnected.
+      //! @param msg message.
+      void
+      publish(const DUNE::IMC::Message* msg);
+
+      //! Queue a comment for the clients that have been idle for more
+      //! than the ping period, to detect closed clients.
+      void
+      ping(void);
+
+      //! Retrieve the number of connected clients.
+      //! @return number of clients.
+      size_t
+      size(void);
+
+    private:
+      //! Stream client.
+      struct Client
+      {
+        //! Connection socket.
+        DUNE::Network::TCPSocket* sock;
+        //! Messages to stream, all if empty.
+        std::set<uint32_t> ids;
+        //! Data waiting to be written.
+        std::string queue;
+        //! Time of the last queued data.
+        double last_queued;
+        //! Time at which the client last accepted data or, if it was
+        //! idle, the time its queue stopped being empty.
+        double last_progress;
+        //! True if the client must be disconnected.
+        bool closed;
+      };
+
+      //! Connected clients.
+      std::list<Client> m_clients;
+      //! Condition protecting m_clients and signaling queued data.
+      DUNE::Concurrency::Condition m_cond;
+      //! Ping period.
+      double m_ping_period;
+
+      void
+      queue(Client& client, const std::string& data, double now);
+
+      void
+      run(void);
+
+      static int
+      send(DUNE::Network::TCPSocket* sock, const std::string& data);
+    };
+  }
+}
+
+#endif
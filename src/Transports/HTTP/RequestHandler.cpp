@@ -34,6 +34,7 @@
 #include <utility>
 
 // DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/FileSystem/Path.hpp>
 #include <DUNE/Utils/TupleList.hpp>
 #include <DUNE/Network/Exceptions.hpp>
@@ -45,15 +46,16 @@
 #include "RequestHandler.hpp"
 
 #define SERVER_VERSION "Server: DUNE/" DUNE_VERSION_STR "\r\n"
-#define STATUS_LINE_100 "HTTP/1.0 100 Continue\r\n"
-#define STATUS_LINE_200 "HTTP/1.0 200 OK\r\n"
-#define STATUS_LINE_201 "HTTP/1.0 201 Created\r\n"
-#define STATUS_LINE_206 "HTTP/1.0 206 Partial Content\r\n"
-#define STATUS_LINE_403 "HTTP/1.0 403 Forbidden\r\n"
-#define STATUS_LINE_404 "HTTP/1.0 404 Not Found\r\n"
-#define STATUS_LINE_416 "HTTP/1.0 416 Requested Range Not Satisfiable\r\n"
-#define STATUS_LINE_500 "HTTP/1.0 500 Internal Server Error\r\n"
-#define STATUS_LINE_503 "HTTP/1.0 503 Service Unavailable\r\n"
+#define STATUS_LINE_100 "HTTP/1.1 100 Continue\r\n"
+#define STATUS_LINE_200 "HTTP/1.1 200 OK\r\n"
+#define STATUS_LINE_201 "HTTP/1.1 201 Created\r\n"
+#define STATUS_LINE_206 "HTTP/1.1 206 Partial Content\r\n"
+#define STATUS_LINE_304 "HTTP/1.1 304 Not Modified\r\n"
+#define STATUS_LINE_403 "HTTP/1.1 403 Forbidden\r\n"
+#define STATUS_LINE_404 "HTTP/1.1 404 Not Found\r\n"
+#define STATUS_LINE_416 "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"
+#define STATUS_LINE_500 "HTTP/1.1 500 Internal Server Error\r\n"
+#define STATUS_LINE_503 "HTTP/1.1 503 Service Unavailable\r\n"
 
 namespace Transports
 {
@@ -70,9 +72,12 @@ namespace Transports
       // Start header.
       std::stringstream ss;
       ss << status_line
-         << SERVER_VERSION
-         << "Content-Length: " << length << "\r\n"
-         << "Cache-Control: " << "max-age=1, must-revalidate" << "\r\n"
+         << SERVER_VERSION;
+
+      if (length >= 0)
+        ss << "Content-Length: " << length << "\r\n";
+
+      ss << "Cache-Control: " << "max-age=1, must-revalidate" << "\r\n"
          << "Last-Modified: " << now << "\r\n"
          << "Expires: " << now << "\r\n"
          << "Accept-Ranges: " << "bytes" << "\r\n";
@@ -95,8 +100,8 @@ namespace Transports
     void
     RequestHandler::sendResponse100(TCPSocket* sock)
     {
-      sendHeader(sock, STATUS_LINE_100, 8);
-      sock->write("Continue", 8);
+      // Interim responses have neither header fields nor a body.
+      sock->write(STATUS_LINE_100 "\r\n", sizeof(STATUS_LINE_100 "\r\n") - 1);
     }
 
     void
@@ -113,6 +118,12 @@ namespace Transports
       sock->write("Created", 7);
     }
 
+    void
+    RequestHandler::sendResponse304(TCPSocket* sock, HeaderFieldsMap* hdr_fields)
+    {
+      sendHeader(sock, STATUS_LINE_304, -1, hdr_fields);
+    }
+
     void
     RequestHandler::sendResponse403(TCPSocket* sock)
     {
@@ -158,7 +169,7 @@ namespace Transports
 
       while (remaining > 0)
       {
-        rv = sock->write(data, size);
+        rv = sock->write(data + (size - remaining), remaining);
 
         if (rv < 0)
         {
@@ -242,38 +253,57 @@ namespace Transports
     }
 
     void
+    RequestHandler::detachConnection(TCPSocket* sock)
+    {
+      Concurrency::ScopedMutex l(m_detached_lock);
+      m_detached.insert(sock);
+    }
+
+    RequestHandler::ConnectionState
     RequestHandler::handleRequest(TCPSocket* sock)
     {
       char mtd[16];
       char uri[512];
+      char ver[16];
       char bfr[c_max_request_size] = {0};
 
-      // Search for end of request.
+      // Search for end of request. Data is peeked in blocks and only
+      // the bytes of the header are consumed, leaving the body and
+      // any pipelined requests in the socket.
       unsigned idx = 0;
       unsigned didx = 0;
       bool eor = false;
       while (!eor && (idx < (c_max_request_size - 1)))
       {
-        int rv = sock->read(bfr + idx, 1);
-
-        if (rv <= 0)
-          throw ConnectionClosed();
-
-        if (didx == 0 && bfr[idx] == '\r')
-          didx = 1;
-        else if (didx == 1 && bfr[idx] == '\n')
-          didx = 2;
-        else if (didx == 2 && bfr[idx] == '\r')
-          didx = 3;
-        else if (didx == 3 && bfr[idx] == '\n')
+        size_t rv = sock->peek((uint8_t*)bfr + idx, c_max_request_size - 1 - idx);
+
+        size_t n = 0;
+        while (!eor && n < rv)
         {
-          eor = true;
-          didx = 0;
+          char c = bfr[idx + n++];
+
+          if (didx == 0 && c == '\r')
+            didx = 1;
+          else if (didx == 1 && c == '\n')
+            didx = 2;
+          else if (didx == 2 && c == '\r')
+            didx = 3;
+          else if (didx == 3 && c == '\n')
+            eor = true;
+          else
+            didx = 0;
         }
-        else
-          didx = 0;
 
-        ++idx;
+        for (size_t r = 0; r < n; )
+          r += sock->read(bfr + idx + r, n - r);
+
+        idx += n;
+      }
+
+      if (!eor)
+      {
+        DUNE_WRN("HTTP", "request too long");
+        return CS_CLOSE;
       }
 
       // Get header.
@@ -281,36 +311,54 @@ namespace Transports
       if (size <= 0)
       {
         DUNE_WRN("HTTP", "request too short");
-        return;
+        return CS_CLOSE;
       }
 
-      char* hdr = new char[size + 1];
-      std::memcpy(hdr, bfr, size);
-      hdr[size] = 0;
+      bfr[size] = 0;
 
-      Utils::TupleList headers(hdr, ":", "\r\n", true);
+      Utils::TupleList headers(bfr, ":", "\r\n", true);
 
       // Parse request line.
-      if (std::sscanf(hdr, "%s %s %*s", mtd, uri) == 2)
+      if (std::sscanf(bfr, "%15s %511s %15s", mtd, uri, ver) != 3)
+        return CS_CLOSE;
+
+      // HTTP/1.1 connections are persistent unless the client says
+      // otherwise. Requests with a body are not kept alive, since
+      // handlers may leave part of it unread.
+      std::string connection = headers.get("connection");
+      String::toLowerCase(connection);
+      bool keep_alive = (std::strcmp(ver, "HTTP/1.1") == 0)
+      && (connection != "close")
+      && (headers.get("content-length", 0) == 0)
+      && headers.get("transfer-encoding").empty();
+
+      std::string uri_dec = URL::decode(uri);
+      const char* uri_clean = uri_dec.c_str();
+
+      if (std::strcmp(mtd, "GET") == 0)
       {
-        std::string uri_dec = URL::decode(uri);
-        const char* uri_clean = uri_dec.c_str();
+        handleGET(sock, headers, uri_clean);
+      }
+      else if (std::strcmp(mtd, "POST") == 0)
+      {
+        handlePOST(sock, headers, uri_clean);
+      }
+      else if (std::strcmp(mtd, "PUT") == 0)
+      {
+        handlePUT(sock, headers, uri_clean);
+      }
+      else
+      {
+        return CS_CLOSE;
+      }
 
-        if (std::strcmp(mtd, "GET") == 0)
-        {
-          handleGET(sock, headers, uri_clean);
-        }
-        else if (std::strcmp(mtd, "POST") == 0)
-        {
-          handlePOST(sock, headers, uri_clean);
-        }
-        else if (std::strcmp(mtd, "PUT") == 0)
-        {
-          handlePUT(sock, headers, uri_clean);
-        }
+      {
+        Concurrency::ScopedMutex l(m_detached_lock);
+        if (m_detached.erase(sock) > 0)
+          return CS_DETACHED;
       }
 
-      delete[] hdr;
+      return keep_alive ? CS_KEEP_ALIVE : CS_CLOSE;
     }
   }
 }
@@ -32,6 +32,7 @@
 
 // ISO C++ 98 headers.
 #include <map>
+#include <set>
 #include <string>
 #include <cstddef>
 
@@ -49,6 +50,17 @@ namespace Transports
     public:
       typedef std::map<std::string, std::string> HeaderFieldsMap;
 
+      //! What to do with a connection after handling a request.
+      enum ConnectionState
+      {
+        //! Connection must be closed.
+        CS_CLOSE,
+        //! Connection can be reused for further requests.
+        CS_KEEP_ALIVE,
+        //! Connection is now owned by the request handler.
+        CS_DETACHED
+      };
+
       RequestHandler(void)
       { }
 
@@ -65,6 +77,12 @@ namespace Transports
       virtual void
       handlePUT(TCPSocket* sock, Utils::TupleList& headers, const char* uri);
 
+      //! Send a response header.
+      //! @param sock connection socket.
+      //! @param status_line status line.
+      //! @param length length of the body, or -1 to omit the
+      //! Content-Length field.
+      //! @param hdr_fields additional header fields.
       void
       sendHeader(TCPSocket* sock, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields = 0);
 
@@ -77,6 +95,9 @@ namespace Transports
       void
       sendResponse200(TCPSocket* sock);
 
+      void
+      sendResponse304(TCPSocket* sock, HeaderFieldsMap* hdr_fields = 0);
+
       void
       sendResponse403(TCPSocket* sock);
 
@@ -110,8 +131,25 @@ namespace Transports
       void
       sendFile(TCPSocket* sock, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg = -1, int64_t off_end = -1);
 
+      //! Take ownership of the connection of the request being
+      //! handled. Must only be called from handleGET(), handlePOST()
+      //! or handlePUT(); the connection will not be closed or reused
+      //! after the handler returns.
+      //! @param[in] sock connection socket.
       void
+      detachConnection(TCPSocket* sock);
+
+      //! Read and handle one request.
+      //! @param[in] sock connection socket.
+      //! @return what to do with the connection.
+      ConnectionState
       handleRequest(TCPSocket* sock);
+
+    private:
+      //! Connections detached by request handlers.
+      std::set<TCPSocket*> m_detached;
+      //! Lock protecting m_detached.
+      Concurrency::Mutex m_detached_lock;
     };
   }
 }
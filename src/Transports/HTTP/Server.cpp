@@ -50,12 +50,14 @@ namespace Transports
     class Handler: public Concurrency::Thread
     {
     public:
-      Handler(RequestHandler& hdler, Concurrency::TSQueue<TCPSocket*>& queue):
+      Handler(Server& server, RequestHandler& hdler, Concurrency::TSQueue<TCPSocket*>& queue):
+        m_server(server),
         m_handler(hdler),
         m_queue(queue)
       { }
 
     private:
+      Server& m_server;
       RequestHandler& m_handler;
       Concurrency::TSQueue<TCPSocket*>& m_queue;
 
@@ -74,28 +76,35 @@ namespace Transports
           if (!sock)
             continue;
 
+          RequestHandler::ConnectionState state = RequestHandler::CS_CLOSE;
+
           try
           {
-            m_handler.handleRequest(sock);
+            state = m_handler.handleRequest(sock);
           }
           catch (...)
           { }
 
-          delete sock;
+          if (state == RequestHandler::CS_KEEP_ALIVE)
+            m_server.keepAlive(sock);
+          else if (state == RequestHandler::CS_CLOSE)
+            delete sock;
         }
       }
     };
 
-    Server::Server(int port, unsigned threads, RequestHandler& handler):
-      m_handler(handler)
+    Server::Server(int port, unsigned threads, RequestHandler& handler, double keep_alive):
+      m_handler(handler),
+      m_keep_alive(keep_alive)
     {
       m_sock.bind(port);
       m_sock.listen(1024);
       m_poll.add(m_sock);
+      m_poll.add(m_returned_event.getNative());
 
       for (unsigned int i = 0; i < threads; ++i)
       {
-        Concurrency::Thread* t = new Handler(handler, m_queue);
+        Concurrency::Thread* t = new Handler(*this, handler, m_queue);
         m_pool.push_back(t);
         t->start();
       }
@@ -123,26 +132,95 @@ namespace Transports
         if (sock)
           delete sock;
       }
+
+      while (!m_returned.empty())
+        delete m_returned.pop();
+
+      for (std::list<IdleConnection>::iterator itr = m_idle.begin(); itr != m_idle.end(); ++itr)
+        delete itr->sock;
     }
 
     void
-    Server::poll(double timeout)
+    Server::keepAlive(TCPSocket* sock)
+    {
+      m_returned.push(sock);
+      m_returned_event.signal();
+    }
+
+    void
+    Server::acceptConnection(void)
+    {
+      try
+      {
+        TCPSocket* nc = m_sock.accept();
+        // Responses are written in several chunks on persistent
+        // connections, which must not wait for acknowledgements.
+        nc->setNoDelay(true);
+        // Workers only get connections with pending data, so these
+        // timeouts only apply to misbehaving clients.
+        nc->setReceiveTimeout(5);
+        nc->setSendTimeout(5);
+        m_queue.push(nc);
+      }
+      catch (std::runtime_error& e)
+      {
+        DUNE_ERR("Server", e.what());
+      }
+    }
+
+    void
+    Server::updateIdleConnections(bool triggered)
     {
-      if (m_poll.poll(timeout))
+      double now = Clock::get();
+
+      // Hand connections with new requests back to the workers and
+      // close the ones that have been idle for too long.
+      std::list<IdleConnection>::iterator itr = m_idle.begin();
+      while (itr != m_idle.end())
       {
-        if (m_poll.wasTriggered(m_sock))
+        if (triggered && m_poll.wasTriggered(*itr->sock))
         {
-          try
-          {
-            TCPSocket* nc = m_sock.accept();
-            m_queue.push(nc);
-          }
-          catch (std::runtime_error& e)
-          {
-            DUNE_ERR("Server", e.what());
-          }
+          m_poll.remove(*itr->sock);
+          m_queue.push(itr->sock);
+          itr = m_idle.erase(itr);
+        }
+        else if (now >= itr->deadline)
+        {
+          m_poll.remove(*itr->sock);
+          delete itr->sock;
+          itr = m_idle.erase(itr);
+        }
+        else
+        {
+          ++itr;
+        }
+      }
+
+      // Watch connections returned by the workers.
+      if (triggered && m_poll.wasTriggered(m_returned_event.getNative()))
+      {
+        m_returned_event.clear();
+
+        while (!m_returned.empty())
+        {
+          IdleConnection c;
+          c.sock = m_returned.pop();
+          c.deadline = now + m_keep_alive;
+          m_poll.add(*c.sock);
+          m_idle.push_back(c);
         }
       }
     }
+
+    void
+    Server::poll(double timeout)
+    {
+      bool triggered = m_poll.poll(timeout);
+
+      if (triggered && m_poll.wasTriggered(m_sock))
+        acceptConnection();
+
+      updateIdleConnections(triggered);
+    }
   }
 }
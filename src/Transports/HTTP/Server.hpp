@@ -31,6 +31,7 @@
 #define TRANSPORTS_HTTP_SERVER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <list>
 #include <vector>
 
 // DUNE headers.
@@ -50,7 +51,9 @@ namespace Transports
       //! @param port listening port.
       //! @param threads number of worker threads.
       //! @param handler HTTP request handler.
-      Server(int port, unsigned threads, RequestHandler& handler);
+      //! @param keep_alive amount of time in seconds an idle
+      //! persistent connection is kept open.
+      Server(int port, unsigned threads, RequestHandler& handler, double keep_alive = 15.0);
 
       //! Destructor.
       ~Server(void);
@@ -58,7 +61,32 @@ namespace Transports
       void
       poll(double timeout);
 
+      //! Watch an additional handle, so that poll() returns as soon
+      //! as it becomes readable.
+      //! @param handle native I/O handle.
+      void
+      addWakeHandle(const IO::NativeHandle& handle)
+      {
+        m_poll.add(handle);
+      }
+
+      //! Return a persistent connection to the server, which will
+      //! hand it to a worker thread when the next request arrives.
+      //! Can be called from any thread.
+      //! @param sock connection socket.
+      void
+      keepAlive(TCPSocket* sock);
+
     private:
+      //! Idle persistent connection.
+      struct IdleConnection
+      {
+        //! Connection socket.
+        TCPSocket* sock;
+        //! Time at which the connection is closed.
+        double deadline;
+      };
+
       //! HTTP request handler.
       RequestHandler& m_handler;
       //! Server socket.
@@ -69,6 +97,22 @@ namespace Transports
       Concurrency::TSQueue<TCPSocket*> m_queue;
       //! I/O multiplexing.
       IO::Poll m_poll;
+      //! Connections returned by worker threads.
+      Concurrency::TSQueue<TCPSocket*> m_returned;
+      //! Event signaled when connections are returned.
+      IO::EventHandle m_returned_event;
+      //! Idle persistent connections.
+      std::list<IdleConnection> m_idle;
+      //! Idle timeout of persistent connections.
+      double m_keep_alive;
+
+      void
+      acceptConnection(void);
+
+      //! Update idle persistent connections after polling.
+      //! @param triggered true if any handle was triggered.
+      void
+      updateIdleConnections(bool triggered);
     };
   }
 }
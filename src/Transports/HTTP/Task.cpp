@@ -40,6 +40,8 @@
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
+#include "AssetCache.hpp"
+#include "EventStream.hpp"
 #include "MessageMonitor.hpp"
 #include "RequestHandler.hpp"
 #include "Server.hpp"
@@ -59,8 +61,14 @@ namespace Transports
       unsigned port;
       //! Number of worker threads.
       unsigned threads;
+      //! Idle timeout of persistent connections.
+      double keep_alive;
+      //! Static asset cache size in KiB.
+      unsigned asset_cache_size;
       //! List of messages to transport.
       std::vector<std::string> messages;
+      //! Decimation rules.
+      std::vector<std::string> decimation;
     };
 
     //! Buffer length.
@@ -78,6 +86,12 @@ namespace Transports
       std::string m_agent;
       //! Message Monitor.
       MessageMonitor m_msg_mon;
+      //! Message decimator.
+      MessageDecimator m_decimator;
+      //! Server-sent events stream.
+      EventStream m_events;
+      //! Static asset cache.
+      AssetCache m_assets;
       //! Task arguments.
       Arguments m_args;
 
@@ -96,16 +110,38 @@ namespace Transports
         .defaultValue("5")
         .description("Number of worker threads");
 
+        param("Keep-Alive Timeout", m_args.keep_alive)
+        .defaultValue("15.0")
+        .units(Units::Second)
+        .description("Amount of time an idle persistent connection is kept open");
+
+        param("Asset Cache Size", m_args.asset_cache_size)
+        .defaultValue("4096")
+        .units(Units::Kibibyte)
+        .description("Amount of memory used to cache static files and their"
+                     " compressed variants, zero to disable");
+
         param("Transports", m_args.messages)
         .defaultValue("")
         .description("List of messages to transport");
 
+        param("Decimation Rules", m_args.decimation)
+        .defaultValue("")
+        .description("List of <Message>[@<Entity>]:<Mode>:<Period>[:<Threshold>]"
+                     " rules, where <Mode> is Rate, Mean, Minimum, Maximum or Deadband");
+
         m_cfg_dir = ctx.dir_cfg.str();
         m_agent = getSystemName();
 
         bind<IMC::LogBookEntry>(this);
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_assets.setCapacity(m_args.asset_cache_size * 1024);
+      }
+
       void
       onResourceAcquisition(void)
       {
@@ -118,7 +154,8 @@ namespace Transports
           try
           {
             inf(DTR("listening on %s:%u"), Address(Address::Any).c_str(), port);
-            m_server = new Server(port, m_args.threads, *this);
+            m_server = new Server(port, m_args.threads, *this, m_args.keep_alive);
+            m_server->addWakeHandle(getMessageHandle());
 
             // Initialize and dispatch AnnounceService.
             std::vector<Interface> itfs = Interface::get();
@@ -158,19 +195,40 @@ namespace Transports
       onEntityResolution(void)
       {
         m_msg_mon.setEntities(m_ctx.entities.entries());
+        m_decimator.setup(m_args.decimation, this);
       }
 
       void
       consume(const IMC::Message* msg)
       {
-        if (msg->getSource() == getSystemId())
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (m_decimator.filter(msg, Clock::getSinceEpoch()))
+          return;
+
+        m_msg_mon.updateMessage(msg);
+        m_events.publish(msg);
+      }
+
+      //! Publish aggregated messages of completed decimation windows.
+      void
+      updateAggregates(void)
+      {
+        IMC::Message* msg = NULL;
+        while ((msg = m_decimator.pop(Clock::getSinceEpoch())) != NULL)
+        {
           m_msg_mon.updateMessage(msg);
+          m_events.publish(msg);
+          delete msg;
+        }
       }
 
       void
       consume(const IMC::LogBookEntry* msg)
       {
         m_msg_mon.addLogEntry(msg);
+        m_events.publish(msg);
       }
 
       static bool
@@ -210,6 +268,8 @@ namespace Transports
             handlePowerChannel(sock, headers, uri);
           else if (matchURL(uri, "/dune/state/logbook.js", true))
             showLogBook(sock, headers, uri);
+          else if (matchURL(uri, "/dune/state/events", true))
+            streamEvents(sock, headers, uri);
           else
             sendResponse404(sock);
         }
@@ -280,17 +340,68 @@ namespace Transports
         }
 
         RequestHandler::HeaderFieldsMap hdr;
-        std::string ext = file.extension();
-        if (ext == "html")
-          hdr["Content-Type"] = "text/html";
-        else if (ext == "css")
-          hdr["Content-Type"] = "text/css";
-        else if (ext == "js")
-          hdr["Content-Type"] = "text/javascript";
+
+        // Serve whole files from the cache.
+        AssetCache::Representation rep;
+        bool accept_gzip = headers.get("accept-encoding").find("gzip") != std::string::npos;
+        if (beg < 0 && end < 0 && m_assets.get(file, accept_gzip, rep))
+        {
+          hdr["ETag"] = rep.etag;
+          hdr["Vary"] = "Accept-Encoding";
+          if (!rep.type.empty())
+            hdr["Content-Type"] = rep.type;
+
+          if (matchETag(headers.get("if-none-match"), rep.etag))
+          {
+            sendResponse304(sock, &hdr);
+            return;
+          }
+
+          if (rep.gzip)
+            hdr["Content-Encoding"] = "gzip";
+
+          sendData(sock, rep.data, &hdr);
+          return;
+        }
+
+        std::string type = AssetCache::getContentType(file);
+        if (!type.empty())
+          hdr["Content-Type"] = type;
 
         sendFile(sock, file.str(), hdr, beg, end);
       }
 
+      //! Check if an entity tag matches the value of an
+      //! If-None-Match header field.
+      //! @param[in] field header field value.
+      //! @param[in] etag entity tag.
+      //! @return true if the entity tag matches, false otherwise.
+      static bool
+      matchETag(const std::string& field, const std::string& etag)
+      {
+        if (field.empty())
+          return false;
+
+        if (String::trim(field) == "*")
+          return true;
+
+        std::vector<std::string> tags;
+        String::split(field, ",", tags);
+        for (unsigned i = 0; i < tags.size(); ++i)
+        {
+          std::string tag = String::trim(tags[i]);
+
+          // Weak comparison.
+          if (tag.compare(0, 2, "W/") == 0)
+            tag = tag.substr(2);
+
+          if (tag == etag)
+            return true;
+        }
+
+        return false;
+      }
+
       void
       getMessage(TCPSocket* sock, TupleList& headers, const char* uri)
       {
@@ -354,6 +465,48 @@ namespace Transports
         sendData(sock, bfr->getBufferSigned(), bfr->getSize(), &hdr);
       }
 
+      //! Stream messages as server-sent events. The URI is either
+      //! /dune/state/events, to stream all messages, or
+      //! /dune/state/events/<Message>[,<Message>...].
+      void
+      streamEvents(TCPSocket* sock, TupleList& headers, const char* uri)
+      {
+        (void)headers;
+
+        std::set<uint32_t> ids;
+        std::string list = String::getRemaining("/dune/state/events", uri);
+        if (!list.empty())
+        {
+          if (list[0] != '/')
+          {
+            sendResponse404(sock);
+            return;
+          }
+
+          std::vector<std::string> names;
+          String::split(list.substr(1), ",", names);
+          for (unsigned i = 0; i < names.size(); ++i)
+          {
+            if (names[i].empty())
+              continue;
+
+            try
+            {
+              ids.insert(IMC::Factory::getIdFromAbbrev(names[i]));
+            }
+            catch (...)
+            {
+              sendResponse404(sock, "Unknown message " + names[i]);
+              return;
+            }
+          }
+        }
+
+        detachConnection(sock);
+        m_events.add(sock, ids);
+        debug("event stream started, %u clients", (unsigned)m_events.size());
+      }
+
       void
       sendVersionJSON(TCPSocket* sock, TupleList& headers, const char* uri)
       {
@@ -456,6 +609,8 @@ namespace Transports
           setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
           m_server->poll(1.0);
           consumeMessages();
+          updateAggregates();
+          m_events.ping();
         }
       }
     };
@@ -266,8 +266,28 @@ namespace Transports
             {
               inf("received IMC message of type %s via Iridium from %d.", irMsg->msg->getName(), irMsg->source);
               IMC::Message* m2 = irMsg->msg;
-              m2->setSource(irMsg->source);
-              dispatch(m2);
+
+              // Several messages may have been packed in one transmission.
+              if (m2->getId() == IMC::MsgList::getIdStatic())
+              {
+                IMC::MsgList* list = static_cast<IMC::MsgList*>(m2);
+                IMC::MessageList<IMC::Message>::const_iterator itr = list->msgs.begin();
+                for (; itr != list->msgs.end(); ++itr)
+                {
+                  if (*itr == NULL)
+                    continue;
+
+                  IMC::Message* m3 = (*itr)->clone();
+                  m3->setSource(irMsg->source);
+                  dispatch(m3);
+                  delete m3;
+                }
+              }
+              else
+              {
+                m2->setSource(irMsg->source);
+                dispatch(m2);
+              }
             }
             else
             {
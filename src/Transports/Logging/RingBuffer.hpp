@@ -0,0 +1,188 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOGGING_RING_BUFFER_HPP_INCLUDED_
+#define TRANSPORTS_LOGGING_RING_BUFFER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+namespace Transports
+{
+  namespace Logging
+  {
+    //! Fixed capacity ring of serialized packets. Packets older than
+    //! the configured time window, or that do not fit in the
+    //! available capacity, are discarded oldest first.
+    //!
+    //! Transports.LoggingDigest does not use it: that task already
+    //! keeps only the latest sample of each message and writes it at
+    //! a fixed interval, so there is no burst of detail to hold back.
+    class RingBuffer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity capacity in bytes.
+      //! @param[in] window time window in seconds.
+      RingBuffer(size_t capacity, double window):
+        m_data(capacity),
+        m_window(window),
+        m_head(0),
+        m_used(0)
+      { }
+
+      //! Store a serialized packet.
+      //! @param[in] time packet timestamp.
+      //! @param[in] data packet data.
+      //! @param[in] size packet size.
+      void
+      push(double time, const char* data, size_t size)
+      {
+        if (size == 0 || size > m_data.size())
+          return;
+
+        expire(time);
+
+        while (m_data.size() - m_used < size)
+          discard();
+
+        Record rec;
+        rec.time = time;
+        rec.offset = (m_head + m_used) % m_data.size();
+        rec.size = size;
+
+        size_t first = std::min(size, m_data.size() - rec.offset);
+        std::memcpy(&m_data[rec.offset], data, first);
+        if (first < size)
+          std::memcpy(&m_data[0], data + first, size - first);
+
+        m_used += size;
+        m_records.push_back(rec);
+      }
+
+      //! Discard packets older than the time window.
+      //! @param[in] now current time.
+      void
+      expire(double now)
+      {
+        while (!m_records.empty() && (m_records.front().time < now - m_window))
+          discard();
+      }
+
+      //! Remove the oldest stored packet.
+      //! @param[out] bfr packet data.
+      //! @return true if a packet was retrieved, false if the ring is
+      //! empty.
+      bool
+      pop(DUNE::Utils::ByteBuffer& bfr)
+      {
+        if (m_records.empty())
+          return false;
+
+        const Record& rec = m_records.front();
+        size_t first = std::min(rec.size, m_data.size() - rec.offset);
+
+        bfr.setSize(rec.size);
+        std::memcpy(bfr.getBufferSigned(), &m_data[rec.offset], first);
+        if (first < rec.size)
+          std::memcpy(bfr.getBufferSigned() + first, &m_data[0], rec.size - first);
+
+        discard();
+        return true;
+      }
+
+      //! Discard all stored packets.
+      void
+      clear(void)
+      {
+        m_records.clear();
+        m_head = 0;
+        m_used = 0;
+      }
+
+      //! Retrieve the number of stored packets.
+      //! @return number of packets.
+      size_t
+      size(void) const
+      {
+        return m_records.size();
+      }
+
+      //! Retrieve the number of used bytes.
+      //! @return number of bytes.
+      size_t
+      used(void) const
+      {
+        return m_used;
+      }
+
+    private:
+      //! Stored packet.
+      struct Record
+      {
+        //! Packet timestamp.
+        double time;
+        //! Offset of the first byte.
+        size_t offset;
+        //! Packet size.
+        size_t size;
+      };
+
+      //! Packet storage.
+      std::vector<char> m_data;
+      //! Stored packets, oldest first.
+      std::deque<Record> m_records;
+      //! Time window.
+      double m_window;
+      //! Offset of the oldest packet.
+      size_t m_head;
+      //! Number of used bytes.
+      size_t m_used;
+
+      //! Discard the oldest packet.
+      void
+      discard(void)
+      {
+        const Record& rec = m_records.front();
+        m_head = (rec.offset + rec.size) % m_data.size();
+        m_used -= rec.size;
+        m_records.pop_front();
+
+        if (m_records.empty())
+          m_head = 0;
+      }
+    };
+  }
+}
+
+#endif
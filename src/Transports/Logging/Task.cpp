@@ -33,10 +33,15 @@
 #include <fstream>
 #include <algorithm>
 #include <cstddef>
+#include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "RingBuffer.hpp"
+
 namespace Transports
 {
   namespace Logging
@@ -58,6 +63,22 @@ namespace Transports
       unsigned lsf_volume_size;
       // Compression method.
       std::string lsf_compression;
+      // Number of compression threads.
+      unsigned lsf_compression_threads;
+      // List of messages kept in the pre-trigger ring buffer.
+      std::vector<std::string> pre_messages;
+      // Pre-trigger time window.
+      float pre_duration;
+      // Pre-trigger ring buffer size.
+      unsigned pre_size;
+      // Post-trigger time window.
+      float post_duration;
+      // Maximum amount of uncompressed data per segment.
+      unsigned segment_size;
+      // Maximum duration of a segment.
+      float segment_duration;
+      // Decimation rules.
+      std::vector<std::string> decimation;
     };
 
     struct Task: public Tasks::Task
@@ -82,6 +103,28 @@ namespace Transports
       IMC::LoggingControl m_log_ctl;
       // True if logging is enabled.
       bool m_active;
+      // Pre-trigger ring buffer.
+      RingBuffer* m_ring;
+      // Identifiers of messages kept in the ring buffer.
+      std::set<uint32_t> m_ring_ids;
+      // Time until which ring buffer messages are logged directly.
+      double m_post_trigger;
+      // Output file stream for pre-trigger messages.
+      std::ostream* m_pre_lsf;
+      // Last known state of local entities.
+      std::map<unsigned, unsigned> m_entity_states;
+      // Last known vehicle operation mode.
+      unsigned m_vehicle_mode;
+      // Footer of the current LSF segment.
+      IMC::LogSegment m_segment;
+      // Path to the LSF segment index.
+      std::string m_segment_index;
+      // Amount of uncompressed data in the current segment.
+      uint64_t m_segment_bytes;
+      // Time at which the current segment was started.
+      double m_segment_start;
+      // Message decimator.
+      MessageDecimator m_decimator;
       // Task arguments.
       Arguments m_args;
 
@@ -89,7 +132,13 @@ namespace Transports
         Tasks::Task(name, ctx),
         m_last_flush(0),
         m_lsf(NULL),
-        m_active(true)
+        m_active(true),
+        m_ring(NULL),
+        m_post_trigger(0),
+        m_pre_lsf(NULL),
+        m_vehicle_mode(IMC::VehicleState::VS_SERVICE),
+        m_segment_bytes(0),
+        m_segment_start(0)
       {
         // Define configuration parameters.
         param("Flush Interval", m_args.flush_interval)
@@ -101,6 +150,11 @@ namespace Transports
         .defaultValue("none")
         .description("Compression method");
 
+        param("LSF Compression Threads", m_args.lsf_compression_threads)
+        .defaultValue("0")
+        .description("Number of threads used to compress the LSF file in parallel. "
+                     "Zero compresses in the logging thread");
+
         param("LSF Volume Size", m_args.lsf_volume_size)
         .units(Units::Mebibyte)
         .defaultValue("0");
@@ -111,23 +165,86 @@ namespace Transports
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Pre-Trigger Transports", m_args.pre_messages)
+        .defaultValue("")
+        .description("List of messages kept in memory and only written to the "
+                     "log when a trigger (Abort, entity failure, vehicle error "
+                     "or logging request) is received. Buffered messages are "
+                     "older than the ones already in Data.lsf, so they are "
+                     "written to PreTrigger.lsf in the same log folder to keep "
+                     "both files in time order");
+
+        param("Pre-Trigger Duration", m_args.pre_duration)
+        .defaultValue("30.0")
+        .units(Units::Second)
+        .description("Time window of pre-trigger messages kept in memory");
+
+        param("Pre-Trigger Size", m_args.pre_size)
+        .defaultValue("8")
+        .units(Units::Mebibyte)
+        .description("Maximum amount of memory used to keep pre-trigger messages");
+
+        param("Post-Trigger Duration", m_args.post_duration)
+        .defaultValue("10.0")
+        .units(Units::Second)
+        .description("Time after a trigger during which pre-trigger messages "
+                     "are written directly to the log");
+
+        param("LSF Segment Size", m_args.segment_size)
+        .defaultValue("0")
+        .units(Units::Mebibyte)
+        .description("Amount of uncompressed data after which the current LSF segment is "
+                     "closed and recorded in the segment index. Zero disables size-based "
+                     "segmentation");
+
+        param("LSF Segment Duration", m_args.segment_duration)
+        .defaultValue("60.0")
+        .units(Units::Second)
+        .description("Time after which the current LSF segment is closed and recorded "
+                     "in the segment index. Zero disables time-based segmentation");
+
+        param("Decimation Rules", m_args.decimation)
+        .defaultValue("")
+        .description("List of <Message>[@<Entity>]:<Mode>:<Period>[:<Threshold>]"
+                     " rules, where <Mode> is Rate, Mean, Minimum, Maximum or Deadband");
+
         m_log_ctl.setSource(getSystemId());
 
         bind<IMC::CacheControl>(this);
         bind<IMC::LoggingControl>(this);
         bind<IMC::PowerOperation>(this);
         bind<IMC::EntityInfo>(this);
+        bind<IMC::Abort>(this);
+        bind<IMC::EntityState>(this);
+        bind<IMC::VehicleState>(this);
       }
 
       ~Task(void)
       {
         onResourceRelease();
+        Memory::clear(m_ring);
       }
 
       void
       onResourceInitialization(void)
       {
-        bind(this, m_args.messages);
+        std::vector<uint32_t> ids;
+        for (size_t i = 0; i < m_args.messages.size(); ++i)
+          ids.push_back(IMC::Factory::getIdFromAbbrev(m_args.messages[i]));
+
+        for (size_t i = 0; i < m_args.pre_messages.size(); ++i)
+        {
+          uint32_t id = IMC::Factory::getIdFromAbbrev(m_args.pre_messages[i]);
+          m_ring_ids.insert(id);
+
+          if (std::find(ids.begin(), ids.end(), id) == ids.end())
+            ids.push_back(id);
+        }
+
+        bind(this, ids);
+
+        if (!m_ring_ids.empty())
+          m_ring = new RingBuffer(m_args.pre_size * c_bytes_per_mib, m_args.pre_duration);
 
         // Initialize entity state.
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
@@ -136,7 +253,9 @@ namespace Transports
       void
       onResourceRelease(void)
       {
+        closeSegment();
         Memory::clear(m_lsf);
+        Memory::clear(m_pre_lsf);
       }
 
       void
@@ -147,6 +266,12 @@ namespace Transports
           m_args.lsf_volumes.push_back("");
       }
 
+      void
+      onEntityResolution(void)
+      {
+        m_decimator.setup(m_args.decimation, this);
+      }
+
       void
       consume(const IMC::LoggingControl* msg)
       {
@@ -157,8 +282,10 @@ namespace Transports
         {
           case IMC::LoggingControl::COP_REQUEST_START:
             tryStartLog(msg->name);
+            trigger(DTR("logging request"));
             break;
           case IMC::LoggingControl::COP_REQUEST_STOP:
+            trigger(DTR("logging request"));
             stopLog(false);
             break;
           case IMC::LoggingControl::COP_REQUEST_CURRENT_NAME:
@@ -215,13 +342,86 @@ namespace Transports
           logMessage(msg);
       }
 
+      void
+      consume(const IMC::Abort* msg)
+      {
+        (void)msg;
+        trigger(DTR("abort"));
+      }
+
+      void
+      consume(const IMC::EntityState* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        unsigned state = msg->state;
+        bool failed = (state == IMC::EntityState::ESTA_ERROR
+                       || state == IMC::EntityState::ESTA_FAILURE);
+
+        std::map<unsigned, unsigned>::iterator itr = m_entity_states.find(msg->getSourceEntity());
+        if (itr == m_entity_states.end())
+        {
+          m_entity_states[msg->getSourceEntity()] = state;
+          return;
+        }
+
+        bool was_failed = (itr->second == IMC::EntityState::ESTA_ERROR
+                           || itr->second == IMC::EntityState::ESTA_FAILURE);
+        itr->second = state;
+
+        if (failed && !was_failed)
+          trigger(DTR("entity failure"));
+      }
+
+      void
+      consume(const IMC::VehicleState* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (msg->op_mode == IMC::VehicleState::VS_ERROR
+            && m_vehicle_mode != IMC::VehicleState::VS_ERROR)
+          trigger(DTR("vehicle error"));
+
+        m_vehicle_mode = msg->op_mode;
+      }
+
       void
       consume(const IMC::Message* msg)
       {
-        if (m_active)
+        if (!m_active)
+          return;
+
+        if (m_decimator.filter(msg, Clock::getSinceEpoch()))
+          return;
+
+        recordMessage(msg);
+      }
+
+      //! Log a message or keep it in the pre-trigger ring buffer.
+      //! @param[in] msg message.
+      void
+      recordMessage(const IMC::Message* msg)
+      {
+        if (m_ring != NULL && m_ring_ids.count(msg->getId()) && Clock::get() > m_post_trigger)
+          bufferMessage(msg);
+        else
           logMessage(msg);
       }
 
+      //! Record aggregated messages of completed decimation windows.
+      void
+      recordAggregates(void)
+      {
+        IMC::Message* msg = NULL;
+        while ((msg = m_decimator.pop(Clock::getSinceEpoch())) != NULL)
+        {
+          recordMessage(msg);
+          delete msg;
+        }
+      }
+
       bool
       changeVolumeDirectory(void)
       {
@@ -288,11 +488,18 @@ namespace Transports
         if (!ifs.is_open())
           return;
 
-        char bfr[16 * 1024];
-        while (!ifs.eof())
+        try
+        {
+          IMC::Message* msg = NULL;
+          while ((msg = IMC::Packet::deserialize(ifs, m_buffer)) != NULL)
+          {
+            delete msg;
+            writePacket(m_buffer);
+          }
+        }
+        catch (std::exception& e)
         {
-          ifs.read(bfr, sizeof(bfr));
-          m_lsf->write(bfr, ifs.gcount());
+          war(DTR("failed to read cache snapshot: %s"), e.what());
         }
       }
 
@@ -353,7 +560,14 @@ namespace Transports
         if (m_compression == METHOD_UNKNOWN)
           m_lsf = new std::ofstream(m_lsf_file.c_str(), std::ios::binary);
         else
-          m_lsf = new Compression::FileOutput(m_lsf_file.c_str(), m_compression);
+          m_lsf = new Compression::FileOutput(m_lsf_file.c_str(), m_compression,
+                                               m_args.lsf_compression_threads);
+
+        m_segment_index = IMC::LogSegment::getIndexPath(m_lsf_file.str());
+        m_segment.offset = 0;
+        m_segment.clear();
+        m_segment_bytes = 0;
+        m_segment_start = Clock::get();
 
         // Log LoggingControl to facilitate posterior conversion to LLF.
         m_log_ctl.op = IMC::LoggingControl::COP_STARTED;
@@ -425,7 +639,141 @@ namespace Transports
           return;
 
         IMC::Packet::serialize(msg, m_buffer);
-        m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+        writePacket(m_buffer);
+      }
+
+      //! Write a serialized packet to the LSF file.
+      //! @param[in] bfr serialized packet.
+      void
+      writePacket(ByteBuffer& bfr)
+      {
+        m_lsf->write(bfr.getBufferSigned(), bfr.getSize());
+
+        if (!isSegmented())
+          return;
+
+        m_segment.update(bfr.getBuffer(), bfr.getSize());
+        m_segment_bytes += bfr.getSize();
+
+        if (m_args.segment_size > 0 && m_segment_bytes >= m_args.segment_size * (uint64_t)c_bytes_per_mib)
+          closeSegment();
+      }
+
+      //! Check if LSF segmentation is enabled.
+      //! @return true if segmentation is enabled, false otherwise.
+      bool
+      isSegmented(void) const
+      {
+        return m_args.segment_size > 0 || m_args.segment_duration > 0;
+      }
+
+      //! Close the current LSF segment if its maximum duration has
+      //! elapsed.
+      void
+      tryCloseSegment(void)
+      {
+        if (m_args.segment_duration <= 0)
+          return;
+
+        if (Clock::get() >= m_segment_start + m_args.segment_duration)
+          closeSegment();
+      }
+
+      //! Flush the current LSF segment to disk and record its footer
+      //! in the segment index.
+      void
+      closeSegment(void)
+      {
+        m_segment_start = Clock::get();
+
+        if (m_lsf == NULL || !isSegmented() || m_segment.count == 0)
+          return;
+
+        m_lsf->flush();
+
+        uint64_t end = Path(m_lsf_file).size();
+        m_segment.size = end - m_segment.offset;
+        IMC::LogSegment::append(m_segment_index, m_segment);
+
+        m_segment.offset = end;
+        m_segment.clear();
+        m_segment_bytes = 0;
+      }
+
+      void
+      bufferMessage(const IMC::Message* msg)
+      {
+        IMC::Packet::serialize(msg, m_buffer);
+        m_ring->push(Clock::get(), m_buffer.getBufferSigned(), m_buffer.getSize());
+      }
+
+      //! Write a message to the pre-trigger LSF file.
+      //! @param[in] msg message.
+      void
+      writePreTrigger(const IMC::Message* msg)
+      {
+        IMC::Packet::serialize(msg, m_buffer);
+        m_pre_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+      }
+
+      //! Write the same preamble as the main LSF file, so that the
+      //! pre-trigger file can be converted on its own: the
+      //! LoggingControl of the current log and the information of the
+      //! local entities.
+      void
+      writePreTriggerHeader(void)
+      {
+        writePreTrigger(&m_log_ctl);
+
+        std::vector<Entities::EntityDataBase::Entity*> devs;
+        m_ctx.entities.contents(devs);
+        for (unsigned int i = 0; i < devs.size(); ++i)
+        {
+          IMC::EntityInfo info;
+          info.setTimeStamp(m_log_ctl.getTimeStamp());
+          info.setSource(getSystemId());
+          info.setSourceEntity(devs[i]->id);
+          info.id = devs[i]->id;
+          info.label = devs[i]->label;
+          info.component = devs[i]->task_name;
+          writePreTrigger(&info);
+        }
+      }
+
+      //! Write the contents of the pre-trigger ring buffer to the
+      //! pre-trigger LSF file and log pre-trigger messages directly
+      //! for a while.
+      //! @param[in] reason trigger description.
+      void
+      trigger(const char* reason)
+      {
+        if (m_ring == NULL || m_lsf == NULL || !m_active)
+          return;
+
+        if (m_ring->size() > 0)
+          inf(DTR("pre-trigger (%s): writing %u messages"), reason, (unsigned)m_ring->size());
+
+        // Buffered packets predate what is already in the main LSF
+        // file. Writing them there would break its time order.
+        if (m_pre_lsf == NULL)
+        {
+          Path file = m_dir / "PreTrigger.lsf" + Compression::Factory::extension(m_compression);
+
+          if (m_compression == METHOD_UNKNOWN)
+            m_pre_lsf = new std::ofstream(file.c_str(), std::ios::binary);
+          else
+            m_pre_lsf = new Compression::FileOutput(file.c_str(), m_compression,
+                                                    m_args.lsf_compression_threads);
+
+          writePreTriggerHeader();
+        }
+
+        while (m_ring->pop(m_buffer))
+          m_pre_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+
+        m_pre_lsf->flush();
+
+        m_post_trigger = Clock::get() + m_args.post_duration;
       }
 
       void
@@ -442,6 +790,8 @@ namespace Transports
           {
             try
             {
+              recordAggregates();
+              tryCloseSegment();
               tryFlush();
             }
             catch(std::exception& e)
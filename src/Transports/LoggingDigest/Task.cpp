@@ -48,6 +48,10 @@ namespace Transports
       std::string lsf_name;
       //! Log file folder.
       std::string log_folder;
+      //! Number of compression threads.
+      unsigned compression_threads;
+      //! Decimation rules.
+      std::vector<std::string> decimation;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -62,6 +66,8 @@ namespace Transports
       Counter<double> m_flush_timer;
       //! Serialization buffer.
       ByteBuffer m_buffer;
+      //! Message decimator.
+      MessageDecimator m_decimator;
       //! Task arguments.
       Arguments m_args;
 
@@ -89,9 +95,19 @@ namespace Transports
         .defaultValue("Digest")
         .description("LSF file name");
 
+        param("Compression Threads", m_args.compression_threads)
+        .defaultValue("0")
+        .description("Number of threads used to compress the log in parallel. "
+                     "Zero compresses in the task thread");
+
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Decimation Rules", m_args.decimation)
+        .defaultValue("")
+        .description("List of <Message>[@<Entity>]:<Mode>:<Period>[:<Threshold>]"
+                     " rules, where <Mode> is Rate, Mean, Minimum, Maximum or Deadband");
+
         bind<IMC::LoggingControl>(this);
         bind<IMC::EntityInfo>(this);
       }
@@ -127,6 +143,12 @@ namespace Transports
         bind(this, m_args.messages);
       }
 
+      void
+      onEntityResolution(void)
+      {
+        m_decimator.setup(m_args.decimation, this);
+      }
+
       uint32_t
       getKey(const IMC::Message* msg)
       {
@@ -149,12 +171,14 @@ namespace Transports
 
           Path(m_args.log_folder).create();
           Path path = m_args.log_folder / (flat_name + ".lsf.gz");
-          m_log = new Compression::FileOutput(path.c_str(), Compression::METHOD_GZIP);
+          m_log = new Compression::FileOutput(path.c_str(), Compression::METHOD_GZIP,
+                                              m_args.compression_threads);
         }
         else
         {
           Path path = m_ctx.dir_log / name / (m_args.lsf_name + ".lsf.gz");
-          m_log = new Compression::FileOutput(path.c_str(), Compression::METHOD_GZIP);
+          m_log = new Compression::FileOutput(path.c_str(), Compression::METHOD_GZIP,
+                                              m_args.compression_threads);
         }
 
         // Log entities.
@@ -217,18 +241,29 @@ namespace Transports
 
       void
       consume(const IMC::Message* msg)
+      {
+        if (m_decimator.filter(msg, Clock::getSinceEpoch()))
+          return;
+
+        storeMessage(msg->clone());
+      }
+
+      //! Keep the last instance of a message until the next sample.
+      //! @param[in] msg message (ownership is transferred).
+      void
+      storeMessage(IMC::Message* msg)
       {
         uint32_t key = getKey(msg);
 
         std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.find(key);
         if (itr == m_messages.end())
         {
-          m_messages[key] = msg->clone();
+          m_messages[key] = msg;
         }
         else
         {
           delete itr->second;
-          itr->second = msg->clone();
+          itr->second = msg;
         }
       }
 
@@ -241,6 +276,10 @@ namespace Transports
         if (!m_sample_timer.overflow())
           return;
 
+        IMC::Message* aggregate = NULL;
+        while ((aggregate = m_decimator.pop(Clock::getSinceEpoch())) != NULL)
+          storeMessage(aggregate);
+
         std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.begin();
         for (; itr != m_messages.end(); ++itr)
         {
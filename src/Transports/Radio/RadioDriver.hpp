@@ -148,6 +148,27 @@ namespace Transports
 
       }
 
+      //! Retrieve the signal to noise margin of the last RSSI report
+      //! ("L/R RSSI: <local>/<remote>  L/R noise: <local>/<remote> ...").
+      //! @param[out] margin lowest of local and remote margins.
+      //! @return true if a new report was available.
+      bool
+      takeLinkMargin(double& margin)
+      {
+        if (!device_reports.report_status[RSSI_REPORT])
+          return false;
+
+        device_reports.report_status[RSSI_REPORT] = false;
+
+        int lrssi, rrssi, lnoise, rnoise;
+        if (std::sscanf(device_reports.rssi.c_str(), "L/R RSSI: %d/%d L/R noise: %d/%d",
+                        &lrssi, &rrssi, &lnoise, &rnoise) != 4)
+          return false;
+
+        margin = std::min(lrssi - lnoise, rrssi - rnoise);
+        return true;
+      }
+
       bool
       newRxData(std::string& rx_data)
       {
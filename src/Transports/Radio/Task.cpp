@@ -98,6 +98,14 @@ namespace Transports
       std::string elabel_voltage;
       //! Radio reports periodicity.
       double radio_period;
+      //! Adapt report periodicity to link quality.
+      bool adaptive;
+      //! Rate adaptation period.
+      double adaptive_period;
+      //! Minimum rate scale.
+      double adaptive_min_scale;
+      //! Signal to noise margin range mapped to link quality.
+      std::vector<double> adaptive_snr_range;
 
     };
 
@@ -134,6 +142,8 @@ namespace Transports
       uint16_t m_systemID;
       //! Higth speed radio report
       Time::Counter<double> m_fast_treport_counter;
+      //! Rate controller.
+      Network::RateController m_rate;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
@@ -240,6 +250,29 @@ namespace Transports
         .maximumValue("600")
         .description("Reports periodicity");
 
+        param("Adaptive Rate", m_args.adaptive)
+        .defaultValue("false")
+        .description("Stretch the high speed report period when the link degrades."
+                     " Periodic state reports requested with ReportControl are not affected");
+
+        param("Adaptive Rate - Period", m_args.adaptive_period)
+        .defaultValue("5.0")
+        .minimumValue("1.0")
+        .units(Units::Second)
+        .description("Period between rate adaptations");
+
+        param("Adaptive Rate - Minimum Scale", m_args.adaptive_min_scale)
+        .defaultValue("0.2")
+        .minimumValue("0.01")
+        .maximumValue("1.0")
+        .description("Lowest fraction of the high speed report rate used on a poor link");
+
+        param("Adaptive Rate - SNR Range", m_args.adaptive_snr_range)
+        .defaultValue("10, 30")
+        .size(2)
+        .description("Margin between RSSI and noise, in radio units, at which"
+                     " the link is considered lost and good");
+
         param("Entity Label - Voltage", m_args.elabel_voltage)
         .defaultValue("Autopilot")
           .description("Entity label for battery Voltage");
@@ -370,6 +403,11 @@ namespace Transports
          if (m_args.power_channel.empty())
           m_powered = true;
 
+        m_rate.setPeriod(m_args.adaptive_period);
+        m_rate.setMinimumScale(m_args.adaptive_min_scale);
+        if (!m_args.adaptive)
+          m_rate.reset();
+
       }
 
       //! Reserve entity identifiers.
@@ -709,7 +747,7 @@ namespace Transports
         {
           if (m_reporter != NULL && m_telemetry!=NULL && m_fast_treport_counter.overflow())
           {
-            m_fast_treport_counter.setTop(m_args.radio_period);
+            m_fast_treport_counter.setTop(m_args.radio_period / m_rate.getScale());
            if(m_telemetry->isIdle())
            {
              m_telemetry->createReport();
@@ -719,6 +757,30 @@ namespace Transports
 
       }
 
+      //! Feed link measurements to the rate controller.
+      void
+      adaptRate(void)
+      {
+        if (!m_args.adaptive)
+          return;
+
+        double margin = 0;
+        if (m_radio->takeLinkMargin(margin))
+          m_rate.setQuality(margin, m_args.adaptive_snr_range[0], m_args.adaptive_snr_range[1]);
+
+        unsigned delivered = 0;
+        unsigned lost = 0;
+        m_telemetry->takeLinkOutcomes(delivered, lost);
+        m_rate.outcome(delivered, lost);
+
+        if (m_rate.update(Clock::get()))
+        {
+          debug("report rate scale %.2f (loss %.2f, quality %.2f, goodput %.0f B/s)",
+                m_rate.getScale(), m_rate.getLoss(), m_rate.getQuality(),
+                m_rate.getGoodput());
+        }
+      }
+
       //! Main loop.
       void
       onMain(void)
@@ -751,8 +813,10 @@ namespace Transports
             if(m_telemetry->anyDatatosend(txData))
             {
               m_radio->sendData(txData);
+              m_rate.sent(txData.size());
               m_telemetry->updateTxState();
             }
+            adaptRate();
           }
           hardwareUpdateStateMachine();
         }
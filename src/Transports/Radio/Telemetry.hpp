@@ -62,7 +62,10 @@ namespace Transports
         m_rx_telemetry_State(IDLE),
         local_tx_sync(0),
         local_rx_sync(0),
-        systemID(system)
+        systemID(system),
+        m_rx_synced(false),
+        m_delivered(0),
+        m_lost(0)
       {
       	m_tx_mesg.state = MSG_TRANSMIT;
         m_radio_names= radio_names;
@@ -396,12 +399,16 @@ namespace Transports
           acquisition_Rx_Frame.clear();
          }
 
+         ++m_delivered;
          if(local_rx_sync != rx_test.sync && rx_test.code != CODE_AK)
          {
+          if (m_rx_synced)
+            m_lost += (uint8_t)(rx_test.sync - local_rx_sync);
           m_task->trace("local_rx_sync % d rx_test.sync %d",local_rx_sync,rx_test.sync);
           updateRxSync(rx_test.sync);
           m_task->inf("previous message(s) lost or first sync");
          }
+         m_rx_synced = true;
 
          if(rx_test.npart && rx_test.start_part)
          {
@@ -475,6 +482,7 @@ namespace Transports
               m_task->debug("AK to message trasmition");
               if(m_rx_msg.sync== m_tx_mesg.sync)
               {
+                ++m_delivered;
                 m_tx_telemetry_State = IDLE;
                 m_tx_mesg.state = MSG_AK;
                 m_tx_mesg.telemetry_imc_status.status= IMC::TelemetryMsg::TM_DONE;
@@ -507,6 +515,7 @@ namespace Transports
 
            if (m_tx_mesg.msg_timer.overflow())
            {
+             ++m_lost;
              m_tx_mesg.state = MSG_NAK;
              m_tx_telemetry_State = IDLE;
              m_tx_mesg.telemetry_imc_status.status= IMC::TelemetryMsg::TM_EXPIRED;
@@ -695,6 +704,18 @@ namespace Transports
          }
        }
 
+       //! Retrieve and reset the number of frames known to be
+       //! delivered (received, or acknowledged by the peer) and lost
+       //! (gaps in received sequence numbers, or not acknowledged).
+       void
+       takeLinkOutcomes(unsigned& delivered, unsigned& lost)
+       {
+         delivered = m_delivered;
+         lost = m_lost;
+         m_delivered = 0;
+         m_lost = 0;
+       }
+
        unsigned
        lookupSystemAddress(const std::string& name ,unsigned& adrr)
        {
@@ -744,6 +765,12 @@ namespace Transports
       uint8_t local_tx_sync;
       uint8_t local_rx_sync;
       uint8_t systemID;
+      //! True after the first frame is received.
+      bool m_rx_synced;
+      //! Frames delivered since last query.
+      unsigned m_delivered;
+      //! Frames lost since last query.
+      unsigned m_lost;
       int m_max_packet_size;
       //! Map of radio modems by name.
       MapName m_radio_names;
@@ -0,0 +1,178 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+
+#ifndef TRANSPORTS_REPLAY_READER_HPP_INCLUDED_
+#define TRANSPORTS_REPLAY_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <istream>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Replay
+  {
+    using DUNE_NAMESPACES;
+
+    //! Background reader that decodes messages from a log stream
+    //! into a bounded queue, overlapping decompression and
+    //! deserialization with message dispatching.
+    class Reader: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] is input stream, owned by the reader.
+      //! @param[in] capacity maximum number of decoded messages.
+      Reader(std::istream* is, unsigned capacity):
+        m_is(is),
+        m_capacity(capacity == 0 ? 1 : capacity),
+        m_done(false)
+      { }
+
+      //! Destructor.
+      ~Reader(void)
+      {
+        close();
+
+        while (!m_queue.empty())
+        {
+          delete m_queue.front();
+          m_queue.pop_front();
+        }
+
+        delete m_is;
+      }
+
+      //! Stop the reader thread and wait for it to finish.
+      void
+      close(void)
+      {
+        if (!isCreated())
+          return;
+
+        m_cond.lock();
+        stop();
+        m_cond.broadcast();
+        m_cond.unlock();
+        join();
+      }
+
+      //! Retrieve the next decoded message.
+      //! @param[out] msg next message, or NULL if the end of the log
+      //! was reached. Ownership is transferred to the caller.
+      //! @param[in] timeout maximum amount of time to wait.
+      //! @return true if 'msg' was set, false on timeout.
+      bool
+      pop(IMC::Message*& msg, double timeout)
+      {
+        ScopedCondition sc(m_cond);
+
+        if (m_queue.empty() && !m_done)
+          m_cond.wait(timeout);
+
+        if (!m_queue.empty())
+        {
+          msg = m_queue.front();
+          m_queue.pop_front();
+          m_cond.broadcast();
+          return true;
+        }
+
+        if (m_done)
+        {
+          msg = NULL;
+          return true;
+        }
+
+        return false;
+      }
+
+      //! Retrieve the error that stopped reading, if any.
+      //! @return error description or empty string.
+      std::string
+      getError(void)
+      {
+        ScopedCondition sc(m_cond);
+        return m_error;
+      }
+
+    private:
+      //! Input stream.
+      std::istream* m_is;
+      //! Maximum number of queued messages.
+      unsigned m_capacity;
+      //! Decoded messages.
+      std::deque<IMC::Message*> m_queue;
+      //! True if the end of the log was reached.
+      bool m_done;
+      //! Reading error.
+      std::string m_error;
+      //! Queue condition.
+      Condition m_cond;
+
+      void
+      run(void)
+      {
+        while (!isStopping())
+        {
+          IMC::Message* msg = NULL;
+
+          try
+          {
+            msg = IMC::Packet::deserialize(*m_is);
+          }
+          catch (std::exception& e)
+          {
+            ScopedCondition sc(m_cond);
+            m_error = e.what();
+          }
+
+          ScopedCondition sc(m_cond);
+
+          if (msg == NULL)
+          {
+            m_done = true;
+            m_cond.broadcast();
+            break;
+          }
+
+          while (m_queue.size() >= m_capacity && !isStopping())
+            m_cond.wait();
+
+          m_queue.push_back(msg);
+          m_cond.broadcast();
+        }
+      }
+    };
+  }
+}
+
+#endif
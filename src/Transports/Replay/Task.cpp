@@ -36,6 +36,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Reader.hpp"
+
 namespace Transports
 {
   namespace Replay
@@ -49,9 +52,19 @@ namespace Transports
       std::vector<std::string> ents;
       double time_multiplier;
       double initial_log_skip_seconds;
+      std::string pacing;
+      unsigned max_backlog;
+      unsigned prefetch;
+      bool use_index;
     };
 
     static const int c_stats_period = 10;
+    //! Minimum time between log index entries.
+    static const double c_index_interval = 1.0;
+    //! Amount of log read before seeking, to gather entity information.
+    static const double c_prologue = 5.0;
+    //! Time to wait between checks of consumer backlog.
+    static const double c_backlog_wait = 0.001;
 
     struct Task: public DUNE::Tasks::Task
     {
@@ -74,6 +87,10 @@ namespace Transports
 
       // Replay file handle
       std::istream* m_is;
+      // Background reader.
+      Reader* m_reader;
+      // True to pace replay by consumer backlog instead of wall clock.
+      bool m_backpressure;
       // last state from replay file
       IMC::EstimatedState m_estate;
 
@@ -98,7 +115,9 @@ namespace Transports
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
-        m_is(0)
+        m_is(0),
+        m_reader(0),
+        m_backpressure(false)
       {
         param("Load At Start", m_args.startup_file)
         .defaultValue("")
@@ -121,6 +140,28 @@ namespace Transports
         .defaultValue("0")
         .description("Number of seconds to skip in the beginning of the log");
 
+        param("Pacing", m_args.pacing)
+        .defaultValue("Wall Clock")
+        .values("Wall Clock, Backpressure")
+        .description("Replay messages at their original pace or as fast as"
+                     " consumers can keep up with");
+
+        param("Maximum Backlog", m_args.max_backlog)
+        .defaultValue("10")
+        .minimumValue("1")
+        .description("Maximum number of messages queued by consumers"
+                     " when pacing by backpressure");
+
+        param("Prefetch Size", m_args.prefetch)
+        .defaultValue("1000")
+        .minimumValue("1")
+        .description("Number of messages decoded ahead of dispatching");
+
+        param("Use Index", m_args.use_index)
+        .defaultValue("true")
+        .description("Build and use a time index of the log file to skip"
+                     " to the start time without decoding preceding data");
+
         bind<IMC::ReplayControl>(this);
       }
 
@@ -133,6 +174,8 @@ namespace Transports
         if (m_replay.find("EstimatedState") == m_replay.end())
           bind<IMC::EstimatedState>(this);
 
+        m_backpressure = (m_args.pacing == "Backpressure");
+
         reset();
 
         if (m_args.time_multiplier != 1.0)
@@ -240,11 +283,7 @@ namespace Transports
 
         try
         {
-          Compression::Methods method = Compression::Factory::detect(file.c_str());
-          if (method == Compression::METHOD_UNKNOWN)
-            m_is = new std::ifstream(file.c_str(), std::ios::binary);
-          else
-            m_is = new Compression::FileInput(file.c_str(), method);
+          m_is = openStream(file, 0);
         }
         catch (std::exception& e)
         {
@@ -282,7 +321,8 @@ namespace Transports
 
         IMC::LoggingControl* lc = static_cast<IMC::LoggingControl*>(m);
 
-        m_ts_delta = lc->getTimeStamp();
+        double origin = lc->getTimeStamp();
+        m_ts_delta = origin;
 
         size_t spos = lc->name.find_last_of('/');
         if (spos != std::string::npos)
@@ -291,54 +331,119 @@ namespace Transports
 
         lc->op = IMC::LoggingControl::COP_REQUEST_START;
         dispatch(lc); // change log (if Logging task happens to be active)
+        delete lc;
 
         // skip messages
         if (m_args.initial_log_skip_seconds > 0)
         {
-          m = getFirstMessageAfterSkip(m_args.initial_log_skip_seconds);
+          try
+          {
+            m = getFirstMessageAfterSkip(file, m_args.initial_log_skip_seconds);
+          }
+          catch (std::exception& e)
+          {
+            err("%s: %s", DTR("deserialization error"), e.what());
+            m = NULL;
+          }
+
           if (!m)
           {
             err("No messages for specified time range");
+            reset();
             return;
           }
           else
             inf("Skipped messages up to %s", Time::Format::getTimeDate(m->getTimeStamp()).c_str());
         }
 
-        m_ts_delta = lc->getTimeStamp() - m_ts_delta - m_args.initial_log_skip_seconds;
+        m_ts_delta = Clock::getSinceEpoch() - origin - m_args.initial_log_skip_seconds;
         m_start_time = m->getTimeStamp();
         m_next_stats = m_start_time + c_stats_period;
         delete m;
 
+        // Hand the stream over to the background reader.
+        m_reader = new Reader(m_is, m_args.prefetch);
+        m_is = 0;
+        m_reader->start();
+
         requestActivation();
 
         war("%s '%s'", DTR("started replay of"), file.c_str());
       }
 
+      //! Open a log file for reading.
+      //! @param[in] file log file.
+      //! @param[in] offset offset of the first byte to read.
+      //! @return input stream.
+      std::istream*
+      openStream(const std::string& file, uint64_t offset)
+      {
+        Compression::Methods method = Compression::Factory::detect(file.c_str());
+        if (method != Compression::METHOD_UNKNOWN)
+          return new Compression::FileInput(file.c_str(), method, offset);
+
+        std::ifstream* ifs = new std::ifstream(file.c_str(), std::ios::binary);
+        if (offset > 0)
+          ifs->seekg(offset);
+        return ifs;
+      }
+
+      //! Read messages until one with a timestamp greater or equal
+      //! to a given time is found.
+      //! @param[in] time timestamp.
+      //! @return first message at or after time, or NULL.
       IMC::Message*
-      getFirstMessageAfterSkip(double time_to_skip)
+      readUntil(double time)
       {
         IMC::Message* m = 0;
-        double time_origin = m_ts_delta;
-        m = IMC::Packet::deserialize(*m_is);
-        while (m)
+
+        while ((m = IMC::Packet::deserialize(*m_is)) != 0)
         {
-          if (m->getTimeStamp() - time_origin >= time_to_skip)
+          if (getDebugLevel() >= DEBUG_LEVEL_SPEW)
+            m->toText(std::cout);
+
+          if (m->getTimeStamp() >= time)
             return m;
+
           // Do not miss information from EntityInfo
           if (m->getId() == DUNE_IMC_ENTITYINFO)
-          {
             updateEntityMap(m);
-          }
 
           delete m;
-          m = IMC::Packet::deserialize(*m_is);
-          if(getDebugLevel() >= DEBUG_LEVEL_SPEW)
-            m->toText(std::cout);
         }
+
         return NULL;
       }
 
+      IMC::Message*
+      getFirstMessageAfterSkip(const std::string& file, double time_to_skip)
+      {
+        double target = m_ts_delta + time_to_skip;
+
+        if (!m_args.use_index || time_to_skip <= c_prologue)
+          return readUntil(target);
+
+        // Read the beginning of the log for entity information.
+        IMC::Message* m = readUntil(m_ts_delta + c_prologue);
+        if (m == NULL || m->getTimeStamp() >= target)
+          return m;
+
+        delete m;
+
+        IMC::LogIndex index;
+        index.open(file, c_index_interval);
+
+        uint64_t offset = index.find(target);
+        if (offset > 0)
+        {
+          debug("seeking to offset %llu", (unsigned long long)offset);
+          delete m_is;
+          m_is = openStream(file, offset);
+        }
+
+        return readUntil(target);
+      }
+
       void
       stopReplay(void)
       {
@@ -384,6 +489,12 @@ namespace Transports
       {
         requestDeactivation();
 
+        if (m_reader)
+        {
+          delete m_reader;
+          m_reader = 0;
+        }
+
         if (m_is)
         {
           delete m_is;
@@ -413,7 +524,15 @@ namespace Transports
 
         double delay;
 
-        if (delta >= 1e-03)
+        if (m_backpressure)
+        {
+          // Wait till consumers catch up.
+          while (!stopping() && m_ctx.mbus.getBacklog(m->getId(), this) > m_args.max_backlog)
+            Delay::wait(c_backlog_wait);
+
+          delay = 0;
+        }
+        else if (delta >= 1e-03)
         {
           // Delay::wait does not behave satisfactorily otherwise
           // in some systems
@@ -465,9 +584,16 @@ namespace Transports
 
           IMC::Message* m = 0;
 
-          while (!stopping() && (m = DUNE::IMC::Packet::deserialize(*m_is)) != 0 && !m_is->eof())
+          while (!stopping() && m_reader != 0)
           {
-            consumeMessages();
+            if (!m_reader->pop(m, 1.0))
+            {
+              consumeMessages();
+              continue;
+            }
+
+            if (m == 0)
+              break;
 
             if (m->getId() == DUNE_IMC_ESTIMATEDSTATE)
             {
@@ -486,12 +612,21 @@ namespace Transports
             {
               dispatchWithNewTime(m);
             }
+
+            delete m;
+            m = 0;
+
+            consumeMessages();
           }
 
-          stopReplay();
+          if (m_reader != 0)
+          {
+            std::string error = m_reader->getError();
+            if (!error.empty())
+              err("%s: %s", DTR("deserialization error"), error.c_str());
 
-          // Clean up
-          delete m;
+            stopReplay();
+          }
         }
       }
 
@@ -108,6 +108,7 @@ namespace Transports
       {
         if (m_sock != NULL)
         {
+          m_poll.remove(getMessageHandle());
           m_poll.remove(*m_sock);
           delete m_sock;
           m_sock = NULL;
@@ -138,6 +139,7 @@ namespace Transports
         m_sock->setNoDelay(true);
         m_poll.add(*m_sock);
         m_poll.add(*m_uart);
+        m_poll.add(getMessageHandle());
       }
 
       void
@@ -237,6 +239,9 @@ namespace Transports
         {
           if (m_poll.poll(1.0))
           {
+            if (m_poll.wasTriggered(getMessageHandle()))
+              consumeMessages();
+
             checkSerialPort();
             checkMainSocket();
             checkClientSockets();
@@ -82,6 +82,7 @@ namespace Transports
             m_sock = new TCPSocket;
             m_sock->connect(m_args.address, m_args.port);
             m_sock->setKeepAlive(true);
+            addDataHandle(*m_sock);
 
             inf(DTR("connected to %s:%u"), m_args.address.c_str(), m_args.port);
             setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
@@ -97,6 +98,7 @@ namespace Transports
         {
           if (m_sock)
           {
+            removeDataHandle(*m_sock);
             delete m_sock;
             m_sock = NULL;
           }
@@ -120,7 +122,7 @@ namespace Transports
         void
         onDataReception(uint8_t* p, unsigned int n, double timeout)
         {
-          if (!Poll::poll(*m_sock, timeout))
+          if (!waitForData(*m_sock, timeout))
             return;
 
           int n_r;
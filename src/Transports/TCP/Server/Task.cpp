@@ -119,6 +119,7 @@ namespace Transports
 
           m_sock->listen(5);
           m_poll.add(*m_sock);
+          m_poll.add(getMessageHandle());
           inf(DTR("listening on %s:%u"), Address(Address::Any).c_str(), m_args.port);
 
           if (m_args.announce)
@@ -188,6 +189,7 @@ namespace Transports
 
           if (m_sock)
           {
+            m_poll.remove(getMessageHandle());
             m_poll.remove(*m_sock);
             delete m_sock;
             m_sock = 0;
@@ -218,7 +220,7 @@ namespace Transports
         void
         onDataReception(uint8_t* buf, unsigned int cap, double timeout)
         {
-          // Poll for connections and client data
+          // Poll for connections, client data and queued messages.
           if (!m_poll.poll(timeout))
             return;
 
@@ -49,9 +49,17 @@ namespace Transports
       CODE_REPORT  = 0x03,
       CODE_RESTART = 0x04,
       CODE_RAW     = 0x05,
-      CODE_USBL    = 0x06
+      CODE_USBL    = 0x06,
+      CODE_MULTI   = 0x07
     };
 
+    //! Size of the aggregated frame header (code and count).
+    static const size_t c_multi_header_size = 2;
+    //! Maximum number of frames in an aggregated frame.
+    static const size_t c_multi_max_count = 255;
+    //! Maximum size of a frame inside an aggregated frame.
+    static const size_t c_multi_max_item = 255;
+
     struct Report
     {
       float lat;
@@ -74,6 +82,18 @@ namespace Transports
       bool usbl_announce;
       //! Section where to read modem addresses
       std::string addr_section;
+      //! Aggregate messages to the same destination.
+      bool aggr_enabled;
+      //! Maximum time a message may wait for companions.
+      double aggr_window;
+      //! Maximum size of an aggregated frame.
+      unsigned aggr_max_size;
+      //! Total number of TDMA slots.
+      unsigned tdma_slot_count;
+      //! TDMA slots owned by this system.
+      std::vector<unsigned> tdma_slots;
+      //! TDMA slot duration.
+      unsigned tdma_duration;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -90,6 +110,12 @@ namespace Transports
       uint16_t m_reqid;
       //! Map of messages to send
       std::map<uint16_t, IMC::AcousticRequest*> m_transmission_requests;
+      //! Time at which each queued message was added.
+      std::map<uint16_t, double> m_queued_at;
+      //! Messages carried by each aggregated frame in flight.
+      std::map<uint16_t, std::vector<uint16_t> > m_batches;
+      //! TDMA scheme.
+      Network::TDMA m_tdma;
       //! Timer for sending preceding message
       Counter<double> m_msg_send_timer;
       //! When "false" processQueue must wait
@@ -187,6 +213,41 @@ namespace Transports
         .defaultValue("")
         .description("Name of the configuration section with modem addresses");
 
+        param("Aggregation -- Enabled", m_args.aggr_enabled)
+        .defaultValue("false")
+        .description("Pack pending messages to the same destination into a"
+            " single acoustic frame. Receivers must understand aggregated"
+            " frames");
+
+        param("Aggregation -- Window", m_args.aggr_window)
+        .defaultValue("5.0")
+        .minimumValue("0.0")
+        .units(Units::Second)
+        .description("Maximum amount of time a message waits for other"
+            " messages to the same destination before being sent");
+
+        param("Aggregation -- Maximum Frame Size", m_args.aggr_max_size)
+        .defaultValue("64")
+        .minimumValue("8")
+        .maximumValue("1024")
+        .units(Units::Byte)
+        .description("Maximum size of an aggregated frame. The default fits"
+            " a single instant message of most modems");
+
+        param("TDMA -- Slot Count", m_args.tdma_slot_count)
+        .defaultValue("0")
+        .description("Total number of TDMA slots per minute cycle. When zero"
+            " transmissions are not restricted to slots");
+
+        param("TDMA -- Slots", m_args.tdma_slots)
+        .defaultValue("")
+        .description("TDMA slots assigned to this system");
+
+        param("TDMA -- Slot Duration", m_args.tdma_duration)
+        .defaultValue("10")
+        .units(Units::Second)
+        .description("Duration of each TDMA slot");
+
         bind<IMC::AcousticRequest>(this);
         bind<IMC::EstimatedState>(this);
         bind<IMC::FuelLevel>(this);
@@ -208,6 +269,12 @@ namespace Transports
         onResourceRelease();
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_tdma.reset(m_args.tdma_slot_count, m_args.tdma_slots, m_args.tdma_duration);
+      }
+
       void
       onResourceAcquisition(void)
       {
@@ -345,6 +412,16 @@ namespace Transports
           return;
         }
 
+        handleFrame(imc_addr_src, imc_addr_dst, msg);
+      }
+
+      //! Handle a validated frame.
+      //! @param[in] imc_addr_src source address.
+      //! @param[in] imc_addr_dst destination address.
+      //! @param[in] msg frame, including synchronization and CRC bytes.
+      void
+      handleFrame(uint16_t imc_addr_src, uint16_t imc_addr_dst, const IMC::UamRxFrame* msg)
+      {
         switch (msg->data[1])
         {
           case CODE_REPORT:
@@ -367,6 +444,10 @@ namespace Transports
             recvMessage(imc_addr_src, imc_addr_dst, msg);
             break;
 
+          case CODE_MULTI:
+            recvMulti(imc_addr_src, imc_addr_dst, msg);
+            break;
+
           case CODE_USBL:
             if (UsblTools::toNode(msg->data[2]))
             {
@@ -397,14 +478,32 @@ namespace Transports
         if (msg->getDestinationEntity() != getEntityId())
           return;
 
-        if (m_transmission_requests.find(msg->seq)
-            == m_transmission_requests.end()) {
-          return;
+        std::vector<uint16_t> ids;
+        std::map<uint16_t, std::vector<uint16_t> >::iterator bitr = m_batches.find(msg->seq);
+        if (bitr != m_batches.end())
+        {
+          ids = bitr->second;
+          if (msg->value != IMC::UamTxStatus::UTS_IP)
+            m_batches.erase(bitr);
+        }
+        else
+        {
+          ids.push_back(msg->seq);
         }
-        uint16_t idOfMsg = msg->seq;
 
-        if (m_transmission_requests.find(idOfMsg) == m_transmission_requests.end()) return;
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+          if (m_transmission_requests.find(ids[i]) != m_transmission_requests.end())
+            handleTxStatus(ids[i], msg);
+        }
+      }
 
+      //! Update a queued request with the status of its transmission.
+      //! @param[in] idOfMsg internal identifier of the request.
+      //! @param[in] msg transmission status.
+      void
+      handleTxStatus(uint16_t idOfMsg, const IMC::UamTxStatus* msg)
+      {
         const IMC::AcousticRequest* request = m_transmission_requests[idOfMsg];
 
         switch (msg->value) {
@@ -570,7 +669,9 @@ namespace Transports
       void
       addToQueue(const IMC::AcousticRequest* msg)
       {
-        m_transmission_requests[createInternalId()] = msg->clone();
+        uint16_t id = createInternalId();
+        m_transmission_requests[id] = msg->clone();
+        m_queued_at[id] = Clock::get();
       }
 
       //! Remove message from the queue. Resets timer. And unlocks the queue
@@ -579,6 +680,7 @@ namespace Transports
       {
         delete m_transmission_requests.find(index)->second;
         m_transmission_requests.erase(index);
+        m_queued_at.erase(index);
         m_msg_send_timer.setTop(2);
         m_can_send = true;
       }
@@ -680,6 +782,19 @@ namespace Transports
 
       void
       sendMessage(const std::string& sys, const uint16_t id, const InlineMessage<IMC::Message>& imsg)
+      {
+        std::vector<uint8_t> data;
+        if (encodeMessage(imsg, data))
+          sendFrame(sys, id, data, true);
+      }
+
+      //! Encode an inline message as frame contents (without
+      //! synchronization and CRC bytes).
+      //! @param[in] imsg message.
+      //! @param[out] data frame contents.
+      //! @return true if the message can be sent, false otherwise.
+      bool
+      encodeMessage(const InlineMessage<IMC::Message>& imsg, std::vector<uint8_t>& data)
       {
         const IMC::Message* msg = NULL;
 
@@ -689,7 +804,7 @@ namespace Transports
         }
         catch (...)
         {
-          return;
+          return false;
         }
 
         // Check if special command can be used...
@@ -697,37 +812,26 @@ namespace Transports
         {
           const IMC::PlanControl * pc = static_cast<const IMC::PlanControl*>(msg);
           if (pc->arg.isNull())
-          {
-            sendPlanControl(sys, id, static_cast<const IMC::PlanControl*>(msg));
-            return;
-          }
+            return encodePlanControl(pc, data);
         }
 
         // For all other cases, send the raw message across
-        sendRawMessage(sys, id, msg);
+        encodeRawMessage(msg, data);
+        return true;
       }
 
       void
-      sendRawMessage(const std::string& sys, const uint16_t id, const IMC::Message * msg)
+      encodeRawMessage(const IMC::Message * msg, std::vector<uint8_t>& data)
       {
-        std::vector<uint8_t> data;
-        data.push_back(CODE_RAW);
-
         inf("Send message of type %s, with serialization size %d.", msg->getName(), msg->getSerializationSize());
 
-        // leave 1 byte for CODE_RAW and another for CRC8
-        uint8_t buf[2500];
+        // code, followed by message id and all message fields
+        data.resize(1 + sizeof(uint16_t) + msg->getSerializationSize());
+        data[0] = CODE_RAW;
 
-        // start with message id
         uint16_t id2 = msg->getId();
-        std::memcpy(&buf[0], &id2, sizeof(uint16_t));
-
-        // followed by all message fields
-        msg->serializeFields(&buf[2]);
-
-        int length = msg->getSerializationSize() + 2;
-        data.insert(data.end(), buf, buf + length);
-        sendFrame(sys, id, data, true);
+        std::memcpy(&data[1], &id2, sizeof(uint16_t));
+        msg->serializeFields(&data[1 + sizeof(uint16_t)]);
       }
 
       void
@@ -768,20 +872,58 @@ namespace Transports
         removeFromQueue(req.req_id);
       }
 
-      void
-      sendPlanControl(const std::string& sys, const uint16_t id, const IMC::PlanControl* msg)
+      bool
+      encodePlanControl(const IMC::PlanControl* msg, std::vector<uint8_t>& data)
       {
         if (msg->type != IMC::PlanControl::PC_REQUEST)
-          return;
+          return false;
 
         if (msg->op != IMC::PlanControl::PC_START)
-          return;
+          return false;
 
-        std::vector<uint8_t> data;
+        data.clear();
         data.push_back(CODE_PLAN);
         for (size_t i = 0; i < msg->plan_id.size(); ++i)
           data.push_back((uint8_t)msg->plan_id[i]);
-        sendFrame(sys, id, data, true);
+        return true;
+      }
+
+      //! Split an aggregated frame and handle each of the carried frames.
+      //! Layout: CODE_MULTI, count, and count times (length, frame).
+      void
+      recvMulti(uint16_t imc_src, uint16_t imc_dst, const IMC::UamRxFrame* msg)
+      {
+        // Skip synchronization, code and count; stop before CRC.
+        size_t end = msg->data.size() - 1;
+        size_t count = (msg->data.size() > 3) ? (uint8_t)msg->data[2] : 0;
+        size_t pos = 3;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (pos >= end)
+            break;
+
+          size_t length = (uint8_t)msg->data[pos++];
+          if (length == 0 || pos + length > end)
+          {
+            debug("invalid aggregated frame");
+            return;
+          }
+
+          // Nested aggregates are not allowed.
+          if ((uint8_t)msg->data[pos] != CODE_MULTI)
+          {
+            IMC::UamRxFrame sub(*msg);
+            sub.data.clear();
+            sub.data.push_back(c_sync);
+            sub.data.insert(sub.data.end(), msg->data.begin() + pos, msg->data.begin() + pos + length);
+            // CRC was already validated for the whole frame.
+            sub.data.push_back(0);
+            handleFrame(imc_src, imc_dst, &sub);
+          }
+
+          pos += length;
+        }
       }
 
       void
@@ -936,6 +1078,7 @@ namespace Transports
           {
             sendAcousticStatus(it->second,IMC::AcousticStatus::STATUS_INPUT_FAILURE,"Transmission timed out.");
             Memory::clear(it->second);
+            m_queued_at.erase(it->first);
             m_transmission_requests.erase(it++);
             m_can_send = true;
           }
@@ -944,36 +1087,168 @@ namespace Transports
         }
       }
 
+      //! Check if the medium is ours according to the TDMA scheme.
+      //! @return true if we can transmit, false otherwise.
+      bool
+      canTransmit(void) const
+      {
+        if (m_args.tdma_slot_count == 0)
+          return true;
+
+        return m_tdma.inSlot(Clock::getSinceEpoch());
+      }
+
+      //! Try to send a queued message together with other messages to
+      //! the same destination.
+      //! @param[in] head first queued request for the destination.
+      //! @param[out] held true if the request was held back waiting for
+      //! companions.
+      //! @return true if the request was handled (sent or held back),
+      //! false if it must be sent on its own.
+      bool
+      sendAggregated(std::map<uint16_t, IMC::AcousticRequest*>::iterator head, bool& held)
+      {
+        const IMC::AcousticRequest* req = head->second;
+        held = false;
+
+        std::vector<uint8_t> item;
+        if (!encodeMessage(req->msg, item))
+          return false;
+
+        if (item.size() > c_multi_max_item
+            || c_multi_header_size + 1 + item.size() > m_args.aggr_max_size)
+          return false;
+
+        std::vector<uint8_t> frame;
+        frame.push_back(CODE_MULTI);
+        frame.push_back(0);
+        frame.push_back((uint8_t)item.size());
+        frame.insert(frame.end(), item.begin(), item.end());
+
+        std::vector<uint16_t> ids;
+        ids.push_back(head->first);
+        std::vector<uint8_t> first(item);
+
+        bool full = false;
+        std::map<uint16_t, IMC::AcousticRequest*>::iterator itr = head;
+        for (++itr; itr != m_transmission_requests.end(); ++itr)
+        {
+          if (itr->second->type != IMC::AcousticRequest::TYPE_MSG
+              || itr->second->destination != req->destination)
+            continue;
+
+          if (!encodeMessage(itr->second->msg, item))
+            continue;
+
+          if (item.size() > c_multi_max_item
+              || frame.size() + 1 + item.size() > m_args.aggr_max_size)
+          {
+            full = true;
+            continue;
+          }
+
+          frame.push_back((uint8_t)item.size());
+          frame.insert(frame.end(), item.begin(), item.end());
+          ids.push_back(itr->first);
+
+          if (ids.size() == c_multi_max_count)
+          {
+            full = true;
+            break;
+          }
+        }
+
+        // Hold back while there is room and the latency budget allows.
+        double age = Clock::get() - m_queued_at[head->first];
+        if (!full && age < m_args.aggr_window)
+        {
+          held = true;
+          return true;
+        }
+
+        m_can_send = false;
+
+        if (ids.size() == 1)
+        {
+          sendFrame(req->destination, head->first, first, true);
+          return true;
+        }
+
+        frame[1] = (uint8_t)ids.size();
+        m_batches[head->first] = ids;
+        debug("sending %u messages to %s in %u bytes", (unsigned)ids.size(),
+              req->destination.c_str(), (unsigned)frame.size());
+        sendFrame(req->destination, head->first, frame, true);
+        return true;
+      }
+
       void
       processQueue(void)
       {
-        if (m_can_send && !m_transmission_requests.empty())
+        if (!m_can_send || m_transmission_requests.empty())
+          return;
+
+        bool can_transmit = canTransmit();
+
+        // Destinations whose messages are held back for aggregation do
+        // not block requests queued behind them.
+        std::set<std::string> held;
+        std::map<uint16_t, IMC::AcousticRequest*>::iterator itr = m_transmission_requests.begin();
+        for (; itr != m_transmission_requests.end(); ++itr)
         {
-          m_can_send = false;
-          const IMC::AcousticRequest* req = m_transmission_requests.begin()->second;
-          uint16_t id = m_transmission_requests.begin()->first;
+          const IMC::AcousticRequest* req = itr->second;
 
-          switch (req->type)
-          {
-            case (IMC::AcousticRequest::TYPE_ABORT):
-              sendAbort(req->destination,id);
-              break;
+          // Aborts are never delayed.
+          if (req->type == IMC::AcousticRequest::TYPE_ABORT)
+            break;
+
+          if (!can_transmit)
+            return;
 
-            case (IMC::AcousticRequest::TYPE_RANGE):
-              sendRange(req->destination,id);
-              break;
+          if (req->type != IMC::AcousticRequest::TYPE_MSG || !m_args.aggr_enabled)
+            break;
 
-            case (IMC::AcousticRequest::TYPE_MSG):
-              sendMessage(req->destination, id, req->msg);
-              break;
+          if (held.count(req->destination))
+            continue;
 
-            case (IMC::AcousticRequest::TYPE_RAW):
-              sendRaw(*req, req->destination, id, req->msg);
-              break;
+          bool hold = false;
+          if (!sendAggregated(itr, hold))
+            break;
 
-            default:
-              break;
-          }
+          if (!hold)
+            return;
+
+          held.insert(req->destination);
+        }
+
+        if (itr == m_transmission_requests.end())
+          return;
+
+        const IMC::AcousticRequest* req = itr->second;
+        uint16_t id = itr->first;
+
+        m_can_send = false;
+
+        switch (req->type)
+        {
+          case (IMC::AcousticRequest::TYPE_ABORT):
+            sendAbort(req->destination,id);
+            break;
+
+          case (IMC::AcousticRequest::TYPE_RANGE):
+            sendRange(req->destination,id);
+            break;
+
+          case (IMC::AcousticRequest::TYPE_MSG):
+            sendMessage(req->destination, id, req->msg);
+            break;
+
+          case (IMC::AcousticRequest::TYPE_RAW):
+            sendRaw(*req, req->destination, id, req->msg);
+            break;
+
+          default:
+            break;
         }
       }
 
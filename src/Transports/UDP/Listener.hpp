@@ -65,6 +65,18 @@ namespace Transports
         m_contacts.getContacts(list);
       }
 
+      //! Retrieve and reset the number of heartbeats received from
+      //! each system.
+      //! @param[out] counts map of system id to number of heartbeats.
+      void
+      takeHeartbeats(std::map<unsigned, unsigned>& counts)
+      {
+        counts.clear();
+        m_contacts_lock.lockWrite();
+        m_heartbeats.swap(counts);
+        m_contacts_lock.unlock();
+      }
+
       void
       lockContacts(void)
       {
@@ -94,6 +106,8 @@ namespace Transports
       RWLock m_contacts_lock;
       // LimitedComms object
       LimitedComms* m_lcomms;
+      // Heartbeats received per system.
+      std::map<unsigned, unsigned> m_heartbeats;
 
       void
       run(void)
@@ -128,6 +142,8 @@ namespace Transports
 
             m_contacts_lock.lockWrite();
             m_contacts.update(msg->getSource(), addr);
+            if (msg->getId() == DUNE_IMC_HEARTBEAT)
+              ++m_heartbeats[msg->getSource()];
             m_contacts_lock.unlock();
 
             m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
@@ -68,6 +68,8 @@ namespace Transports
       std::vector<std::string> rate_lims;
       // Filtered entities.
       std::vector<std::string> entities_flt;
+      // Decimation rules.
+      std::vector<std::string> decimation;
       // List of messages to publish.
       std::vector<std::string> messages;
       // Announce this transport to services or not
@@ -84,6 +86,20 @@ namespace Transports
       bool only_local;
       // Optional custom service type
       std::string custom_service;
+      // Adapt rate limiters to link quality.
+      bool adaptive;
+      // Rate adaptation period.
+      double adaptive_period;
+      // Minimum rate scale.
+      double adaptive_min_scale;
+      // Messages whose rates are never reduced.
+      std::vector<std::string> adaptive_critical;
+      // Expected frequency of heartbeats from peers.
+      double adaptive_hb_freq;
+      // Entity label of RSSI measurements.
+      std::string adaptive_rssi_elabel;
+      // RSSI range mapped to link quality.
+      std::vector<double> adaptive_rssi_range;
     };
 
     // Internal buffer size.
@@ -115,12 +131,23 @@ namespace Transports
       LimitedComms* m_lcomms;
       //! Message Filter
       MessageFilter m_filter;
+      //! Message decimator.
+      MessageDecimator m_decimator;
+      //! Rate controller.
+      Network::RateController m_rate;
+      //! Rate adaptation timer.
+      Time::Counter<double> m_rate_timer;
+      //! Systems known to send heartbeats.
+      std::set<unsigned> m_hb_sources;
+      //! Entity of RSSI measurements.
+      unsigned m_rssi_eid;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
         m_bfr(NULL),
         m_listener(NULL),
-        m_lcomms(NULL)
+        m_lcomms(NULL),
+        m_rssi_eid(UINT_MAX)
       {
         param("Local Port", m_args.port)
         .defaultValue("6002")
@@ -151,6 +178,11 @@ namespace Transports
         param("Filtered Entities", m_args.entities_flt)
         .description("List of <Message>:<Entity>+<Entity> that define the source entities allowed to pass message of a specific message type.");
 
+        param("Decimation Rules", m_args.decimation)
+        .defaultValue("")
+        .description("List of <Message>[@<Entity>]:<Mode>:<Period>[:<Threshold>]"
+                     " rules, where <Mode> is Rate, Mean, Minimum, Maximum or Deadband");
+
         param("Announce Service", m_args.announce_service)
         .defaultValue("true")
         .description("Announce this transport to services or not");
@@ -184,11 +216,48 @@ namespace Transports
         .defaultValue("")
         .description("Optional custom service type (imc+udp+<Custom Service Type>), empty entry gives default service (imc+udp)");
 
+        param("Adaptive Rate", m_args.adaptive)
+        .defaultValue("false")
+        .description("Scale rate limiters to the measured link quality");
+
+        param("Adaptive Rate - Period", m_args.adaptive_period)
+        .defaultValue("5.0")
+        .minimumValue("1.0")
+        .units(Units::Second)
+        .description("Period between rate adaptations");
+
+        param("Adaptive Rate - Minimum Scale", m_args.adaptive_min_scale)
+        .defaultValue("0.1")
+        .minimumValue("0.01")
+        .maximumValue("1.0")
+        .description("Lowest fraction of the configured rates used on a poor link");
+
+        param("Adaptive Rate - Critical Messages", m_args.adaptive_critical)
+        .defaultValue("EstimatedState, VehicleState, PlanControlState")
+        .description("Messages whose rate limiters are never scaled down");
+
+        param("Adaptive Rate - Heartbeat Frequency", m_args.adaptive_hb_freq)
+        .defaultValue("1.0")
+        .units(Units::Hertz)
+        .description("Expected frequency of heartbeats from peers, used"
+                     " to estimate packet loss");
+
+        param("Adaptive Rate - RSSI Entity Label", m_args.adaptive_rssi_elabel)
+        .defaultValue("")
+        .description("Entity label of RSSI measurements of the link, if any");
+
+        param("Adaptive Rate - RSSI Range", m_args.adaptive_rssi_range)
+        .defaultValue("10, 40")
+        .size(2)
+        .units(Units::Percentage)
+        .description("RSSI at which the link is considered lost and good");
+
         // Allocate space for internal buffer.
         m_bfr = new uint8_t[c_bfr_size];
 
         // Register listeners.
         bind<IMC::Announce>(this);
+        bind<IMC::RSSI>(this);
       }
 
       ~Task(void)
@@ -212,6 +281,18 @@ namespace Transports
         m_filter.setupRates(m_args.rate_lims);
         // Process filtered entities.
         m_filter.setupEntities(m_args.entities_flt, this);
+        // Process critical messages.
+        m_filter.setupCritical(m_args.adaptive_critical);
+
+        // Updates are paced by m_rate_timer.
+        m_rate.setPeriod(0);
+        m_rate.setMinimumScale(m_args.adaptive_min_scale);
+        m_rate_timer.setTop(m_args.adaptive_period);
+        if (!m_args.adaptive)
+        {
+          m_rate.reset();
+          m_filter.setRateScale(1.0);
+        }
 
         m_underwater_comms = m_args.underwater_comms;
 
@@ -231,6 +312,25 @@ namespace Transports
         }
       }
 
+      void
+      onEntityResolution(void)
+      {
+        m_decimator.setup(m_args.decimation, this);
+
+        m_rssi_eid = UINT_MAX;
+        if (!m_args.adaptive_rssi_elabel.empty())
+        {
+          try
+          {
+            m_rssi_eid = resolveEntity(m_args.adaptive_rssi_elabel);
+          }
+          catch (...)
+          {
+            war(DTR("unknown RSSI entity: %s"), m_args.adaptive_rssi_elabel.c_str());
+          }
+        }
+      }
+
       void
       onResourceAcquisition(void)
       {
@@ -336,6 +436,17 @@ namespace Transports
         if (m_filter.filter(msg))
           return;
 
+        if (m_decimator.filter(msg, Clock::getSinceEpoch()))
+          return;
+
+        sendMessage(msg);
+      }
+
+      //! Send a message to static and dynamic destinations.
+      //! @param[in] msg message.
+      void
+      sendMessage(const IMC::Message* msg)
+      {
         if (m_args.trace_out)
           msg->toText(std::cerr);
 
@@ -348,9 +459,12 @@ namespace Transports
           try
           {
             m_sock.write(m_bfr, rv, itr->getAddress(), itr->getPort());
+            m_rate.sent(rv);
           }
           catch (...)
-          { }
+          {
+            m_rate.outcome(0, 1);
+          }
         }
 
         if (m_args.dynamic_nodes)
@@ -360,6 +474,66 @@ namespace Transports
         }
       }
 
+      //! Send aggregated messages of completed decimation windows.
+      void
+      sendAggregates(void)
+      {
+        IMC::Message* msg = NULL;
+        while ((msg = m_decimator.pop(Clock::getSinceEpoch())) != NULL)
+        {
+          sendMessage(msg);
+          delete msg;
+        }
+      }
+
+      void
+      consume(const IMC::RSSI* msg)
+      {
+        if (msg->getSource() != getSystemId() || msg->getSourceEntity() != m_rssi_eid)
+          return;
+
+        m_rate.setQuality(msg->value, m_args.adaptive_rssi_range[0],
+                          m_args.adaptive_rssi_range[1]);
+      }
+
+      //! Estimate packet loss from the heartbeats received from peers
+      //! and adapt the rate limiters.
+      void
+      adaptRates(void)
+      {
+        std::map<unsigned, unsigned> counts;
+        m_listener->takeHeartbeats(counts);
+
+        std::map<unsigned, unsigned>::const_iterator itr = counts.begin();
+        for (; itr != counts.end(); ++itr)
+          m_hb_sources.insert(itr->first);
+
+        unsigned expected = (unsigned)(m_args.adaptive_period * m_args.adaptive_hb_freq + 0.5);
+
+        m_listener->lockContacts();
+        std::vector<Contact> contacts;
+        m_listener->getContacts(contacts);
+        m_listener->unlockContacts();
+
+        for (unsigned i = 0; i < contacts.size(); ++i)
+        {
+          unsigned id = contacts[i].getId();
+          if (!contacts[i].isActive() || m_hb_sources.find(id) == m_hb_sources.end())
+            continue;
+
+          unsigned received = std::min(counts[id], expected);
+          m_rate.outcome(received, expected - received);
+        }
+
+        if (!m_rate.update(Clock::get()))
+          return;
+
+        m_filter.setRateScale(m_rate.getScale());
+        debug("rate scale %.2f (loss %.2f, quality %.2f, goodput %.0f B/s)",
+              m_rate.getScale(), m_rate.getLoss(), m_rate.getQuality(),
+              m_rate.getGoodput());
+      }
+
       void
       consume(const IMC::Announce* msg)
       {
@@ -411,12 +585,20 @@ namespace Transports
         {
           waitForMessages(1.0);
 
+          sendAggregates();
+
           // Check if it's time to update the contact list.
           if (m_contacts_refresh_counter.overflow())
           {
             refreshContacts();
             m_contacts_refresh_counter.reset();
           }
+
+          if (m_args.adaptive && m_rate_timer.overflow())
+          {
+            adaptRates();
+            m_rate_timer.reset();
+          }
         }
       }
     };